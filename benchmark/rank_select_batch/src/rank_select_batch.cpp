@@ -0,0 +1,106 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <sdsl/bit_vectors.hpp>
+
+using namespace std;
+using namespace sdsl;
+
+using namespace std::chrono;
+using timer = std::chrono::high_resolution_clock;
+
+//! Answers the queries in `args` one by one and returns the sum of the answers
+template<class t_support>
+uint64_t test_scalar(const t_support& s, const vector<uint64_t>& args)
+{
+    uint64_t cnt=0;
+    for (uint64_t i=0; i<args.size(); ++i) {
+        cnt += s(args[i]);
+    }
+    return cnt;
+}
+
+template<class t_support>
+void batch(const t_support& s, const uint64_t* args, uint64_t n, uint64_t* out)
+{
+    s.rank_batch(args, n, out);
+}
+
+template<uint8_t t_b, uint8_t t_pat_len>
+void batch(const select_support_mcl<t_b,t_pat_len>& s, const uint64_t* args, uint64_t n, uint64_t* out)
+{
+    s.select_batch(args, n, out);
+}
+
+//! Answers the queries in `args` in batches of size `batch_size` and returns the sum of the answers
+template<class t_support>
+uint64_t test_batch(const t_support& s, const vector<uint64_t>& args, uint64_t batch_size)
+{
+    uint64_t cnt=0;
+    vector<uint64_t> out(batch_size);
+    for (uint64_t i=0; i<args.size(); i+=batch_size) {
+        uint64_t n = min(batch_size, args.size()-i);
+        batch(s, args.data()+i, n, out.data());
+        for (uint64_t j=0; j<n; ++j) {
+            cnt += out[j];
+        }
+    }
+    return cnt;
+}
+
+template<class t_support>
+void run(const string& name, const t_support& s, const vector<uint64_t>& args, uint64_t batch_size)
+{
+    auto start = timer::now();
+    uint64_t check = test_scalar(s, args);
+    auto stop = timer::now();
+    cout << "# " << name << "_scalar_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)args.size() << endl;
+    cout << "# " << name << "_scalar_check = " << check << endl;
+    start = timer::now();
+    check = test_batch(s, args, batch_size);
+    stop = timer::now();
+    cout << "# " << name << "_batch_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)args.size() << endl;
+    cout << "# " << name << "_batch_check = " << check << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " bit_vector_file batch_size" << endl;
+        cout << " builds rank_support_v, rank_support_v5, and select_support_mcl" << endl;
+        cout << " for the bitvector stored in bit_vector_file and compares the" << endl;
+        cout << " time of single queries with rank_batch/select_batch calls." << endl;
+        return 1;
+    }
+    bit_vector bv;
+    if (!load_from_file(bv, argv[1])) {
+        return 1;
+    }
+    uint64_t batch_size = max(1ULL, stoull(argv[2]));
+    const uint64_t reps = 10000000;
+
+    rank_support_v<>     rank_v(&bv);
+    rank_support_v5<>    rank_v5(&bv);
+    select_support_mcl<> sel(&bv);
+    uint64_t ones = rank_v(bv.size());
+    cout << "# file_name = " << argv[1] << endl;
+    cout << "# bv_size = " << bv.size() << endl;
+    cout << "# ones = " << ones << endl;
+    cout << "# batch_size = " << batch_size << endl;
+
+    vector<uint64_t> args(reps);
+    std::mt19937_64 rng(17);
+    for (uint64_t i=0; i<reps; ++i) {
+        args[i] = rng() % (bv.size()+1);
+    }
+    run("rank_v", rank_v, args, batch_size);
+    run("rank_v5", rank_v5, args, batch_size);
+    if (ones > 0) {
+        for (uint64_t i=0; i<reps; ++i) {
+            args[i] = 1 + rng() % ones;
+        }
+        run("select_mcl", sel, args, batch_size);
+    }
+}
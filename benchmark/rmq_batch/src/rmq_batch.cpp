@@ -0,0 +1,108 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <sdsl/rmq_support.hpp>
+
+using namespace std;
+using namespace sdsl;
+
+using namespace std::chrono;
+using timer = std::chrono::high_resolution_clock;
+
+typedef vector<pair<uint64_t, uint64_t>> query_vec;
+
+const uint64_t batch_size = 4096;
+
+//! Answers the queries in `q` one by one and returns the sum of the answers
+template<class t_rmq>
+uint64_t test_scalar(const t_rmq& rmq, const query_vec& q)
+{
+    uint64_t cnt=0;
+    for (uint64_t i=0; i<q.size(); ++i) {
+        cnt += rmq(q[i].first, q[i].second);
+    }
+    return cnt;
+}
+
+//! Answers the queries in `q` in batches of size `batch_size` and returns the sum of the answers
+template<class t_rmq>
+uint64_t test_batch(const t_rmq& rmq, const query_vec& q)
+{
+    uint64_t cnt=0;
+    for (uint64_t i=0; i<q.size(); i+=batch_size) {
+        query_vec batch(q.begin()+i, q.begin()+min(q.size(), i+batch_size));
+        for (auto x : rmq.rmq_batch(batch)) {
+            cnt += x;
+        }
+    }
+    return cnt;
+}
+
+template<class t_rmq>
+void run_scalar(const string& name, const t_rmq& rmq, const query_vec& q)
+{
+    cout << "# " << name << "_size_in_MB = " << size_in_mega_bytes(rmq) << endl;
+    auto start = timer::now();
+    uint64_t check = test_scalar(rmq, q);
+    auto stop = timer::now();
+    cout << "# " << name << "_scalar_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)q.size() << endl;
+    cout << "# " << name << "_scalar_check = " << check << endl;
+}
+
+template<class t_rmq>
+void run(const string& name, const t_rmq& rmq, const query_vec& q)
+{
+    run_scalar(name, rmq, q);
+    auto start = timer::now();
+    uint64_t check = test_batch(rmq, q);
+    auto stop = timer::now();
+    cout << "# " << name << "_batch_time = " << duration_cast<nanoseconds>(stop-start).count()/(double)q.size() << endl;
+    cout << "# " << name << "_batch_check = " << check << endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        cout << "Usage: " << argv[0] << " n range_length" << endl;
+        cout << " builds rmq_succinct_sct, rmq_succinct_sada, rmq_support_sparse_table," << endl;
+        cout << " and rmq_support_sparse_table_blocked for n random integers and" << endl;
+        cout << " compares single queries with rmq_batch calls for ranges of" << endl;
+        cout << " length at most range_length." << endl;
+        return 1;
+    }
+    uint64_t n = max(1ULL, stoull(argv[1]));
+    uint64_t range_length = max(1ULL, stoull(argv[2]));
+    const uint64_t reps = 1000000;
+
+    std::mt19937_64 rng(17);
+    int_vector<> v(n, 0, 32);
+    for (uint64_t i=0; i<n; ++i) {
+        v[i] = rng() & 0xFFFFFFFFULL;
+    }
+    query_vec q(reps);
+    for (uint64_t i=0; i<reps; ++i) {
+        uint64_t l = rng() % n;
+        q[i] = {l, l + rng() % min(range_length, n-l)};
+    }
+    cout << "# n = " << n << endl;
+    cout << "# range_length = " << range_length << endl;
+    cout << "# batch_size = " << batch_size << endl;
+    {
+        rmq_succinct_sct<> rmq(&v);
+        run("rmq_sct", rmq, q);
+    }
+    {
+        rmq_succinct_sada<> rmq(&v);
+        run("rmq_sada", rmq, q);
+    }
+    {
+        rmq_support_sparse_table<> rmq(&v);
+        run_scalar("sparse_table", rmq, q);
+    }
+    {
+        rmq_support_sparse_table_blocked<> rmq(&v);
+        run_scalar("sparse_table_blocked", rmq, q);
+    }
+}
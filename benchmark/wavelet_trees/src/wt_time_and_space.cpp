@@ -70,6 +70,60 @@ test_interval_symbols(typename enable_if<has_node_type<t_wt>::value,
     return cnt;
 }
 
+// test topk_freq
+template<class t_wt>
+uint64_t
+test_topk_freq(typename enable_if<!(has_node_type<t_wt>::value),
+               t_wt>::type&, const vector<size_type>&, const vector<size_type>&, uint64_t, uint64_t)
+{
+    return 0; // topk_freq not implemented
+}
+
+template<class t_wt>
+uint64_t
+test_topk_freq(typename enable_if<has_node_type<t_wt>::value,
+               t_wt>::type& wt, const vector<size_type>& is, const vector<size_type>& js, uint64_t mask, uint64_t times=100000000)
+{
+    uint64_t cnt=0;
+    for (uint64_t i=0; i<times; ++i) {
+        if (is[i&mask] < js[i&mask]) {
+            auto res = topk_freq(wt, is[i&mask], js[i&mask]-1, 10);
+            cnt += res.empty() ? 0 : res[0].second;
+        }
+    }
+    return cnt;
+}
+
+// test quantile_freq_batch
+template<class t_wt>
+uint64_t
+test_quantile_freq_batch(typename enable_if<!(has_node_type<t_wt>::value and has_ordered_leaves<t_wt>::value),
+                         t_wt>::type&, const vector<size_type>&, const vector<size_type>&, uint64_t, uint64_t)
+{
+    return 0; // quantile_freq_batch not implemented
+}
+
+template<class t_wt>
+uint64_t
+test_quantile_freq_batch(typename enable_if<has_node_type<t_wt>::value and has_ordered_leaves<t_wt>::value,
+                         t_wt>::type& wt, const vector<size_type>& is, const vector<size_type>& js, uint64_t mask, uint64_t times=100000000)
+{
+    // percentiles 0, 10, ..., 100 of each range
+    vector<size_type> qs(11);
+    uint64_t cnt=0;
+    for (uint64_t i=0; i<times; ++i) {
+        size_type len = js[i&mask] - is[i&mask];
+        if (len > 0) {
+            for (size_type j=0; j<qs.size(); ++j) {
+                qs[j] = (len-1)*j/(qs.size()-1);
+            }
+            auto res = quantile_freq_batch(wt, is[i&mask], js[i&mask]-1, qs);
+            cnt += res[qs.size()/2].first;
+        }
+    }
+    return cnt;
+}
+
 // test lex_count
 template<class t_wt>
 uint64_t
@@ -266,6 +320,20 @@ int main(int argc, char* argv[])
     cout << "# interval_symbols_time = " << duration_cast<microseconds>(stop-start).count()/(double)reps_interval_symbols << endl;
     cout << "# interval_symbols_check = " << check << endl;
 
+    // topk_freq
+    start = timer::now();
+    check = test_topk_freq<WT_TYPE>(wt, is, js, mask, reps_interval_symbols);
+    stop = timer::now();
+    cout << "# topk_freq_time = " << duration_cast<microseconds>(stop-start).count()/(double)reps_interval_symbols << endl;
+    cout << "# topk_freq_check = " << check << endl;
+
+    // quantile_freq_batch
+    start = timer::now();
+    check = test_quantile_freq_batch<WT_TYPE>(wt, is, js, mask, reps_interval_symbols);
+    stop = timer::now();
+    cout << "# quantile_freq_batch_time = " << duration_cast<microseconds>(stop-start).count()/(double)reps_interval_symbols << endl;
+    cout << "# quantile_freq_batch_check = " << check << endl;
+
     // lex_count
     start = timer::now();
     check = test_lex_count<WT_TYPE>(wt, is, js, cs, mask, reps);
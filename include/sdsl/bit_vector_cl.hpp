@@ -0,0 +1,459 @@
+/*!\file bit_vector_cl.hpp
+   \brief bit_vector_cl.hpp contains the sdsl::bit_vector_cl class, and
+          classes which support rank and select for bit_vector_cl.
+*/
+#ifndef SDSL_BIT_VECTOR_CL
+#define SDSL_BIT_VECTOR_CL
+
+#include "int_vector.hpp"
+#include "util.hpp"
+#include "iterators.hpp"
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+template<uint8_t t_b=1>// forward declaration needed for friend declaration
+class rank_support_cl;  // in bit_vector_cl
+
+template<uint8_t t_b=1>// forward declaration needed for friend declaration
+class select_support_cl;  // in bit_vector_cl
+
+//! A bit vector which stores the bits and their rank counters in the same cache lines.
+/*!
+ * The bits are split into lines of 448 bits. Each line is stored in a
+ * 64-byte aligned cache line of eight 64-bit words: the first word contains
+ * the number of set bits before the line, the other seven words the bits.
+ * A rank query therefore touches exactly one cache line and adds at most
+ * seven popcounts to the counter. In contrast to bit_vector_il the line
+ * size is fixed to the cache line size, so no block spans two lines.
+ *
+ * Select queries are answered by select_support_cl, which samples the
+ * line of every 4096-th argument and searches the line counters in between.
+ *
+ * Space: 64/448 = 14.3% on top of the bits, plus the select samples.
+ */
+class bit_vector_cl
+{
+    public:
+        typedef bit_vector::size_type                       size_type;
+        typedef size_type                                   value_type;
+        typedef bit_vector::difference_type                 difference_type;
+        typedef random_access_const_iterator<bit_vector_cl> iterator;
+        typedef bv_tag                                      index_category;
+
+        friend class rank_support_cl<1>;
+        friend class rank_support_cl<0>;
+        friend class select_support_cl<1>;
+        friend class select_support_cl<0>;
+
+        typedef rank_support_cl<1>     rank_1_type;
+        typedef rank_support_cl<0>     rank_0_type;
+        typedef select_support_cl<1> select_1_type;
+        typedef select_support_cl<0> select_0_type;
+
+        enum { line_words = 8 };                  // words per line
+        enum { line_bits  = (line_words-1)*64 };  // data bits per line
+    private:
+        size_type      m_size   = 0;  //!< Size of the original bit vector
+        size_type      m_lines  = 0;  //!< Number of lines
+        size_type      m_offset = 0;  //!< Index of the first line in m_data
+        int_vector<64> m_data;        //!< Lines; 7 words slack to align them to 64 bytes
+
+        const uint64_t* lines()const
+        {
+            return m_data.data() + m_offset;
+        }
+
+        //! Moves the lines to the first 64-byte boundary of m_data.
+        /*! Data which points into a memory mapped file is used in place
+         *  if it is aligned, as moving it would copy every page of the
+         *  mapping. Otherwise it is copied out of the mapping.
+         */
+        void align()
+        {
+            if (m_data.empty()) {
+                return;
+            }
+            if (memory_manager::mapped_bytes(m_data.data())) {
+                if (0 == ((uintptr_t)lines() & 63)) {
+                    return;
+                }
+                int_vector<64> tmp(m_data);
+                m_data.swap(tmp);
+            }
+            if (m_data.size() < m_lines*line_words + line_words-1) {
+                m_data.resize(m_lines*line_words + line_words-1);
+            }
+            size_type offset = ((64 - ((uintptr_t)m_data.data() & 63)) & 63) >> 3;
+            if (offset != m_offset) {
+                memmove(m_data.data() + offset, m_data.data() + m_offset, m_lines*line_words*sizeof(uint64_t));
+                m_offset = offset;
+            }
+        }
+
+        //! Number of set bits before line l.
+        size_type ones_before(size_type l)const
+        {
+            return lines()[l*line_words];
+        }
+
+    public:
+        bit_vector_cl() {}
+        bit_vector_cl(bit_vector_cl&&) = default;
+        bit_vector_cl& operator=(bit_vector_cl&&) = default;
+
+        bit_vector_cl(const bit_vector_cl& bv) : m_size(bv.m_size), m_lines(bv.m_lines),
+            m_offset(bv.m_offset), m_data(bv.m_data)
+        {
+            align();
+        }
+
+        bit_vector_cl& operator=(const bit_vector_cl& bv)
+        {
+            if (this != &bv) {
+                bit_vector_cl tmp(bv);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        bit_vector_cl(const bit_vector& bv)
+        {
+            m_size  = bv.size();
+            // line m_size/line_bits always exists, so rank(size()) reads a valid counter
+            m_lines = m_size/line_bits + 1;
+            m_data  = int_vector<64>(m_lines*line_words + line_words-1, 0);
+            align();
+
+            const uint64_t* bvp = bv.data();
+            size_type words = (m_size+63)>>6;
+            uint64_t* p = m_data.data() + m_offset;
+            size_type cum_sum = 0;
+            for (size_type l=0, w=0; l < m_lines; ++l) {
+                *p++ = cum_sum;
+                for (size_type j=1; j < line_words; ++j, ++w) {
+                    uint64_t x = 0;
+                    if (w+1 < words) {
+                        x = bvp[w];
+                    } else if (w+1 == words) {  // mask bits behind the end
+                        x = bvp[w] & bits::lo_set[m_size - (w<<6)];
+                    }
+                    *p++ = x;
+                    cum_sum += bits::cnt(x);
+                }
+            }
+        }
+
+        //! Accessing the i-th element of the original bit_vector
+        /*! \param i An index i with \f$ 0 \leq i < size()  \f$.
+         *  \return The i-th bit of the original bit_vector
+         *  \par Time complexity
+         *     \f$ \Order{1} \f$
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(i < m_size);
+            size_type w = i>>6;
+            size_type l = w/(line_words-1);
+            return (lines()[l*line_words + 1 + (w - l*(line_words-1))] >> (i&63)) & 1ULL;
+        }
+
+        //! Get the integer value of the binary string of length len starting at position idx.
+        /*! \param idx Starting index of the binary representation of the integer.
+         *  \param len Length of the binary representation of the integer. Default value is 64.
+         *   \returns The integer value of the binary string of length len starting at position idx.
+         *
+         *  \pre idx+len-1 in [0..size()-1]
+         *  \pre len in [1..64]
+         */
+        uint64_t get_int(size_type idx, uint8_t len=64)const
+        {
+            assert(idx+len-1 < m_size);
+            size_type bw = idx>>6;
+            size_type ew = (idx+len-1)>>6;
+            size_type b_word = (bw/(line_words-1))*line_words + 1 + bw%(line_words-1);
+            if (bw == ew) { // spans one word
+                return (lines()[b_word] >> (idx&63)) & bits::lo_set[len];
+            } else { // spans two words
+                size_type e_word = (ew/(line_words-1))*line_words + 1 + ew%(line_words-1);
+                uint8_t b_len = 64-(idx&63);
+                return (lines()[b_word] >> (idx&63))
+                       | (lines()[e_word] & bits::lo_set[len-b_len]) << b_len;
+            }
+        }
+
+        //! Returns the size of the original bit vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_lines, out, child, "lines");
+            // written as an int_vector<64> holding only the lines, so the
+            // output does not depend on the alignment of m_data; the lines
+            // start at a multiple of 64 bytes, so a mapped load uses them in place
+            structure_tree_node* data_child = structure_tree::add_child(child, "data", util::class_name(m_data));
+            size_type data_bytes = int_vector<64>::write_header(m_lines*line_words*64, 64, out, 64);
+            out.write((const char*)lines(), m_lines*line_words*sizeof(uint64_t));
+            data_bytes += m_lines*line_words*sizeof(uint64_t);
+            structure_tree::add_size(data_child, data_bytes);
+            written_bytes += data_bytes;
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            read_member(m_lines, in);
+            m_data.load(in);
+            m_offset = 0;
+            align();
+        }
+
+        void swap(bit_vector_cl& bv)
+        {
+            if (this != &bv) {
+                std::swap(m_size, bv.m_size);
+                std::swap(m_lines, bv.m_lines);
+                std::swap(m_offset, bv.m_offset);
+                m_data.swap(bv.m_data);
+            }
+        }
+
+        iterator begin() const
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end() const
+        {
+            return iterator(this, size());
+        }
+};
+
+//! Rank support for bit_vector_cl; a query touches a single cache line.
+template<uint8_t t_b>
+class rank_support_cl
+{
+        static_assert(t_b == 1 or t_b == 0 , "rank_support_cl only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef bit_vector_cl         bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+        inline size_type rank1(size_type i) const
+        {
+            size_type w = i>>6;
+            size_type l = w/(bit_vector_type::line_words-1);
+            size_type k = w - l*(bit_vector_type::line_words-1); // word in line
+            const uint64_t* p = m_v->lines() + l*bit_vector_type::line_words;
+            size_type res = p[0];
+            // branch-free: full words before k, the prefix of word k, nothing after
+            for (size_type j=0; j < bit_vector_type::line_words-1; ++j) {
+                uint64_t mask = (j < k) ? bits::all_set : ((j == k) ? bits::lo_set[i&63] : 0);
+                res += bits::cnt(p[j+1] & mask);
+            }
+            return res;
+        }
+
+    public:
+
+        rank_support_cl(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the number of occurrences of the bit pattern in [0..i).
+        size_type rank(size_type i) const
+        {
+            assert(m_v != nullptr);
+            assert(i <= m_v->size());
+            if (t_b) return rank1(i);
+            return i - rank1(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return rank(i);
+        }
+
+        //! Prefetches the cache line which is accessed by rank(i).
+        void prefetch(size_type i)const
+        {
+            SDSL_PREFETCH(m_v->lines() + ((i>>6)/(bit_vector_type::line_words-1))*bit_vector_type::line_words);
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        rank_support_cl& operator=(const rank_support_cl& rs)
+        {
+            if (this != &rs) {
+                set_vector(rs.m_v);
+            }
+            return *this;
+        }
+
+        void swap(rank_support_cl&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+//! Select support for bit_vector_cl.
+/*!
+ * Stores the line of every 4096-th argument. A query binary searches the
+ * line counters between two samples and scans the words of the found line.
+ */
+template<uint8_t t_b>
+class select_support_cl
+{
+        static_assert(t_b == 1 or t_b == 0 , "select_support_cl only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef bit_vector_cl         bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+        enum { sample_dens = 4096 };
+    private:
+        const bit_vector_type* m_v;
+        int_vector<>           m_samples; // m_samples[k] = line of the (k*sample_dens+1)-th argument
+
+        //! Number of arguments before line l.
+        size_type args_before(size_type l)const
+        {
+            size_type ones = m_v->ones_before(l);
+            return t_b ? ones : l*bit_vector_type::line_bits - ones;
+        }
+
+        void init_samples()
+        {
+            m_samples = int_vector<>(0, 0, bits::hi(m_v->m_lines)+1);
+            const uint64_t* p = m_v->lines() + (m_v->m_lines-1)*bit_vector_type::line_words;
+            size_type ones = p[0];
+            for (size_type j=1; j < bit_vector_type::line_words; ++j) {
+                ones += bits::cnt(p[j]);
+            }
+            size_type args = t_b ? ones : m_v->size() - ones;
+            m_samples.resize((args+sample_dens-1)/sample_dens);
+            for (size_type l=0, k=0; l < m_v->m_lines and k < m_samples.size(); ++l) {
+                size_type next = (l+1 < m_v->m_lines) ? args_before(l+1) : args;
+                while (k < m_samples.size() and k*sample_dens < next) {
+                    m_samples[k++] = l;
+                }
+            }
+        }
+
+    public:
+
+        select_support_cl(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+            if (m_v != nullptr and m_v->m_lines > 0) {
+                init_samples();
+            }
+        }
+
+        //! Returns the position of the i-th occurrence in the bit vector.
+        size_type select(size_type i) const
+        {
+            assert(i > 0);
+            size_type k  = (i-1)/sample_dens;
+            size_type lb = m_samples[k];
+            size_type rb = (k+1 < m_samples.size()) ? m_samples[k+1] : m_v->m_lines-1;
+            // find the last line l in [lb..rb] with args_before(l) < i
+            while (lb < rb) {
+                size_type mid = (lb+rb+1)/2;
+                if (args_before(mid) < i) {
+                    lb = mid;
+                } else {
+                    rb = mid-1;
+                }
+            }
+            i -= args_before(lb);
+            const uint64_t* p = m_v->lines() + lb*bit_vector_type::line_words + 1;
+            size_type res = lb*bit_vector_type::line_bits;
+            uint64_t x = t_b ? *p : ~*p;
+            size_type args = bits::cnt(x);
+            while (args < i) {
+                i -= args;
+                ++p;
+                x = t_b ? *p : ~*p;
+                args = bits::cnt(x);
+                res += 64;
+            }
+            return res + bits::sel(x, i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return select(i);
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        select_support_cl& operator=(const select_support_cl& ss)
+        {
+            if (this != &ss) {
+                m_samples = ss.m_samples;
+                set_vector(ss.m_v);
+            }
+            return *this;
+        }
+
+        void swap(select_support_cl& ss)
+        {
+            m_samples.swap(ss.m_samples);
+        }
+
+        void load(std::istream& in, const bit_vector_type* v=nullptr)
+        {
+            m_samples.load(in);
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = m_samples.serialize(out, child, "samples");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+};
+
+} // end namespace sdsl
+#endif
@@ -7,8 +7,10 @@
 
 #include "int_vector.hpp"
 #include "bit_vector_il.hpp"
+#include "bit_vector_cl.hpp"
 #include "rrr_vector.hpp"
 #include "sd_vector.hpp"
 #include "hyb_vector.hpp"
+#include "pef_vector.hpp"
 
 #endif
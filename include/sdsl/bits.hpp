@@ -27,11 +27,21 @@
 #ifdef __SSE4_2__
 #include <xmmintrin.h>
 #endif
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
 
 #ifdef WIN32
 #include "iso646.h"
 #endif
 
+// Kernels for AVX2 and AVX-512 are compiled with target attributes and
+// chosen at runtime, see bits::cnt(const uint64_t*, uint64_t). bits::sel
+// uses PDEP if fast_pdep is set or the code is compiled for BMI2.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SDSL_X86_DISPATCH
+#endif
+
 //! Namespace for the succinct data structure library.
 namespace sdsl
 {
@@ -106,6 +116,17 @@ struct bits {
      */
     static uint64_t cnt(uint64_t x);
 
+    //! Counts the number of set bits in the words p[0..n-1].
+    /*! Uses AVX-512 (VPOPCNTDQ) or AVX2 kernels if the CPU supports them.
+        \param p Pointer to the first word.
+        \param n Number of words.
+        \return Number of set bits.
+     */
+    static uint64_t cnt(const uint64_t* p, uint64_t n);
+
+    //! True if the CPU executes PDEP fast, i.e. supports BMI2 and is no AMD CPU before Zen 3.
+    static const bool fast_pdep;
+
     //! Position of the most significant set bit the 64-bit word x
     /*! \param x 64-bit word
         \return The position (in 0..63) of the most significant set bit
@@ -173,6 +194,8 @@ struct bits {
      */
     static uint32_t sel(uint64_t x, uint32_t i);
     static uint32_t _sel(uint64_t x, uint32_t i);
+    //! Variant of sel which deposits the i-th set bit with PDEP. Requires BMI2.
+    static uint32_t _sel_pdep(uint64_t x, uint32_t i);
 
     //! Calculates the position of the i-th rightmost 11-bit-pattern which terminates a Fibonacci coded integer in x.
     /*!	\param x 64 bit integer.
@@ -323,6 +346,13 @@ inline uint64_t bits::map01(uint64_t x, uint64_t c)
 
 inline uint32_t bits::sel(uint64_t x, uint32_t i)
 {
+#if defined(__BMI2__)
+    return _sel_pdep(x, i);
+#elif defined(SDSL_X86_DISPATCH)
+    if (fast_pdep) {
+        return _sel_pdep(x, i);
+    }
+#endif
 #ifdef __SSE4_2__
     uint64_t s = x, b;
     s = s-((s>>1) & 0x5555555555555555ULL);
@@ -345,6 +375,21 @@ inline uint32_t bits::sel(uint64_t x, uint32_t i)
     return _sel(x, i);
 }
 
+inline uint32_t bits::_sel_pdep(uint64_t x, uint32_t i)
+{
+#if defined(__BMI2__)
+    return __builtin_ctzll(_pdep_u64(1ULL << (i-1), x));
+#elif defined(SDSL_X86_DISPATCH)
+    // PDEP as inline assembly, as the intrinsic requires a BMI2 target
+    // and a function with that target is not inlined into sel
+    uint64_t r;
+    __asm__("pdep %2, %1, %0" : "=r"(r) : "r"(1ULL << (i-1)), "rm"(x));
+    return __builtin_ctzll(r);
+#else
+    return _sel(x, i);
+#endif
+}
+
 inline uint32_t bits::_sel(uint64_t x, uint32_t i)
 {
     uint64_t s = x, b;  // s = sum
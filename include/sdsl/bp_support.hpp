@@ -36,6 +36,7 @@
 
 #include "bp_support_g.hpp"
 #include "bp_support_gg.hpp"
+#include "bp_support_rmm.hpp"
 #include "bp_support_sada.hpp"
 
 #endif
@@ -299,6 +299,32 @@ near_enclose(const bit_vector& bp, uint64_t i, const uint64_t block_size);
 uint64_t
 near_rmq_open(const bit_vector& bp, const uint64_t begin, const uint64_t end);
 
+//! Calculates the minimal position j in [l, r) with excess(bp[l..j]) = rel.
+/*! excess(bp[l..j]) denotes the number of opening minus the number of
+ *  closing parentheses in bp[l..j]. The range is processed word by word;
+ *  words which can not contain the answer are skipped with a popcount
+ *  and the excess values of the other words are calculated by AVX2
+ *  prefix sums, if the CPU supports them, or by table lookups.
+ *  \return j, or r if no such position exists.
+ */
+uint64_t
+fwd_excess_in_range(const bit_vector& bp, uint64_t l, uint64_t r, bit_vector::difference_type rel);
+
+//! Calculates the maximal position j in [l, r) with excess(bp[j+1..r-1]) = rel.
+/*! \return j, or r if no such position exists.
+ *  \sa fwd_excess_in_range
+ */
+uint64_t
+bwd_excess_in_range(const bit_vector& bp, uint64_t l, uint64_t r, bit_vector::difference_type rel);
+
+//! Calculates the rightmost position j in [l, r) with minimal excess(bp[l..j]).
+/*! \param min_rel Reference to the minimal excess(bp[l..j]).
+ *  \pre l < r
+ *  \sa fwd_excess_in_range
+ */
+uint64_t
+min_excess_in_range(const bit_vector& bp, uint64_t l, uint64_t r, bit_vector::difference_type& min_rel);
+
 }// end namespace sdsl
 
 #endif
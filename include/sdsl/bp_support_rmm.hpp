@@ -0,0 +1,604 @@
+/*! \file bp_support_rmm.hpp
+    \brief bp_support_rmm.hpp contains a balanced parentheses support structure
+     based on a range min-max tree.
+*/
+#ifndef INCLUDED_SDSL_BP_SUPPORT_RMM
+#define INCLUDED_SDSL_BP_SUPPORT_RMM
+
+#include "int_vector.hpp"
+#include "rank_support.hpp"
+#include "select_support.hpp"
+#include "bp_support_algorithm.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace sdsl
+{
+
+//! A class that provides support for bit_vectors that represent a BP sequence.
+/*! This data structure supports the following operations:
+ *   - find_open
+ *   - find_close
+ *   - enclose
+ *   - double_enclose
+ *   - rank
+ *   - select
+ *   - excess
+ *   - rr_enclose
+ *  An opening parenthesis in the balanced parentheses sequence is represented by a 1 in the bit_vector
+ *  and a closing parenthesis by a 0.
+ *
+ *  The sequence is divided into blocks of t_blk parentheses, which are the
+ *  leaves of a complete binary tree. Each node stores the minimal and the
+ *  maximal excess value of its range. A query scans the block of the
+ *  query position, goes up and down the tree to the block of the answer,
+ *  and scans this block. The scans are done word by word by
+ *  sdsl::fwd_excess_in_range and its siblings, which calculate the
+ *  excess values of a word with AVX2 prefix sums if the CPU supports them.
+ *  There are no medium blocks as in sdsl::bp_support_sada, so a query
+ *  scans at most two blocks.
+ *
+ *  \tparam t_blk    Number of parentheses in a block. Has to be a multiple of 64.
+ *  \tparam t_rank   Type of rank support used for the underlying bitvector.
+ *  \tparam t_select Type of select support used for the underlying bitvector.
+ *
+ *  \par Space complexity
+ *       \f$ 4\lceil\log (2n+2)\rceil \f$ bits per block and the rank and select support.
+ *
+ *  \par References
+ *      - Kunihiko Sadakane, Gonzalo Navarro:
+ *        Fully-Functional Succinct Trees.
+ *        SODA 2010: 134-149
+ *      - Diego Arroyuelo, Rodrigo Cánovas, Gonzalo Navarro, Kunihiko Sadakane:
+ *        Succinct Trees in Practice.
+ *        ALENEX 2010: 84-97
+ *
+ *  @ingroup bps
+ */
+template<uint32_t t_blk = 512,
+         class t_rank   = rank_support_v5<>,
+         class t_select = select_support_mcl<> >
+class bp_support_rmm
+{
+    public:
+        typedef bit_vector::size_type       size_type;
+        typedef bit_vector::difference_type difference_type;
+        typedef int_vector<>                min_max_array_type;
+        typedef t_rank                      rank_type;
+        typedef t_select                    select_type;
+    private:
+        static_assert(0 < t_blk and t_blk % 64 == 0, "bp_support_rmm: t_blk should be a positive multiple of 64!");
+        const bit_vector*  m_bp     = nullptr; // the supported balanced parentheses sequence as bit_vector
+        rank_type          m_bp_rank;          // RS for the BP sequence => see excess() and rank()
+        select_type        m_bp_select;        // SS for the BP sequence => see select()
+        min_max_array_type m_min_max;          // min and max excess of each node plus m_size
+
+        size_type m_size   = 0; // number of supported parentheses
+        size_type m_blocks = 0; // number of blocks
+        size_type m_inner  = 0; // number of inner nodes of the range min-max tree
+
+        void copy(const bp_support_rmm& bp_support)
+        {
+            m_bp        = bp_support.m_bp;
+            m_bp_rank   = bp_support.m_bp_rank;
+            m_bp_rank.set_vector(m_bp);
+            m_bp_select = bp_support.m_bp_select;
+            m_bp_select.set_vector(m_bp);
+            m_min_max   = bp_support.m_min_max;
+            m_size      = bp_support.m_size;
+            m_blocks    = bp_support.m_blocks;
+            m_inner     = bp_support.m_inner;
+        }
+
+        inline static bool is_root(size_type v)
+        {
+            return v==0;
+        }
+
+        inline static bool is_left_child(size_type v)
+        {
+            return v%2;
+        }
+
+        inline static size_type parent(size_type v)
+        {
+            return (v-1)/2;
+        }
+
+        inline bool is_leaf(size_type v)const
+        {
+            return v >= m_inner;
+        }
+
+        inline difference_type min_value(size_type v)const
+        {
+            return (difference_type)m_min_max[2*v] - (difference_type)m_size;
+        }
+
+        inline difference_type max_value(size_type v)const
+        {
+            return (difference_type)m_min_max[2*v+1] - (difference_type)m_size;
+        }
+
+        inline bool contains(size_type v, difference_type ex)const
+        {
+            return min_value(v) <= ex and ex <= max_value(v);
+        }
+
+        //! excess(i-1), i.e. 0 for i=0.
+        inline difference_type excess_before(size_type i)const
+        {
+            return (difference_type)(m_bp_rank(i)<<1) - (difference_type)i;
+        }
+
+        //! Rightmost block in [b1, b2] which contains the minimal excess of the blocks.
+        size_type min_block(size_type b1, size_type b2, difference_type& min_ex)const
+        {
+            size_type left[64] = {}, right[64] = {}, nl = 0, nr = 0;
+            size_type lo = m_inner+b1, hi = m_inner+b2;
+            while (lo <= hi) {
+                if (lo == hi) {
+                    left[nl++] = lo;
+                    break;
+                }
+                if (!is_left_child(lo))
+                    left[nl++] = lo++;
+                if (is_left_child(hi))
+                    right[nr++] = hi--;
+                if (lo > hi)
+                    break;
+                lo = parent(lo);
+                hi = parent(hi);
+            }
+            while (nr > 0)
+                left[nl++] = right[--nr];
+            size_type v = left[0];
+            min_ex = min_value(v);
+            for (size_type k=1; k < nl; ++k) {
+                if (min_value(left[k]) <= min_ex) {
+                    v = left[k];
+                    min_ex = min_value(v);
+                }
+            }
+            while (!is_leaf(v)) {
+                v = 2*v+2;
+                if (min_value(v) != min_ex)
+                    --v;
+            }
+            return v-m_inner;
+        }
+
+    public:
+        const rank_type&          bp_rank   = m_bp_rank;   //!< RS for the underlying BP sequence.
+        const select_type&        bp_select = m_bp_select; //!< SS for the underlying BP sequence.
+        const min_max_array_type& min_max   = m_min_max;   //!< Min and max excess of the nodes of the range min-max tree.
+
+        bp_support_rmm() {}
+
+        //! Constructor
+        explicit bp_support_rmm(const bit_vector* bp): m_bp(bp),
+            m_size(bp==nullptr?0:bp->size()),
+            m_blocks((m_size+t_blk-1)/t_blk)
+        {
+            if (bp == nullptr or bp->size()==0)
+                return;
+            util::init_support(m_bp_rank, bp);
+            util::init_support(m_bp_select, bp);
+
+            // m_inner = (next power of 2 greater than or equal to m_blocks)-1
+            m_inner = 1;
+            while (m_inner < m_blocks)
+                m_inner <<= 1;
+            --m_inner;
+            // empty nodes get the interval [m_size+1, -m_size]
+            m_min_max = int_vector<>(2*(2*m_inner+1), 0, bits::hi(2*m_size+1)+1);
+            for (size_type v=0; v < 2*m_inner+1; ++v)
+                m_min_max[2*v] = 2*m_size+1;
+
+            const uint64_t* b = bp->data();
+            difference_type ex = 0;
+            for (size_type blk=0; blk < m_blocks; ++blk) {
+                difference_type min_ex = ex+1, max_ex = ex-1;
+                size_type i = blk*t_blk, end = std::min(m_size, i+t_blk);
+                for (; i+8 <= end; i+=8) {
+                    uint8_t y = (b[i>>6] >> (i&0x3F)) & 0xFF;
+                    min_ex = std::min(min_ex, ex+excess::data.min[y]);
+                    max_ex = std::max(max_ex, ex-excess::data.min[(uint8_t)~y]);
+                    ex += excess::data.word_sum[y];
+                }
+                for (; i < end; ++i) {
+                    ex += (*bp)[i] ? 1 : -1;
+                    min_ex = std::min(min_ex, ex);
+                    max_ex = std::max(max_ex, ex);
+                }
+                m_min_max[2*(m_inner+blk)]   = min_ex+m_size;
+                m_min_max[2*(m_inner+blk)+1] = max_ex+m_size;
+            }
+            for (size_type v=m_inner; v > 0; --v) {
+                size_type p = v-1;
+                m_min_max[2*p]   = std::min(m_min_max[2*(2*p+1)],   m_min_max[2*(2*p+2)]);
+                m_min_max[2*p+1] = std::max(m_min_max[2*(2*p+1)+1], m_min_max[2*(2*p+2)+1]);
+            }
+        }
+
+        //! Copy constructor
+        bp_support_rmm(const bp_support_rmm& bp_support)
+        {
+            copy(bp_support);
+        }
+
+        //! Move constructor
+        bp_support_rmm(bp_support_rmm&& bp_support)
+        {
+            *this = std::move(bp_support);
+        }
+
+        //! Assignment operator
+        bp_support_rmm& operator=(bp_support_rmm&& bp_support)
+        {
+            if (this != &bp_support) {
+                m_bp        = std::move(bp_support.m_bp);
+                m_bp_rank   = std::move(bp_support.m_bp_rank);
+                m_bp_rank.set_vector(m_bp);
+                m_bp_select = std::move(bp_support.m_bp_select);
+                m_bp_select.set_vector(m_bp);
+                m_min_max   = std::move(bp_support.m_min_max);
+                m_size      = bp_support.m_size;
+                m_blocks    = bp_support.m_blocks;
+                m_inner     = bp_support.m_inner;
+            }
+            return *this;
+        }
+
+        //! Assignment operator
+        bp_support_rmm& operator=(const bp_support_rmm& bp_support)
+        {
+            if (this != &bp_support) {
+                copy(bp_support);
+            }
+            return *this;
+        }
+
+        //! Swap method
+        /*! Swaps the content of the two data structure.
+         *  You have to use set_vector to adjust the supported bit_vector.
+         *  \param bp_support Object which is swapped.
+         */
+        void swap(bp_support_rmm& bp_support)
+        {
+            m_bp_rank.swap(bp_support.m_bp_rank);
+            m_bp_select.swap(bp_support.m_bp_select);
+            m_min_max.swap(bp_support.m_min_max);
+            std::swap(m_size, bp_support.m_size);
+            std::swap(m_blocks, bp_support.m_blocks);
+            std::swap(m_inner, bp_support.m_inner);
+        }
+
+        void set_vector(const bit_vector* bp)
+        {
+            m_bp = bp;
+            m_bp_rank.set_vector(bp);
+            m_bp_select.set_vector(bp);
+        }
+
+        /*! Calculates the excess value at index i.
+         * \param i The index of which the excess value should be calculated.
+         */
+        inline difference_type excess(size_type i)const
+        {
+            return (m_bp_rank(i+1)<<1)-i-1;
+        }
+
+        /*! Returns the number of opening parentheses up to and including index i.
+         * \pre{ \f$ 0\leq i < size() \f$ }
+         */
+        size_type rank(size_type i)const
+        {
+            return m_bp_rank(i+1);
+        }
+
+        /*! Returns the index of the i-th opening parenthesis.
+         * \param i Number of the parenthesis to select.
+         * \pre{ \f$1\leq i < rank(size())\f$ }
+         * \post{ \f$ 0\leq select(i) < size() \f$ }
+         */
+        size_type select(size_type i)const
+        {
+            return m_bp_select(i);
+        }
+
+        //! Calculate the min parenthesis \f$j>i\f$ with \f$excess(j)=excess(i)+rel\f$
+        /*! \param i   The index of a parenthesis in the supported sequence.
+         *  \param rel The excess difference to the excess value of parentheses \f$i\f$.
+         *  \return    If there exists a parenthesis \f$ j>i\f$ with
+         *            \f$ excess(j) = excess(i)+rel \f$, \f$j\f$ is returned
+         *                otherwise size().
+         */
+        size_type fwd_excess(size_type i, difference_type rel)const
+        {
+            // (1) search the block of i
+            size_type end = std::min(m_size, (i/t_blk+1)*t_blk);
+            size_type j = fwd_excess_in_range(*m_bp, i+1, end, rel);
+            if (j < end)
+                return j;
+            // (2) go up the tree to the first right sibling which contains the answer
+            difference_type desired_excess = excess(i)+rel;
+            size_type v = m_inner + i/t_blk;
+            while (!is_root(v)) {
+                if (is_left_child(v) and contains(v+1, desired_excess)) {
+                    ++v;
+                    break;
+                }
+                v = parent(v);
+            }
+            if (is_root(v))
+                return size();
+            // (3) go down the tree to the leftmost block which contains the answer
+            while (!is_leaf(v)) {
+                v = 2*v+1;
+                if (!contains(v, desired_excess))
+                    ++v;
+            }
+            size_type l = (v-m_inner)*t_blk;
+            return fwd_excess_in_range(*m_bp, l, std::min(m_size, l+t_blk), desired_excess-excess_before(l));
+        }
+
+        //! Calculate the maximal parenthesis \f$ j<i \f$ with \f$ excess(j) = excess(i)+rel \f$
+        /*! \param i    The index of a parenthesis in the supported sequence.
+         *  \param rel  The excess difference to the excess value of parenthesis \f$i\f$.
+         *  \return     If there exists a parenthesis \f$j<i\f$ with \f$ excess(j) = excess(i)+rel\f$, \f$j\f$ is returned,
+         *              -1 if \f$ excess(i)+rel = 0 \f$ and no such parenthesis exists,
+         *              otherwise size().
+         */
+        size_type bwd_excess(size_type i, difference_type rel)const
+        {
+            difference_type desired_excess = excess(i)+rel;
+            // (1) search the block of i
+            size_type l = (i/t_blk)*t_blk;
+            if (l < i) {
+                difference_type ex = desired_excess-rel-((*m_bp)[i] ? 1 : -1); // excess(i-1)
+                size_type j = bwd_excess_in_range(*m_bp, l, i, ex-desired_excess);
+                if (j < i)
+                    return j;
+            }
+            // (2) go up the tree to the first left sibling which contains the answer
+            size_type v = m_inner + i/t_blk;
+            while (!is_root(v)) {
+                if (!is_left_child(v) and contains(v-1, desired_excess)) {
+                    --v;
+                    break;
+                }
+                v = parent(v);
+            }
+            if (is_root(v))
+                return desired_excess == 0 ? (size_type)-1 : size();
+            // (3) go down the tree to the rightmost block which contains the answer
+            while (!is_leaf(v)) {
+                v = 2*v+2;
+                if (!contains(v, desired_excess))
+                    --v;
+            }
+            l = (v-m_inner)*t_blk;
+            return bwd_excess_in_range(*m_bp, l, l+t_blk, excess_before(l+t_blk)-desired_excess);
+        }
+
+        /*! Calculate the index of the matching closing parenthesis to the parenthesis at index i.
+         * \param i Index of an parenthesis. 0 <= i < size().
+         * \return * i, if the parenthesis at index i is closing,
+         *         * the position j of the matching closing parenthesis, if a matching parenthesis exists,
+         *         * size() if no matching closing parenthesis exists.
+         */
+        size_type find_close(size_type i)const
+        {
+            assert(i < m_size);
+            if (!(*m_bp)[i]) {// if there is a closing parenthesis at index i return i
+                return i;
+            }
+            return fwd_excess(i, -1);
+        }
+
+        //! Calculate the matching opening parenthesis to the closing parenthesis at position i
+        /*! \param i Index of a closing parenthesis.
+          * \return * i, if the parenthesis at index i is closing,
+          *         * the position j of the matching opening parenthesis, if a matching parenthesis exists,
+          *         * size() if no matching closing parenthesis exists.
+          */
+        size_type find_open(size_type i)const
+        {
+            assert(i < m_size);
+            if ((*m_bp)[i]) {// if there is a opening parenthesis at index i return i
+                return i;
+            }
+            size_type bwd_ex = bwd_excess(i, 0);
+            if (bwd_ex == size())
+                return size();
+            else
+                return bwd_ex+1;
+        }
+
+        //! Calculate the index of the opening parenthesis corresponding to the closest matching parenthesis pair enclosing i.
+        /*! \param i Index of an opening parenthesis.
+         *  \return The index of the opening parenthesis corresponding to the closest matching parenthesis pair enclosing i,
+         *          or size() if no such pair exists.
+         */
+        size_type enclose(size_type i)const
+        {
+            assert(i < m_size);
+            if (!(*m_bp)[i]) { // if there is closing parenthesis at position i
+                return find_open(i);
+            }
+            size_type bwd_ex = bwd_excess(i, -2);
+            if (bwd_ex == size())
+                return size();
+            else
+                return bwd_ex+1;
+        }
+
+        //! The range restricted enclose operation for parentheses pairs \f$(i,\mu(i))\f$ and \f$(j,\mu(j))\f$.
+        /*! \param i First opening parenthesis.
+         *  \param j Second opening parenthesis \f$ i<j \wedge findclose(i) < j \f$.
+         *  \return The smallest index, say k, of an opening parenthesis such that findclose(i) < k < j and
+         *  findclose(j) < findclose(k). If such a k does not exists, restricted_enclose(i,j) returns size().
+         */
+        size_type rr_enclose(const size_type i, const size_type j)const
+        {
+            assert(j < m_size);
+            assert((*m_bp)[i]==1 and(*m_bp)[j]==1);
+            const size_type mip1 = find_close(i)+1;
+            if (mip1 >= j)
+                return size();
+            return rmq_open(mip1, j);
+        }
+
+        /*! Search the interval [l,r-1] for an opening parenthesis, say i, such that find_close(i) >= r.
+         * \param l The left end (inclusive) of the interval to search for the result.
+         * \param r The right end (exclusive) of the interval to search for the result.
+         * \return The minimal opening parenthesis i with \f$ \ell \leq i < r \f$ and \f$ find_close(i) \geq r \f$;
+         *         if no such i exists size() is returned.
+         */
+        size_type rmq_open(const size_type l, const size_type r)const
+        {
+            assert(r < m_bp->size());
+            if (l >= r)
+                return size();
+            size_type res = rmq(l, r-1);
+            assert(res>=l and res<=r-1);
+            if ((*m_bp)[res] == 1) { // The parenthesis with minimal excess is opening
+                assert(find_close(res) >= r);
+                return res;
+            } else {
+                res = res+1; // go to the next parenthesis to the right
+                if (res < r) { // The parenthesis with minimal excess if closing and the next opening parenthesis is less than r
+                    assert((*m_bp)[res] == 1);
+                    size_type ec = enclose(res);
+                    if (ec < l or ec == size()) {
+                        assert(find_close(res)>=r);
+                        return res;
+                    } else {
+                        assert(find_close(ec)>=r);
+                        return ec;
+                    }
+                } else if (res == r) {
+                    size_type ec = enclose(res); // if m_bp[res]==0 => find_open(res), if m_bp[res]==1 => enclose(res)
+                    if (ec >= l) {
+                        assert(ec == size() or excess(ec)==excess(res-1));
+                        return ec;
+                    }
+                }
+            }
+            return size();
+        }
+
+        //! The range minimum query (rmq) returns the index of the parenthesis with minimal excess in the range \f$[l..r]\f$
+        /*! \param l The left border of the interval \f$[l..r]\f$ (\f$l\leq r\f$).
+         *  \param r The right border of the interval \f$[l..r]\f$ (\f$l \leq r\f$).
+         *  \return The rightmost position with minimal excess.
+         */
+        size_type rmq(size_type l, size_type r)const
+        {
+            assert(l<=r);
+            size_type bl = l/t_blk, br = r/t_blk;
+            difference_type min_rel_ex = 0;
+            if (bl == br) {
+                return min_excess_in_range(*m_bp, l, r+1, min_rel_ex);
+            }
+            // the block of l
+            size_type min_pos = min_excess_in_range(*m_bp, l, (bl+1)*t_blk, min_rel_ex);
+            difference_type min_ex = excess_before(l)+min_rel_ex;
+            // the blocks between
+            if (bl+1 < br) {
+                difference_type ex = 0;
+                size_type blk = min_block(bl+1, br-1, ex);
+                if (ex <= min_ex) {
+                    min_pos = min_excess_in_range(*m_bp, blk*t_blk, (blk+1)*t_blk, min_rel_ex);
+                    min_ex  = ex;
+                }
+            }
+            // the block of r
+            size_type j = min_excess_in_range(*m_bp, br*t_blk, r+1, min_rel_ex);
+            if (excess_before(br*t_blk)+min_rel_ex <= min_ex)
+                min_pos = j;
+            return min_pos;
+        }
+
+        //! The double enclose operation
+        /*! \param i Index of an opening parenthesis.
+         *  \param j Index of an opening parenthesis \f$ i<j \wedge findclose(i) < j \f$.
+         *  \return The maximal opening parenthesis, say k, such that \f$ k<j \wedge k>findclose(j) \f$.
+         *          If such a k does not exists, double_enclose(i,j) returns size().
+         */
+        size_type double_enclose(size_type i, size_type j)const
+        {
+            assert(j > i);
+            assert((*m_bp)[i]==1 and(*m_bp)[j]==1);
+            size_type k = rr_enclose(i, j);
+            if (k == size())
+                return enclose(j);
+            else
+                return enclose(k);
+        }
+
+        //! Return the number of zeros which proceed position i in the balanced parentheses sequence.
+        /*! \param i Index of an parenthesis.
+         */
+        size_type preceding_closing_parentheses(size_type i)const
+        {
+            assert(i < m_size);
+            if (!i) return 0;
+            size_type ones = m_bp_rank(i);
+            if (ones) { // ones > 0
+                assert(m_bp_select(ones) < i);
+                return i - m_bp_select(ones) - 1;
+            } else {
+                return i;
+            }
+        }
+
+        /*! The size of the supported balanced parentheses sequence.
+         * \return the size of the supported balanced parentheses sequence.
+         */
+        size_type size() const
+        {
+            return m_size;
+        }
+
+        //! Serializes the bp_support_rmm to a stream.
+        /*!
+         * \param out The outstream to which the data structure is written.
+         * \return The number of bytes written to out.
+         */
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_blocks, out, child, "block_cnt");
+            written_bytes += write_member(m_inner, out, child, "inner_nodes");
+            written_bytes += m_bp_rank.serialize(out, child, "bp_rank");
+            written_bytes += m_bp_select.serialize(out, child, "bp_select");
+            written_bytes += m_min_max.serialize(out, child, "min_max");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Load the bp_support_rmm for a bit_vector v.
+        /*!
+         * \param in The instream from which the data strucutre is read.
+         * \param bp Bit vector representing a balanced parentheses sequence that is supported by this data structure.
+         */
+        void load(std::istream& in, const bit_vector* bp)
+        {
+            m_bp = bp;
+            read_member(m_size, in);
+            assert(m_size == bp->size());
+            read_member(m_blocks, in);
+            read_member(m_inner, in);
+            m_bp_rank.load(in, m_bp);
+            m_bp_select.load(in, m_bp);
+            m_min_max.load(in);
+        }
+};
+
+}// end namespace
+
+#endif
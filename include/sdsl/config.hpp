@@ -30,7 +30,11 @@ typedef std::map<std::string, std::string> tMSS;
 
 enum format_type {JSON_FORMAT, R_FORMAT, HTML_FORMAT};
 
-enum byte_sa_algo_type {LIBDIVSUFSORT, SE_SAIS};
+enum byte_sa_algo_type {LIBDIVSUFSORT, SE_SAIS, PAR_DOUBLING};
+
+enum int_sa_algo_type {QSUFSORT, PAR_DOUBLING_INT};
+
+enum bwt_algo_type {BWT_FROM_SA, BWT_SE_BLOCKWISE};
 
 //! Helper class for construction process
 struct cache_config {
@@ -42,7 +46,9 @@ struct cache_config {
     // a concatenation of PID and a unique ID inside the
     // current process.
     tMSS 		file_map;		// Files stored during the construction process.
-    cache_config(bool f_delete_files=true, std::string f_dir="./", std::string f_id="", tMSS f_file_map=tMSS());
+    uint64_t    threads;        // Number of threads used by parallel construction
+    // algorithms.
+    cache_config(bool f_delete_files=true, std::string f_dir="./", std::string f_id="", tMSS f_file_map=tMSS(), uint64_t f_threads=1);
 };
 
 //! Helper classes to transform width=0 and width=8 to corresponding text key
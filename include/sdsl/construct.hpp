@@ -26,6 +26,7 @@
 #include "int_vector.hpp"
 #include "construct_lcp.hpp"
 #include "construct_bwt.hpp"
+#include "construct_bwt_se.hpp"
 #include "construct_sa.hpp"
 #include <string>
 
@@ -52,6 +53,22 @@ void append_zero_symbol(int_vector& text)
 }
 
 
+//! Constructs a wavelet tree from the prefix of a file buffer.
+/*!
+ * \param wt      Wavelet tree which will contain the result.
+ * \param buf     File buffer of the input.
+ * \param size    Length of the prefix.
+ * \param threads Number of threads. Wavelet trees with a multi-threaded
+ *                construction overload this function, all other wavelet
+ *                trees ignore it.
+ */
+template<class t_wt, class t_buf>
+void construct_wt(t_wt& wt, t_buf& buf, int_vector_size_type size, uint64_t)
+{
+    t_wt tmp(buf, size);
+    wt.swap(tmp);
+}
+
 template<class t_index>
 void construct(t_index& idx, std::string file, uint8_t num_bytes=0)
 {
@@ -103,8 +120,7 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     util::clear(text);
     {
         int_vector_buffer<t_index::alphabet_category::WIDTH> text_buf(tmp_file_name);
-        t_index tmp(text_buf, text_buf.size());
-        idx.swap(tmp);
+        construct_wt(idx, text_buf, text_buf.size(), config.threads);
     }
     sdsl::remove(tmp_file_name);
 }
@@ -133,8 +149,13 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
     {
         // (2) check, if the suffix array is cached
         auto event = memory_monitor::event("SA");
+        // (or the BWT and the suffix array without holding the latter in memory)
         if (!cache_file_exists(conf::KEY_SA, config)) {
-            construct_sa<t_index::alphabet_category::WIDTH>(config);
+            if (construct_config::bwt_algo == BWT_SE_BLOCKWISE and !cache_file_exists(KEY_BWT, config)) {
+                construct_bwt_se<t_index::alphabet_category::WIDTH>(config);
+            } else {
+                construct_sa<t_index::alphabet_category::WIDTH>(config);
+            }
         }
         register_cache_file(conf::KEY_SA, config);
     }
@@ -170,7 +191,7 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
         // (1) check, if the compressed suffix array is cached
         typename t_index::csa_type csa;
         if (!cache_file_exists(std::string(conf::KEY_CSA)+"_"+util::class_to_hash(csa), config)) {
-            cache_config csa_config(false, config.dir, config.id, config.file_map);
+            cache_config csa_config(false, config.dir, config.id, config.file_map, config.threads);
             construct(csa, file, csa_config, num_bytes, csa_t);
             auto event = memory_monitor::event("store CSA");
             config.file_map = csa_config.file_map;
@@ -185,7 +206,9 @@ void construct(t_index& idx, const std::string& file, cache_config& config, uint
         register_cache_file(KEY_BWT, config);
         register_cache_file(conf::KEY_SA, config);
         if (!cache_file_exists(conf::KEY_LCP, config)) {
-            if (t_index::alphabet_category::WIDTH==8) {
+            if (config.threads > 1) {
+                construct_lcp_par_PHI<t_index::alphabet_category::WIDTH>(config);
+            } else if (t_index::alphabet_category::WIDTH==8) {
                 construct_lcp_semi_extern_PHI(config);
             } else {
                 construct_lcp_PHI<t_index::alphabet_category::WIDTH>(config);
@@ -0,0 +1,372 @@
+/*! \file construct_bwt_se.hpp
+    \brief construct_bwt_se.hpp contains a semi-external and multi-threaded
+           construction of the Burrows and Wheeler Transform (BWT) which does
+           not need the suffix array.
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_BWT_SE
+#define INCLUDED_SDSL_CONSTRUCT_BWT_SE
+
+#include "config.hpp"
+#include "construct_config.hpp"
+#include "construct_sa_par.hpp"
+#include "int_vector.hpp"
+#include "io.hpp"
+#include "parallel_helper.hpp"
+#include "util.hpp"
+#include "wt_blcd.hpp"
+#include "wt_int.hpp"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Processes block T[s..e) of the semi-external BWT construction.
+/*!
+ * \param text     Buffer of the text T[0..n-1].
+ * \param s        Start of the block.
+ * \param e        End of the block. T[e..n-1] is the tail which was
+ *                 processed before.
+ * \param files    [BWT, SA, GT] of the tail (in) and of T[s..n-1] (out).
+ *                 GT[n-1-k] = 1 iff T[k..] > T[e..] (in) or T[k..] > T[s..] (out).
+ * \param with_sa  If false, the SA files are neither read nor written.
+ * \param with_gt  If false, the output GT file is not written.
+ * \param threads  Number of threads.
+ */
+template<class t_int, uint8_t t_width>
+void _construct_bwt_se_block(int_vector_buffer<t_width>& text, uint64_t s, uint64_t e,
+                             const std::string* in, const std::string* out,
+                             bool with_sa, bool with_gt, uint64_t threads)
+{
+    typedef typename std::conditional<t_width == 8, wt_blcd<>, wt_int<>>::type wt_type;
+    const uint64_t n = text.size(), m = e-s;
+    const uint64_t w = std::min(m, n-e);          // length of the window T[e..e+w)
+    const uint8_t  sa_width = bits::hi(n)+1;
+    const uint64_t buf_size = std::min((uint64_t)1<<20, 8*n+64); // bytes per file buffer
+
+    // (1) Load the block and the window T[e..e+w) with GT[k] for k in [e..e+w]
+    int_vector<t_width> blk(m, 0, text.width()), win(w, 0, text.width());
+    for (uint64_t i=0; i < m; ++i)
+        blk[i] = text[s+i];
+    for (uint64_t i=0; i < w; ++i)
+        win[i] = text[e+i];
+    bit_vector gt_win(w+1, 0);
+    if (e < n) {
+        int_vector_buffer<1> gt_buf(in[2], std::ios::in, buf_size);
+        for (uint64_t k=e+1; k <= e+w and k < n; ++k)
+            gt_win[k-e] = gt_buf[n-1-k];
+    }
+
+    // (2) gt[i] = 1 iff T[s+i..] > T[e..]. Calculated with the Z-function
+    // of window#block; if T[s+i..e) is a prefix of T[e..], the comparison
+    // continues with T[e..] and T[2e-s-i..], which is answered by gt_win.
+    bit_vector gt(m, 1);
+    if (e < n) {
+        const uint64_t len = w+1+m;
+        auto x = [&](uint64_t i) -> uint64_t {
+            return i < w ? (uint64_t)win[i] : (i == w ? (uint64_t)-1 : (uint64_t)blk[i-w-1]);
+        };
+        std::vector<t_int> z(len, 0);
+        for (uint64_t i=1, l=0, r=0; i < len; ++i) {
+            uint64_t zi = (i < r) ? std::min(r-i, (uint64_t)z[i-l]) : 0;
+            while (i+zi < len and x(zi) == x(i+zi))
+                ++zi;
+            z[i] = zi;
+            if (i+zi > r) {
+                l = i;
+                r = i+zi;
+            }
+        }
+        for (uint64_t i=0; i < m; ++i) {
+            uint64_t l = z[w+1+i];
+            if (l < m-i) {
+                gt[i] = (l == w) or blk[i+l] > win[l];
+            } else {
+                gt[i] = !gt_win[m-i];
+            }
+        }
+    }
+
+    // (3) Sort the suffixes of the block. Symbol c at position i is mapped
+    // to 3c+2gt[i]; the appended symbol 3T[e]+1 (or 0 for e=n) resolves
+    // comparisons which reach the end of the block.
+    std::vector<t_int> sa(m+1);
+    {
+        uint64_t max_symbol = e < n ? (uint64_t)win[0] : 0;
+        for (uint64_t i=0; i < m; ++i)
+            max_symbol = std::max(max_symbol, (uint64_t)blk[i]);
+        int_vector<> u(m+1, 0, bits::hi(3*max_symbol+2)+1);
+        for (uint64_t i=0; i < m; ++i)
+            u[i] = 3*blk[i] + 2*gt[i];
+        u[m] = e < n ? 3*win[0]+1 : 0;
+        _construct_sa_par(u, m+1, sa.data(), threads);
+    }
+    sa.erase(std::find(sa.begin(), sa.end(), (t_int)m));
+    util::clear(gt);
+
+    // (4) BWT of the block and GT for the positions of the block
+    uint64_t q_s = m;
+    int_vector<t_width> lb(m, 0, text.width()); // lb[q_s] = 0 marks T[s-1]
+    bit_vector gt_blk(m, 0);
+    for (uint64_t q=0; q < m; ++q) {
+        if (sa[q] == 0) {
+            q_s = q;
+        } else {
+            lb[q] = blk[sa[q]-1];
+            gt_blk[sa[q]] = (q_s < m);
+        }
+    }
+    const uint64_t bwt_q_s = text[s > 0 ? s-1 : n-1];
+
+    // (5) gap[q] = number of suffixes of the tail which are between the
+    // q-1-th and the q-th suffix of the block
+    std::vector<uint64_t> gap(m+1, 0);
+    int_vector_buffer<1> gt_out;
+    if (with_gt)
+        gt_out = int_vector_buffer<1>(out[2], std::ios::out, buf_size);
+    if (e < n) {
+        wt_type wt;
+        {
+            std::string lb_file = tmp_file(out[0], "_lb");
+            store_to_file(lb, lb_file);
+            int_vector_buffer<t_width> lb_buf(lb_file, std::ios::in, buf_size);
+            construct_wt(wt, lb_buf, m, threads);
+            lb_buf.close(true);
+        }
+        const uint64_t last = blk[m-1];
+        // number of suffixes of the block which start with a symbol smaller than c > 0
+        std::vector<uint64_t> c_tab(t_width == 8 ? 256 : 0);
+        auto smaller = [&](uint64_t c) -> uint64_t {
+            return std::get<1>(wt.lex_smaller_count(m, c)) - 1 + (last < c);
+        };
+        for (uint64_t c=1; c < c_tab.size(); ++c)
+            c_tab[c] = smaller(c);
+
+        int_vector_buffer<1> gt_in(in[2], std::ios::in, buf_size);
+        int_vector_buffer<t_width> text_rnd(text.filename(), std::ios::in, 1<<12);
+        int_vector_buffer<1> gt_rnd(in[2], std::ios::in, 1<<12);
+        // number of suffixes of the block which are smaller than T[k..]. A
+        // comparison reads at most up to the end of the block; the block
+        // suffixes between sa[lo-1] and sa[hi] share min(l_lo, l_hi) symbols
+        // with T[k..], which are skipped.
+        auto tail_rank = [&](uint64_t k) -> uint64_t {
+            uint64_t lo = 0, hi = m, l_lo = 0, l_hi = 0;
+            while (lo < hi) {
+                uint64_t mid = lo+(hi-lo)/2, i = sa[mid];
+                uint64_t l = std::min(std::min(l_lo, l_hi), m-i);
+                bool less;
+                while (true) {
+                    if (i+l == m) {
+                        less = gt_rnd[n-1-(k+l)];
+                        break;
+                    }
+                    uint64_t a = blk[i+l], b = text_rnd[k+l];
+                    if (a != b) {
+                        less = a < b;
+                        break;
+                    }
+                    ++l;
+                }
+                if (less) {
+                    lo = mid+1;
+                    l_lo = l;
+                } else {
+                    hi = mid;
+                    l_hi = l;
+                }
+            }
+            return lo;
+        };
+
+        // The tail is processed from right to left in rounds. Each thread
+        // calculates the ranks of one chunk of a round with LF steps over
+        // the BWT of the block; the rank of the chunk end is determined by
+        // a binary search.
+        ++gap[0]; // T[n-1..] is the smallest suffix
+        if (with_gt)
+            gt_out.push_back(0);
+        const uint64_t chunk = 1ULL<<18;
+        int_vector<t_width> t_round(0, 0, text.width());
+        bit_vector gt_round;
+        std::vector<t_int> r_round;
+        uint64_t r_hi = 0;
+        for (uint64_t hi = n-1; hi > e;) {
+            uint64_t lo = (hi-e > threads*chunk) ? hi-threads*chunk : e;
+            t_round.resize(hi-lo);
+            gt_round.resize(hi-lo);
+            r_round.resize(hi-lo);
+            for (uint64_t k=lo; k < hi; ++k)
+                t_round[k-lo] = text[k];
+            for (uint64_t k=hi; k > lo; --k)
+                gt_round[k-1-lo] = gt_in[n-1-k];
+            uint64_t chunks = (hi-lo+chunk-1)/chunk;
+            std::vector<uint64_t> r_start(chunks);
+            for (uint64_t c=0; c < chunks; ++c)
+                r_start[c] = (c+1 == chunks) ? r_hi : tail_rank(lo+(c+1)*chunk);
+            parallel_for(chunks, threads, [&](uint64_t c, uint64_t) {
+                uint64_t r = r_start[c];
+                for (uint64_t k=std::min(hi, lo+(c+1)*chunk); k-- > lo+c*chunk;) {
+                    uint64_t sym = t_round[k-lo];
+                    uint64_t rank_c = std::get<0>(wt.lex_smaller_count(r, sym));
+                    r = (t_width == 8 ? c_tab[sym] : smaller(sym)) + rank_c
+                        + (last == sym and gt_round[k-lo]);
+                    r_round[k-lo] = r;
+                }
+            }, 1);
+            for (uint64_t k=hi; k > lo; --k) {
+                ++gap[r_round[k-1-lo]];
+                if (with_gt)
+                    gt_out.push_back(r_round[k-1-lo] > q_s);
+            }
+            r_hi = r_round[0];
+            hi = lo;
+        }
+    }
+    if (with_gt) {
+        for (uint64_t k=e; k > s; --k)
+            gt_out.push_back(gt_blk[k-1-s]);
+        gt_out.close();
+    }
+
+    // (6) Merge the tail and the block
+    int_vector_buffer<t_width> bwt_out(out[0], std::ios::out, buf_size, text.width());
+    int_vector_buffer<> sa_out;
+    int_vector_buffer<t_width> bwt_in;
+    int_vector_buffer<> sa_in;
+    if (with_sa)
+        sa_out = int_vector_buffer<>(out[1], std::ios::out, buf_size, sa_width);
+    if (e < n) {
+        bwt_in = int_vector_buffer<t_width>(in[0], std::ios::in, buf_size);
+        if (with_sa)
+            sa_in = int_vector_buffer<>(in[1], std::ios::in, buf_size);
+    }
+    for (uint64_t q=0, j=0; q <= m; ++q) {
+        for (uint64_t g=0; g < gap[q]; ++g, ++j) {
+            bwt_out.push_back(bwt_in[j]);
+            if (with_sa)
+                sa_out.push_back(sa_in[j]);
+        }
+        if (q < m) {
+            bwt_out.push_back(q == q_s ? bwt_q_s : (uint64_t)lb[q]);
+            if (with_sa)
+                sa_out.push_back(s+sa[q]);
+        }
+    }
+}
+
+//! Number of bytes per symbol of a block which construct_bwt_se needs at most.
+/*! The peak is reached while the suffixes of the block are sorted: the
+ *  block and the window of the tail (2 symbols), the mapped block (a symbol
+ *  plus 2 bits), and five words of the suffix array type for the suffix
+ *  array, the ranks, and the keys and merge buffer of _construct_sa_par.
+ *  The z array (2 words) and the gap array (8 bytes) of the other steps
+ *  are smaller.
+ *  \param text_width Width of the text symbols in bits.
+ *  \param block_size Number of symbols of a block.
+ */
+inline uint64_t _bwt_se_bytes_per_symbol(uint8_t text_width, uint64_t block_size)
+{
+    const uint64_t w = (block_size+1 < 0x7FFFFFFFULL) ? 4 : 8;
+    return 2*((text_width+7)/8) + (std::min(64, text_width+2)+7)/8 + 5*w;
+}
+
+//! Constructs the BWT, and optionally the SA, from a text without holding the SA in memory.
+/*! The text is split into blocks of `block_size` symbols, which are
+ *  processed from right to left. The suffixes of a block are sorted in
+ *  memory with the parallel prefix doubling algorithm; comparisons which
+ *  reach the end of the block are resolved by the GT bits of the tail,
+ *  i.e. whether a suffix of the tail is greater than the first suffix of the
+ *  tail. The BWT of the block is then merged into the BWT of the tail on
+ *  disk: the position of each tail suffix among the block suffixes is
+ *  calculated by scanning the tail from right to left with LF steps over
+ *  a wavelet tree of the block BWT (cf. bwt-disk of Ferragina et al.).
+ *  The scan starts in parallel at the ends of chunks of 2^18 tail
+ *  suffixes, whose positions are found by binary search over the sorted
+ *  block suffixes.
+ *
+ *  \tparam t_width Width of the text. 0==integer alphabet, 8=byte alphabet.
+ *  \param config     Reference to cache configuration. config.threads
+ *                    threads are used for sorting and scanning.
+ *  \param block_size Number of symbols of a block. If 0, the largest block
+ *                    which fits into construct_config::memory_budget is used.
+ *  \param with_sa    If true, the SA is also stored. It is merged on disk
+ *                    like the BWT, i.e. it is never held in memory.
+ *  \par Space complexity
+ *      About 24 (44 if block_size >= 2^31) bytes per symbol of a block for
+ *      byte alphabets, see _bwt_se_bytes_per_symbol. The measured peak
+ *      for a block of 2^24 symbols is about 22 bytes per symbol for a
+ *      unary and 14 for a random text.
+ *  \par Time complexity
+ *      \f$ \Order{n^2/block\_size \cdot t_{rank}} \f$; the text, BWT and
+ *      SA files are scanned once per block. A step of the binary search
+ *      compares up to block_size symbols, e.g. for periodic texts, which
+ *      adds \f$ \Order{n/2^{18} \cdot block\_size \log block\_size} \f$ per
+ *      block in the worst case; for texts with small LCP values it is negligible.
+ *  \pre Text exist in the cache. Key
+ *         * conf::KEY_TEXT for t_width=8 or conf::KEY_TEXT_INT for t_width=0
+ *       Symbols are smaller than \f$2^{62}\f$.
+ *  \post BWT exist in the cache. Keys
+ *         * conf::KEY_BWT for t_width=8 or conf::KEY_BWT_INT for t_width=0
+ *         * conf::KEY_SA if with_sa is true
+ */
+template<uint8_t t_width>
+void construct_bwt_se(cache_config& config, uint64_t block_size=construct_config::bwt_block_size,
+                      bool with_sa=true)
+{
+    static_assert(t_width == 0 or t_width == 8 , "construct_bwt_se: width must be `0` for integer alphabet and `8` for byte alphabet");
+    const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    const char* KEY_BWT  = key_bwt_trait<t_width>::KEY_BWT;
+    const uint64_t threads = std::max((uint64_t)1, config.threads);
+
+    int_vector_buffer<t_width> text(cache_file_name(KEY_TEXT, config));
+    const uint64_t n = text.size();
+    if (block_size == 0) {
+        block_size = construct_config::memory_budget / _bwt_se_bytes_per_symbol(text.width(), 0);
+        if (block_size+1 >= 0x7FFFFFFFULL) {
+            block_size = construct_config::memory_budget / _bwt_se_bytes_per_symbol(text.width(), block_size);
+        }
+    }
+    block_size = std::max((uint64_t)1, block_size);
+    std::string tmp[2][3];
+    for (uint64_t p=0; p < 2; ++p) {
+        for (uint64_t f=0; f < 3; ++f) {
+            tmp[p][f] = tmp_file(config, "_bwt_se_"+util::to_string(3*p+f));
+        }
+    }
+    const std::string result[3] = {cache_file_name(KEY_BWT, config), cache_file_name(conf::KEY_SA, config), ""};
+    if (n == 0) {
+        int_vector<t_width> bwt(0, 0, text.width());
+        store_to_file(bwt, result[0]);
+        if (with_sa) {
+            store_to_file(int_vector<>(0, 0, 1), result[1]);
+        }
+    }
+    const uint64_t blocks = (n+block_size-1)/block_size;
+    for (uint64_t b=blocks, p=0; b > 0; --b, p^=1) {
+        uint64_t s = (b-1)*block_size, e = std::min(n, b*block_size);
+        const std::string* out = (b == 1) ? result : tmp[p];
+        if (e-s+1 < 0x7FFFFFFFULL) {
+            _construct_bwt_se_block<uint32_t>(text, s, e, tmp[p^1], out, with_sa, b > 1, threads);
+        } else {
+            _construct_bwt_se_block<uint64_t>(text, s, e, tmp[p^1], out, with_sa, b > 1, threads);
+        }
+        for (uint64_t f=0; f < 3; ++f) {
+            sdsl::remove(tmp[p^1][f]);
+        }
+    }
+    for (uint64_t p=0; p < 2; ++p) {
+        for (uint64_t f=0; f < 3; ++f) {
+            sdsl::remove(tmp[p][f]);
+        }
+    }
+    register_cache_file(KEY_BWT, config);
+    if (with_sa)
+        register_cache_file(conf::KEY_SA, config);
+}
+
+}// end namespace
+
+#endif
@@ -10,6 +10,11 @@ class construct_config
 {
     public:
         static byte_sa_algo_type byte_algo_sa;
+        static int_sa_algo_type  int_algo_sa;
+        static bwt_algo_type     bwt_algo;
+        static uint64_t          bwt_block_size;
+        static bool              async_io;
+        static uint64_t          memory_budget; // bytes for temporary data of the construction
 
         construct_config() = delete;
 };
@@ -33,6 +33,7 @@
 #include "wt_huff.hpp"
 #include "wt_algorithm.hpp"
 #include "construct_lcp_helper.hpp"
+#include "parallel_helper.hpp"
 
 #include <iostream>
 #include <stdexcept>
@@ -180,6 +181,118 @@ void construct_lcp_PHI(cache_config& config)
     register_cache_file(conf::KEY_LCP, config);
 }
 
+template<uint8_t t_width, class t_phi_vec>
+void _construct_lcp_par_PHI(cache_config& config, uint64_t n)
+{
+    typedef int_vector<>::size_type size_type;
+    typedef int_vector<t_width> text_type;
+    const char* KEY_TEXT = key_text_trait<t_width>::KEY_TEXT;
+    const std::string sa_file = cache_file_name(conf::KEY_SA, config);
+    const uint64_t threads = std::max((uint64_t)1, config.threads);
+    const size_type block_size = std::max((size_type)1<<20, (n+threads*4-1)/(threads*4));
+    const size_type blocks = (n+block_size-1)/block_size;
+    const size_type buffer_size = 1000000; // buffer_size is a multiple of 8!
+
+//	(1) Calculate PHI (stored in array plcp); each block of SA is read by an own buffer
+    t_phi_vec plcp(n, 0);
+    parallel_for(blocks, threads, [&](uint64_t b, uint64_t) {
+        int_vector_buffer<> sa_buf(sa_file, std::ios::in, buffer_size);
+        size_type begin = b*block_size, end = std::min(n, begin+block_size);
+        size_type sai_1 = begin ? sa_buf[begin-1] : 0;
+        for (size_type i=begin; i < end; ++i) {
+            size_type sai = sa_buf[i];
+            plcp[ sai ] = sai_1;
+            sai_1 = sai;
+        }
+    });
+
+//  (2) Load text from disk
+    text_type text;
+    load_from_cache(text, KEY_TEXT, config);
+
+//  (3) Calculate permuted LCP array (text order), called PLCP. Each block
+//      starts with l=0, i.e. at most the lcp-value of the first position of
+//      a block is recomputed from scratch.
+    std::vector<size_type> max_ls(threads, 0);
+    parallel_for(blocks, threads, [&](uint64_t b, uint64_t t) {
+        size_type begin = b*block_size, end = std::min(n-1, begin+block_size);
+        size_type max_l = 0;
+        for (size_type i=begin, l=0; i < end; ++i) {
+            size_type phii = plcp[i];
+            while (text[i+l] == text[phii+l]) {
+                ++l;
+            }
+            plcp[i] = l;
+            if (l) {
+                max_l = std::max(max_l, l);
+                --l;
+            }
+        }
+        max_ls[t] = std::max(max_ls[t], max_l);
+    });
+    util::clear(text);
+    uint8_t lcp_width = bits::hi(*std::max_element(max_ls.begin(), max_ls.end()))+1;
+
+//	(4) Transform PLCP into LCP. Blocks are multiples of 64 entries, so
+//      that no two threads write into the same word of lcp.
+    int_vector<> lcp(n, 0, lcp_width);
+    const size_type lcp_block_size = ((block_size+63)/64)*64;
+    const size_type lcp_blocks = (n+lcp_block_size-1)/lcp_block_size;
+    parallel_for(lcp_blocks, threads, [&](uint64_t b, uint64_t) {
+        int_vector_buffer<> sa_buf(sa_file, std::ios::in, buffer_size);
+        size_type begin = std::max((size_type)1, b*lcp_block_size);
+        size_type end = std::min(n, (b+1)*lcp_block_size);
+        for (size_type i=begin; i < end; ++i) {
+            lcp[i] = plcp[sa_buf[i]];
+        }
+    });
+    util::clear(plcp);
+    store_to_cache(lcp, conf::KEY_LCP, config);
+}
+
+//! Construct the LCP array for text over byte- or integer-alphabet with multiple threads.
+/*!	The algorithm computes the lcp array and stores it to disk. It is a
+ *  parallel variant of construct_lcp_PHI. The SA and the text are partitioned
+ *  into blocks which are processed concurrently by config.threads threads.
+ *  \pre Text and Suffix array exist in the cache. Keys:
+ *         * conf::KEY_TEXT for t_width=8  or conf::KEY_TEXT_INT for t_width=0
+ *         * conf::KEY_SA
+ *  \post LCP array exist in the cache. Key
+ *         * conf::KEY_LCP
+ *  \par Time complexity
+ *         \f$ \Order{n/p + b \cdot maxlcp} \f$ for \f$ p \f$ threads and
+ *         \f$ b \f$ blocks.
+ *  \par Space complexity
+ *         \f$ n( \log \sigma + 32 ) \f$ bits for \f$ n < 2^{32} \f$ and
+ *         \f$ n( \log \sigma + 64 ) \f$ bits otherwise
+ *  \par Reference
+ *         Juha Kärkkäinen, Giovanni Manzini, Simon J. Puglisi:
+ *         Permuted Longest-Common-Prefix Array.
+ *         CPM 2009: 181-192
+ */
+template<uint8_t t_width>
+void construct_lcp_par_PHI(cache_config& config)
+{
+    static_assert(t_width == 0 or t_width == 8 , "construct_lcp_par_PHI: width must be `0` for integer alphabet and `8` for byte alphabet");
+    uint64_t n = 0;
+    {
+        int_vector_buffer<> sa_buf(cache_file_name(conf::KEY_SA, config));
+        n = sa_buf.size();
+    }
+    assert(n > 0);
+    if (1 == n) {  // Handle special case: Input only the sentinel character.
+        int_vector<> lcp(1, 0);
+        store_to_cache(lcp, conf::KEY_LCP, config);
+        return;
+    }
+    // PHI is written concurrently, so its entries have to be separate words
+    if (n < (1ULL<<32)) {
+        _construct_lcp_par_PHI<t_width, int_vector<32>>(config, n);
+    } else {
+        _construct_lcp_par_PHI<t_width, int_vector<64>>(config, n);
+    }
+}
+
 
 //! Construct the LCP array (only for byte strings)
 /*!	The algorithm computes the lcp array and stores it to disk.
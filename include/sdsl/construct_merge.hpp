@@ -0,0 +1,197 @@
+/*! \file construct_merge.hpp
+    \brief construct_merge.hpp contains a function which merges two CSAs
+           into the CSA of the concatenation of their texts.
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_MERGE
+#define INCLUDED_SDSL_CONSTRUCT_MERGE
+
+#include "config.hpp"
+#include "construct_sa_par.hpp"
+#include "int_vector.hpp"
+#include "io.hpp"
+#include "parallel_helper.hpp"
+#include "suffix_array_algorithm.hpp"
+#include "suffix_array_helper.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Number of symbols of the text of csa which are smaller than c.
+template<class t_csa>
+typename t_csa::size_type _csa_smaller_count(const t_csa& csa, typename t_csa::char_type c)
+{
+    typename t_csa::size_type lo = 0, hi = csa.sigma;
+    while (lo < hi) { // first compact character which is not smaller than c
+        typename t_csa::size_type mid = lo+(hi-lo)/2;
+        if (csa.comp2char[mid] < c) lo = mid+1;
+        else hi = mid;
+    }
+    return csa.C[lo];
+}
+
+//! Writes the text, BWT and SA of the concatenation of the texts of a and b to the cache.
+/*!
+ * Let T1$ be the text of a and T2$ the text of b. The suffixes of T2$
+ * keep their order in T1T2$, the suffixes of T1 are ranked among them by
+ * a backward search of T1 in b, which starts at the position of T2$.
+ * Suffixes of T1 which are equal up to the end of T1 are ordered like
+ * in the semi-external BWT construction: symbol c at position i is mapped
+ * to 3c+2gt[i], where gt[i]=1 iff T1[i..]T2$ > T2$, and the resulting
+ * string is sorted in memory.
+ */
+template<class t_int, class t_csa>
+void _merge_csa(const t_csa& a, const t_csa& b, cache_config& config)
+{
+    typedef typename t_csa::char_type char_type;
+    const uint8_t t_width = t_csa::alphabet_category::WIDTH;
+    const uint64_t threads = std::max((uint64_t)1, config.threads);
+    const uint64_t m = a.size()-1, n_b = b.size(), n = m+n_b;
+    const uint8_t width = (t_width == 8) ? 8 : bits::hi(std::max((uint64_t)a.comp2char[a.sigma-1],
+                          (uint64_t)b.comp2char[b.sigma-1]))+1;
+
+    // (1) Extract T1 and rank its suffixes among the suffixes of T2$
+    int_vector<t_width> t1(m, 0, width);
+    extract(a, 0, m-1, t1.begin());
+    const uint64_t isa_b0 = b.isa[0];
+    std::vector<t_int> r_b(m+1);
+    r_b[m] = isa_b0;
+    for (uint64_t i=m; i > 0; --i) {
+        char_type c = t1[i-1];
+        r_b[i-1] = _csa_smaller_count(b, c) + b.bwt.rank(r_b[i], c);
+    }
+
+    // (2) Sort the suffixes of T1
+    std::vector<t_int> sa(m+1);
+    {
+        uint64_t max_symbol = (uint64_t)first_row_symbol(isa_b0, b);
+        for (uint64_t i=0; i < m; ++i)
+            max_symbol = std::max(max_symbol, (uint64_t)t1[i]);
+        int_vector<> u(m+1, 0, bits::hi(3*max_symbol+2)+1);
+        for (uint64_t i=0; i < m; ++i)
+            u[i] = 3*t1[i] + 2*(r_b[i] > isa_b0);
+        u[m] = 3*(uint64_t)first_row_symbol(isa_b0, b)+1;
+        _construct_sa_par(u, m+1, sa.data(), threads);
+    }
+    sa.erase(std::find(sa.begin(), sa.end(), (t_int)m));
+
+    // (3) Text and SA of b, the latter shifted by |T1|. Each thread walks
+    // with LF over a range of text positions. The ranges start at multiples
+    // of 64, so the threads write to different words of text_b.
+    std::vector<t_int> sa_b(n_b);
+    int_vector<t_width> text_b(n_b, 0, width);
+    {
+        const uint64_t step = ((std::max((uint64_t)1<<16, (n_b+4*threads-1)/(4*threads))+63)>>6)<<6;
+        parallel_for((n_b+step-1)/step, threads, [&](uint64_t j, uint64_t) {
+            uint64_t lo = j*step, hi = std::min(n_b, lo+step);
+            uint64_t row = b.isa[hi-1];
+            for (uint64_t k=hi; k > lo; --k) {
+                sa_b[row] = k-1+m;
+                text_b[k-1] = (uint64_t)first_row_symbol(row, b);
+                row = b.lf[row];
+            }
+        });
+    }
+    {
+        int_vector_buffer<t_width> text_out(cache_file_name(key_text_trait<t_width>::KEY_TEXT, config), std::ios::out, 1<<20, width);
+        for (uint64_t i=0; i < m; ++i)
+            text_out.push_back(t1[i]);
+        for (uint64_t k=0; k < n_b; ++k)
+            text_out.push_back(text_b[k]);
+    }
+    util::clear(text_b);
+
+    // (4) Merge
+    int_vector_buffer<t_width> bwt_out(cache_file_name(key_bwt_trait<t_width>::KEY_BWT, config), std::ios::out, 1<<20, width);
+    int_vector_buffer<> sa_out(cache_file_name(conf::KEY_SA, config), std::ios::out, 1<<20, bits::hi(n)+1);
+    const uint64_t chunk = 1ULL<<20;
+    std::vector<char_type> bwt_b;
+    auto push_b = [&](uint64_t r) {
+        if (r % chunk == 0) { // decode the next chunk of the BWT of b in parallel
+            bwt_b.resize(std::min(chunk, n_b-r));
+            parallel_for(bwt_b.size(), threads, [&](uint64_t i, uint64_t) {
+                bwt_b[i] = b.bwt[r+i];
+            }, 1<<12);
+        }
+        bwt_out.push_back(r == isa_b0 ? t1[m-1] : (uint64_t)bwt_b[r % chunk]);
+        sa_out.push_back(sa_b[r]);
+    };
+    uint64_t r = 0;
+    for (uint64_t q=0; q < m; ++q) {
+        uint64_t i = sa[q];
+        for (; r < r_b[i]; ++r)
+            push_b(r);
+        bwt_out.push_back(i > 0 ? (uint64_t)t1[i-1] : 0);
+        sa_out.push_back(i);
+    }
+    for (; r < n_b; ++r)
+        push_b(r);
+    register_cache_file(key_text_trait<t_width>::KEY_TEXT, config);
+    register_cache_file(key_bwt_trait<t_width>::KEY_BWT, config);
+    register_cache_file(conf::KEY_SA, config);
+}
+
+//! Merges two CSAs into the CSA of the concatenation of their texts.
+/*!
+ * \param res    The result: the CSA of T1T2$, where T1$ is the text of a
+ *               and T2$ the text of b. T1 is followed directly by T2,
+ *               i.e. occurrences of a pattern can span both texts and
+ *               the positions of b are shifted by |T1|. Documents can be
+ *               delimited by a separator symbol.
+ * \param a      CSA of the first text.
+ * \param b      CSA of the second text.
+ * \param config Cache configuration for the text, BWT and SA files of the
+ *               result; config.threads threads are used.
+ *
+ * The suffixes of b are not sorted again: they keep their order and b
+ * is only walked once with LF. The suffixes of T1 are ranked among them
+ * by a backward search and sorted in memory. In an LSM-style scheme new
+ * documents are therefore collected in a small CSA, which is merged as
+ * `a` into the large CSA `b`. The result is constructed from the merged
+ * BWT and SA like by sdsl::construct, so it is identical to the CSA
+ * constructed from T1T2$ and can be stored and loaded as usual.
+ *
+ * \par Time complexity
+ *      \f$ \Order{|T1| \log |T1| + |T1| t_{rank} + |T2| t_{LF}} \f$ and
+ *      the time to construct res from its BWT and SA.
+ * \par Space complexity
+ *      About \f$ 4n \f$ bytes (\f$ 8n \f$ for \f$ n \geq 2^{31} \f$) for the
+ *      SA of b and \f$ n \lceil\log\sigma\rceil/8 \f$ bytes for the
+ *      bit-compressed text of b, i.e. \f$ 5n \f$ bytes in total for a byte
+ *      alphabet; \f$ 16|T1| \f$ bytes for the sorting step, and the CSAs.
+ */
+template<class t_csa>
+void merge_csa(t_csa& res, const t_csa& a, const t_csa& b, cache_config& config)
+{
+    static_assert(std::is_same<typename t_csa::index_category, csa_tag>::value, "merge_csa: index has to be a CSA");
+    if (a.size() <= 1 or b.size() == 0) {
+        res = b.size() > 0 ? b : a;
+        return;
+    }
+    {
+        auto event = memory_monitor::event("merge BWT and SA");
+        if (a.size()+b.size() < 0x7FFFFFFFULL) {
+            _merge_csa<uint32_t>(a, b, config);
+        } else {
+            _merge_csa<uint64_t>(a, b, config);
+        }
+    }
+    {
+        auto event = memory_monitor::event("construct CSA");
+        t_csa tmp(config);
+        res.swap(tmp);
+    }
+    if (config.delete_files) {
+        auto event = memory_monitor::event("delete temporary files");
+        util::delete_all_files(config.file_map);
+    }
+}
+
+} // end namespace sdsl
+
+#endif
@@ -31,6 +31,7 @@
 #include "qsufsort.hpp"
 
 #include "construct_sa_se.hpp"
+#include "construct_sa_par.hpp"
 #include "construct_config.hpp"
 
 namespace sdsl
@@ -141,6 +142,17 @@ void calculate_sa(const unsigned char* c, typename int_vector<fixedIntWidth>::si
  *  \par Reference
  *    For t_width=8: DivSufSort (http://code.google.com/p/libdivsufsort/)
  *    For t_width=0: qsufsort (http://www.larsson.dogma.net/qsufsort.c)
+ *
+ *  If construct_config::byte_algo_sa equals PAR_DOUBLING (t_width=8) or
+ *  construct_config::int_algo_sa equals PAR_DOUBLING_INT (t_width=0) the
+ *  multi-threaded prefix doubling algorithm of construct_sa_par.hpp is used
+ *  with config.threads threads. It needs \f$ 8n \f$ bytes for the SA and
+ *  the ranks of inputs smaller than 2GB and \f$ 16n \f$ bytes otherwise,
+ *  plus up to \f$ 12n \f$ (\f$ 24n \f$) bytes to sort the suffixes of
+ *  large groups, which occur in highly repetitive inputs. Groups which
+ *  exceed construct_config::memory_budget are sorted in place with
+ *  \f$ 2n \f$ (\f$ 4n \f$) bytes, see _construct_sa_par. It produces
+ *  the same file as the sequential algorithms.
  */
 template<uint8_t t_width>
 void construct_sa(cache_config& config)
@@ -158,7 +170,35 @@ void construct_sa(cache_config& config)
             store_to_cache(sa, conf::KEY_SA, config);
         } else if (construct_config::byte_algo_sa == SE_SAIS) {
             construct_sa_se(config);
+        } else if (construct_config::byte_algo_sa == PAR_DOUBLING) {
+            int_vector<8> text;
+            load_from_cache(text, KEY_TEXT, config);
+            int_vector<> sa(0, 0, bits::hi(text.size())+1);
+            construct_sa_par(text, sa, config.threads);
+            store_to_cache(sa, conf::KEY_SA, config);
+        }
+    } else if (t_width == 0 and construct_config::int_algo_sa == PAR_DOUBLING_INT) {
+        int_vector<> text;
+        load_from_cache(text, KEY_TEXT, config);
+        int_vector<> sa;
+        if (text.size() > 1) {
+            // use the same checks and output width as qsufsort
+            uint64_t n = text.size()-1, max_symbol = 0;
+            for (uint64_t i=0; i < n; ++i) {
+                if (0 == text[i]) {
+                    throw std::logic_error("Text contains 0-symbol. Suffix array can not be constructed.");
+                }
+                max_symbol = std::max(max_symbol, (uint64_t)text[i]);
+            }
+            if (text[n] > 0) {
+                throw std::logic_error("Last symbol is not 0-symbol. Suffix array can not be constructed.");
+            }
+            sa.width(std::max(bits::hi(max_symbol)+2, bits::hi(n+1)+2));
+            construct_sa_par(text, sa, config.threads);
+        } else {
+            sa = int_vector<>(text.size(), 0);
         }
+        store_to_cache(sa, conf::KEY_SA, config);
     } else if (t_width == 0) {
         // call qsufsort
         int_vector<> sa;
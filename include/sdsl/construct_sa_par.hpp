@@ -0,0 +1,317 @@
+/*! \file construct_sa_par.hpp
+    \brief construct_sa_par.hpp contains a multi-threaded suffix array construction
+           algorithm based on prefix doubling.
+*/
+#ifndef INCLUDED_SDSL_CONSTRUCT_SA_PAR
+#define INCLUDED_SDSL_CONSTRUCT_SA_PAR
+
+#include "int_vector.hpp"
+#include "construct_config.hpp"
+#include "parallel_helper.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Refines groups of the partially sorted suffix array `sa` by a sort key.
+/*!
+ * \tparam t_key_int Integer type of the sort keys.
+ * \param sa      Partially sorted suffix array.
+ * \param rank    Group number of each suffix. The group number of a suffix
+ *                is the position of the first element of its group in `sa`.
+ * \param groups  Unsorted groups as pairs (start, length). After the call
+ *                it contains the unsorted groups of the refined order.
+ * \param key     Functor which returns the sort key of a suffix.
+ * \param threads Number of threads.
+ *
+ * Each group is sorted independently by `key`. The keys are materialized
+ * before sorting, so `key` may read `rank`, which is only updated in a
+ * second phase after all groups are sorted. If the keys of a group and
+ * the merge buffer exceed construct_config::memory_budget, the group is
+ * sorted in place and the keys are calculated in each comparison.
+ */
+template<class t_key_int, class t_int, class t_key>
+void _refine_sa_groups(t_int* sa, t_int* rank, std::vector<std::pair<t_int,t_int>>& groups,
+                       t_key key, uint64_t threads)
+{
+    typedef std::pair<t_key_int, t_int>         key_type;
+    typedef std::vector<std::pair<t_int,t_int>> group_list;
+    // marks a run of sorted groups of length 1 in the subgroup lists
+    const t_int run_mark = ((t_int)1) << (sizeof(t_int)*8-1);
+
+    uint64_t total = 0;
+    for (auto& g : groups) {
+        total += g.second;
+    }
+    // groups larger than a fair share of work are sorted by all threads
+    std::vector<std::pair<t_int,t_int>> big;
+    if (threads > 1) {
+        size_t j = 0;
+        for (size_t i=0; i < groups.size(); ++i) {
+            if (groups[i].second * threads > total) {
+                big.push_back(groups[i]);
+            } else {
+                groups[j++] = groups[i];
+            }
+        }
+        groups.resize(j);
+    }
+
+    std::vector<std::vector<key_type>> buf(threads);
+    std::vector<group_list> sub(threads);
+
+    auto sort_group = [&](t_int start, t_int len, std::vector<key_type>& b, group_list& out, uint64_t thr) {
+        if (len == 1) {
+            if (!out.empty() and (out.back().second & run_mark)
+                and out.back().first + (out.back().second & ~run_mark) == start) {
+                ++out.back().second;
+            } else {
+                out.emplace_back(start, 1 | run_mark);
+            }
+            return;
+        }
+        const bool in_place = (uint64_t)len*sizeof(key_type)*3/2 > construct_config::memory_budget;
+        if (in_place) {
+            parallel_sort(sa+start, sa+start+len, [&](t_int x, t_int y) {
+                return (t_key_int)key(x) < (t_key_int)key(y);
+            }, thr);
+        } else {
+            b.resize(len);
+            parallel_for(len, thr, [&](uint64_t j, uint64_t) {
+                t_int x = sa[start+j];
+                b[j] = key_type(key(x), x);
+            }, 1<<16);
+            parallel_sort(b.begin(), b.end(), [](const key_type& x, const key_type& y) {
+                return x.first < y.first;
+            }, thr);
+            parallel_for(len, thr, [&](uint64_t j, uint64_t) {
+                sa[start+j] = b[j].second;
+            }, 1<<16);
+        }
+        auto key_at = [&](t_int j) -> t_key_int {
+            return in_place ? (t_key_int)key(sa[start+j]) : b[j].first;
+        };
+        t_int s = 0;
+        t_key_int key_s = key_at(0);
+        for (t_int j=1; j <= len; ++j) {
+            if (j == len or key_at(j) != key_s) {
+                if (j-s > 1) {
+                    out.emplace_back(start+s, j-s);
+                } else if (!out.empty() and (out.back().second & run_mark)
+                           and out.back().first + (out.back().second & ~run_mark) == start+s) {
+                    ++out.back().second;
+                } else {
+                    out.emplace_back(start+s, 1 | run_mark);
+                }
+                s = j;
+                if (j < len) {
+                    key_s = key_at(j);
+                }
+            }
+        }
+    };
+
+    // Phase 1: sort each group. rank is only read.
+    for (auto& g : big) {
+        sort_group(g.first, g.second, buf[0], sub[0], threads);
+        std::vector<key_type>().swap(buf[0]);
+    }
+    parallel_for(groups.size(), threads, [&](uint64_t i, uint64_t t) {
+        sort_group(groups[i].first, groups[i].second, buf[t], sub[t], 1);
+    }, 64);
+    std::vector<std::vector<key_type>>().swap(buf);
+    group_list().swap(groups);
+
+    // Phase 2: assign new group numbers and collect the unsorted groups
+    std::vector<group_list> next(threads);
+    for (uint64_t t=0; t < sub.size(); ++t) {
+        parallel_for(sub[t].size(), threads, [&](uint64_t i, uint64_t tt) {
+            t_int start = sub[t][i].first;
+            t_int len   = sub[t][i].second;
+            if (len & run_mark) {
+                len &= ~run_mark;
+                for (t_int j=start; j < start+len; ++j) {
+                    rank[sa[j]] = j;
+                }
+            } else {
+                for (t_int j=start; j < start+len; ++j) {
+                    rank[sa[j]] = start;
+                }
+                next[tt].emplace_back(start, len);
+            }
+        }, 1024);
+        group_list().swap(sub[t]);
+    }
+    for (auto& l : next) {
+        groups.insert(groups.end(), l.begin(), l.end());
+        group_list().swap(l);
+    }
+}
+
+//! Calculates the suffix array of text[0..n-1] with `threads` threads.
+/*!
+ * \tparam t_int  Integer type of the suffix array entries. Its highest bit
+ *                is used as a marker, i.e. n < 2^(8*sizeof(t_int)-1).
+ * \param text    Random access container over an integer alphabet.
+ * \param n       Length of the text.
+ * \param sa      Array of length n which will contain the suffix array.
+ * \param threads Number of threads.
+ *
+ * The algorithm first packs as many symbols as fit into 16 bits plus a
+ * t_int (at most 64 bits) into the initial sort key, distributes the
+ * suffixes into 2^16 buckets by the highest 16 bits of the key
+ * and then refines the order by prefix doubling. All groups of one doubling
+ * step are sorted concurrently and large groups are sorted with a
+ * parallel merge sort. A shorter suffix is smaller than a longer suffix it
+ * is a prefix of, i.e. the result equals the one of divsufsort and qsufsort.
+ *
+ * \par Space complexity
+ *     \f$ 2n \f$ words of type t_int for sa and the ranks, plus two words
+ *     (a key and a suffix) for each element of the groups which are sorted
+ *     at the same time, plus the merge buffer of up to one word per element
+ *     of a group which is sorted by several threads. The groups of
+ *     random texts are small, but in a highly repetitive text the first
+ *     group contains almost all suffixes, so up to three words per symbol
+ *     are needed on top of sa and the ranks. Groups whose keys exceed
+ *     construct_config::memory_budget are sorted in place, which needs
+ *     only the merge buffer of half a word per element, but is slower.
+ */
+template<class t_int, class t_text>
+void _construct_sa_par(const t_text& text, uint64_t n, t_int* sa, uint64_t threads)
+{
+    if (threads == 0) {
+        threads = 1;
+    }
+    if (n <= 1) {
+        if (n == 1) {
+            sa[0] = 0;
+        }
+        return;
+    }
+    std::vector<uint64_t> max_symbols(threads, 0);
+    const uint64_t chunk = (n+threads-1)/threads;
+    parallel_for(threads, threads, [&](uint64_t c, uint64_t) {
+        for (uint64_t i=c*chunk; i < std::min(n, (c+1)*chunk); ++i) {
+            max_symbols[c] = std::max(max_symbols[c], (uint64_t)text[i]);
+        }
+    });
+    uint64_t max_symbol = *std::max_element(max_symbols.begin(), max_symbols.end());
+
+    // Determine the number of symbols k packed into an initial key. Symbol
+    // c is stored as c+1 in sym_width bits, 0 marks the end of the text.
+    // The key bits below the bucket fit into a t_int if possible.
+    uint64_t sym_width = (max_symbol >= (1ULL<<62)) ? 64 : bits::hi(max_symbol+1)+1;
+    uint64_t k = std::min((uint64_t)64, 16+8*sizeof(t_int))/sym_width;
+    uint64_t key_width = (k >= 2) ? k*sym_width : bits::hi(max_symbol)+1;
+    if (k < 2) {
+        k = 1;
+    }
+    auto initial_key = [&](uint64_t i) -> uint64_t {
+        if (k == 1) {
+            return text[i];
+        }
+        uint64_t x = 0;
+        for (uint64_t j=0; j < k; ++j) {
+            x = (x << sym_width) | (i+j < n ? (uint64_t)text[i+j]+1 : 0);
+        }
+        return x;
+    };
+
+    // Bucket sort by the most significant bits of the initial key
+    const uint64_t bucket_width = std::min((uint64_t)16, key_width);
+    const uint64_t buckets = 1ULL << bucket_width;
+    const uint64_t shift = key_width - bucket_width;
+    std::vector<std::vector<uint64_t>> cnt(threads);
+    parallel_for(threads, threads, [&](uint64_t c, uint64_t) {
+        cnt[c].assign(buckets, 0);
+        for (uint64_t i=c*chunk; i < std::min(n, (c+1)*chunk); ++i) {
+            ++cnt[c][initial_key(i) >> shift];
+        }
+    });
+    std::vector<std::pair<t_int,t_int>> groups;
+    uint64_t sum = 0;
+    for (uint64_t b=0; b < buckets; ++b) {
+        uint64_t start = sum;
+        for (uint64_t c=0; c < threads; ++c) {
+            uint64_t tmp = cnt[c][b];
+            cnt[c][b] = sum;
+            sum += tmp;
+        }
+        if (sum > start) {
+            groups.emplace_back(start, sum-start);
+        }
+    }
+    parallel_for(threads, threads, [&](uint64_t c, uint64_t) {
+        for (uint64_t i=c*chunk; i < std::min(n, (c+1)*chunk); ++i) {
+            sa[cnt[c][initial_key(i) >> shift]++] = i;
+        }
+    });
+    std::vector<std::vector<uint64_t>>().swap(cnt);
+
+    std::vector<t_int> rank(n);
+    // the suffixes of a group share the bucket, i.e. the key bits above `shift`
+    if (shift <= 8*sizeof(t_int)) {
+        const uint64_t mask = bits::lo_set[shift];
+        _refine_sa_groups<t_int>(sa, rank.data(), groups, [&](uint64_t i) -> t_int {
+            return initial_key(i) & mask;
+        }, threads);
+    } else {
+        _refine_sa_groups<uint64_t>(sa, rank.data(), groups, initial_key, threads);
+    }
+
+    // Prefix doubling: suffixes in one group share their first h symbols
+    for (uint64_t h = k; !groups.empty(); h *= 2) {
+        const t_int* r = rank.data();
+        _refine_sa_groups<t_int>(sa, rank.data(), groups, [r, h, n](uint64_t i) -> t_int {
+            return i+h < n ? r[i+h]+1 : 0;
+        }, threads);
+    }
+}
+
+//! Calculates the suffix array of a text with `threads` threads.
+/*!
+ * \param text    Random access container over an integer alphabet.
+ * \param sa      Reference to an int_vector<> which will contain the result.
+ *                The width of sa is not changed.
+ * \param threads Number of threads.
+ * \sa _construct_sa_par
+ */
+template<class t_text>
+void construct_sa_par(const t_text& text, int_vector<>& sa, uint64_t threads)
+{
+    typedef int_vector<>::size_type size_type;
+    const size_type n = text.size();
+    if (n <= 1) { // handle special case as in algorithm::calculate_sa
+        sa = int_vector<>(n, 0);
+        return;
+    }
+    const uint8_t old_width = sa.width();
+    if (old_width < bits::hi(n-1)+1) {
+        throw std::logic_error("width of int_vector is to small for the text!!!");
+    }
+    // the most significant bit of a suffix array entry is used as marker
+    if (n < 0x7FFFFFFFULL and old_width <= 32) {
+        sa.width(32);
+        sa.resize(n);
+        _construct_sa_par(text, n, (uint32_t*)sa.data(), threads);
+        for (size_type i=0; i<n and old_width!=32; ++i) {
+            sa.set_int(i*old_width, sa.get_int(i<<5, 32), old_width);
+        }
+    } else {
+        sa.width(64);
+        sa.resize(n);
+        _construct_sa_par(text, n, (uint64_t*)sa.data(), threads);
+        for (size_type i=0; i<n and old_width!=64; ++i) {
+            sa.set_int(i*old_width, sa.get_int(i<<6, 64), old_width);
+        }
+    }
+    sa.width(old_width);
+    sa.resize(n);
+}
+
+} // end namespace sdsl
+
+#endif
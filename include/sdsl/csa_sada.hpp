@@ -47,6 +47,9 @@ namespace sdsl
   *  \tparam t_isa             Vector type for ISA sample values.
   *  \tparam t_alphabet_strat  Policy for alphabet representation.
   *
+  *  The const methods do not modify the object and may be called by
+  *  several threads concurrently; sdsl::query_context holds per-thread caches.
+  *
   *  \sa sdsl::csa_wt, sdsl::csa_bitcompressed
   * @ingroup csa
  */
@@ -110,14 +113,17 @@ class csa_sada
         friend class traverse_csa_psi<csa_sada,true>;
         friend class traverse_csa_psi<csa_sada,false>;
 
-        static const uint32_t linear_decode_limit = 100000;
+        static const uint32_t linear_decode_limit = 4096;
     private:
         enc_vector_type m_psi;        // psi function
         sa_sample_type  m_sa_sample;  // suffix array samples
         isa_sample_type m_isa_sample; // inverse suffix array samples
         alphabet_type   m_alphabet;   // alphabet component
 
-        mutable std::vector<uint64_t> m_psi_buf; // buffer for decoded psi values
+        // size of the stack buffer for decoded psi values in rank_bwt
+        enum { psi_buf_size = enc_vector_type::sample_dens < linear_decode_limit ?
+                              enc_vector_type::sample_dens+1 : 1
+             };
 
         void copy(const csa_sada& csa)
         {
@@ -128,13 +134,6 @@ class csa_sada
             m_alphabet   = csa.m_alphabet;
         };
 
-        void create_buffer()
-        {
-            if (enc_vector_type::sample_dens < linear_decode_limit) {
-                m_psi_buf = std::vector<uint64_t>(enc_vector_type::sample_dens+1);
-            }
-        }
-
     public:
         const typename alphabet_type::char2comp_type& char2comp  = m_alphabet.char2comp;
         const typename alphabet_type::comp2char_type& comp2char  = m_alphabet.comp2char;
@@ -152,17 +151,13 @@ class csa_sada
 
 
         //! Default Constructor
-        csa_sada()
-        {
-            create_buffer();
-        }
+        csa_sada() { }
         //! Default Destructor
         ~csa_sada() { }
 
         //! Copy constructor
         csa_sada(const csa_sada& csa)
         {
-            create_buffer();
             copy(csa);
         }
 
@@ -264,7 +259,6 @@ class csa_sada
                 m_sa_sample  = std::move(csa.m_sa_sample);
                 m_isa_sample = std::move(csa.m_isa_sample);
                 m_alphabet   = std::move(csa.m_alphabet);
-                m_psi_buf    = std::move(csa.m_psi_buf);
             }
             return *this;
         }
@@ -323,24 +317,25 @@ class csa_sada
 // TODO: don't use get_inter_sampled_values if t_dens is really
 //       large
                 lower_b = lower_sb*sd;
-                if (0 == m_psi_buf.size()) {
+                if (enc_vector_type::sample_dens >= linear_decode_limit) {
                     upper_b = std::min(upper_sb*sd, C[cc+1]);
                     goto finish;
                 }
-                uint64_t* p = m_psi_buf.data();
+                // the buffer is local, so concurrent queries do not interfere
+                uint64_t psi_buf[psi_buf_size];
+                uint64_t* p = psi_buf;
                 // extract the psi values between two samples
                 m_psi.get_inter_sampled_values(lower_sb, p);
-                p = m_psi_buf.data();
                 uint64_t smpl = m_psi.sample(lower_sb);
                 // handle border cases
                 if (lower_b + m_psi.get_sample_dens() >= C[cc+1])
-                    m_psi_buf[ C[cc+1]-lower_b ] = size()-smpl;
+                    psi_buf[ C[cc+1]-lower_b ] = size()-smpl;
                 else
-                    m_psi_buf[ m_psi.get_sample_dens() ] = size()-smpl;
+                    psi_buf[ m_psi.get_sample_dens() ] = size()-smpl;
                 // search the result linear
                 while ((*p++)+smpl < i);
 
-                return p-1-m_psi_buf.data() + lower_b - C[cc];
+                return p-1-psi_buf + lower_b - C[cc];
             } else { // lower_b == (m_C[cc]+sd-1)/sd and lower_sb < upper_sb
                 if (m_psi.sample(lower_sb) >= i) {
                     lower_b = C[cc];
@@ -394,7 +389,6 @@ finish:
 template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
 csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::csa_sada(cache_config& config)
 {
-    create_buffer();
     if (!cache_file_exists(key_trait<alphabet_type::int_width>::KEY_BWT, config)) {
         return;
     }
@@ -490,5 +484,29 @@ void csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabe
     }
 }
 
+//! Performs one step of the Psi walk which calculates an SA value, see csa_sada::operator[].
+/*!
+ * \param csa The CSA.
+ * \param i   Current position of the walk in the SA.
+ * \param off Number of Psi steps done so far.
+ * \param res If i is sampled, res will contain the SA value of the start position.
+ * \return True if the walk is finished.
+ *
+ * Used by locate_par to interleave the walks of several SA positions.
+ */
+template<class t_enc_vec, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+inline bool _sa_walk_step(const csa_sada<t_enc_vec, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa,
+                          int_vector<>::size_type& i, int_vector<>::size_type& off, int_vector<>::size_type& res)
+{
+    if (csa.sa_sample.is_sampled(i)) {
+        res = csa.sa_sample[i];
+        res = (res < off) ? csa.size()-(off-res) : res-off;
+        return true;
+    }
+    i = csa.psi[i];
+    ++off;
+    return false;
+}
+
 } // end namespace sdsl
 #endif
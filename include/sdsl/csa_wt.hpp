@@ -25,7 +25,6 @@
 #include "suffix_array_helper.hpp"
 #include "iterators.hpp"
 #include "util.hpp"
-#include "fast_cache.hpp"
 #include "csa_sampling_strategy.hpp"
 #include "csa_alphabet_strategy.hpp"
 #include <iostream>
@@ -54,6 +53,9 @@ class bwt_of_csa_wt;   // forward declaration of BWT-array class
   *  \tparam t_isa             Vector type for ISA sample values.
   *  \tparam t_alphabet_strat  Policy for alphabet representation.
   *
+  *  The const methods do not modify the object and may be called by
+  *  several threads concurrently; sdsl::query_context holds per-thread caches.
+  *
   *  \sa sdsl::csa_sada, sdsl::csa_bitcompressed
   * @ingroup csa
  */
@@ -121,10 +123,6 @@ class csa_wt
         sa_sample_type  m_sa_sample;    // suffix array samples
         isa_sample_type m_isa_sample;   // inverse suffix array samples
         alphabet_type   m_alphabet;
-//#define USE_CSA_CACHE
-#ifdef USE_CSA_CACHE
-        mutable fast_cache csa_cache;
-#endif
 
         void copy(const csa_wt& csa)
         {
@@ -315,8 +313,7 @@ csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>::cs
         auto event = memory_monitor::event("construct wavelet tree");
         int_vector_buffer<alphabet_type::int_width> bwt_buf(cache_file_name(key_trait<alphabet_type::int_width>::KEY_BWT,config));
         size_type n = bwt_buf.size();
-        wavelet_tree_type tmp_wt(bwt_buf, n);
-        m_wavelet_tree.swap(tmp_wt);
+        construct_wt(m_wavelet_tree, bwt_buf, n, config.threads);
     }
     {
         auto event = memory_monitor::event("sample SA");
@@ -403,5 +400,32 @@ void csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat
     }
 }
 
+//! Performs one step of the LF walk which calculates an SA value, see csa_wt::operator[].
+/*!
+ * \param csa The CSA.
+ * \param i   Current position of the walk in the SA.
+ * \param off Number of LF steps done so far.
+ * \param res If i is sampled, res will contain the SA value of the start position.
+ * \return True if the walk is finished.
+ *
+ * Used by locate_par to interleave the walks of several SA positions.
+ */
+template<class t_wt, uint32_t t_dens, uint32_t t_inv_dens, class t_sa_sample_strat, class t_isa, class t_alphabet_strat>
+inline bool _sa_walk_step(const csa_wt<t_wt, t_dens, t_inv_dens, t_sa_sample_strat, t_isa, t_alphabet_strat>& csa,
+                          int_vector<>::size_type& i, int_vector<>::size_type& off, int_vector<>::size_type& res)
+{
+    if (csa.sa_sample.is_sampled(i)) {
+        res = csa.sa_sample[i] + off;
+        if (res >= csa.size()) {
+            res -= csa.size();
+        }
+        return true;
+    }
+    i = csa.lf[i];
+    ++off;
+    _prefetch(csa.wavelet_tree, i, 0);
+    return false;
+}
+
 } // end namespace sdsl
 #endif
@@ -238,11 +238,29 @@ class cst_fully
             return const_iterator(this, root(), false, true);
         }
 
+        //! Returns a const_iterator to the first element of a depth first traversal of the subtree rooted at node v.
+        const_iterator begin(const node_type& v) const
+        {
+            if (m_b.size() == 0 and root() == v) {
+                return end();
+            }
+            return const_iterator(this, v, false, true);
+        }
+
         const_iterator end() const
         {
             return const_iterator(this, root(), true, false);
         }
 
+        //! Returns a const_iterator to the element past the end of a depth first traversal of the subtree rooted at node v.
+        const_iterator end(const node_type& v) const
+        {
+            if (root() == v) {
+                return end();
+            }
+            return ++const_iterator(this, v, true, true);
+        }
+
 //! Copy Assignment Operator.
         cst_fully& operator=(const cst_fully& cst)
         {
@@ -634,7 +652,9 @@ class cst_fully
         {
             size_type l, r;
             std::tie(l, r) = v;
-            backward_search(m_csa, l, r, c, l, r);
+            if (backward_search(m_csa, l, r, c, l, r) == 0) {
+                return root();
+            }
             return node_type(l, r);
         }
 
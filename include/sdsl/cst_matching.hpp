@@ -0,0 +1,333 @@
+/*! \file cst_matching.hpp
+    \brief cst_matching.hpp contains a streaming engine for matching statistics on a CST.
+*/
+#ifndef INCLUDED_SDSL_CST_MATCHING
+#define INCLUDED_SDSL_CST_MATCHING
+
+#include "int_vector.hpp"
+#include "suffix_tree_helper.hpp"
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace sdsl
+{
+
+//! Streaming computation of the matching statistics of a sequence S against the text of a CST.
+/*! The matching statistic MS[i] is the length of the longest prefix of
+ *  S[i..] which occurs in the text. The characters of S are pushed one
+ *  after the other; MS[i] is reported as soon as the match starting at i
+ *  can not be extended, i.e. S is never stored completely.
+ *
+ *  The engine keeps the locus of the current match and moves it with
+ *  child(v,c) while the match is extended and with sl(parent(v)) and a
+ *  skip/count descent when the first character is dropped. The depths of
+ *  the current node and its parent, the children of the root, and the
+ *  suffix links of recently used inner nodes are cached. The memory is
+ *  proportional to the length of the current match; if S is short (e.g.
+ *  a read) sdsl::matching_statistics is faster.
+ *
+ *  \tparam t_cst Type of the CST.
+ *  \par Example
+ *  \code
+ *  ms_stream<cst_sct3<>> ms(cst);
+ *  for (char c; in.get(c);)
+ *      ms.push(c, [&](uint64_t l) { out << l << "\n"; });
+ *  ms.finish([&](uint64_t l) { out << l << "\n"; });
+ *  \endcode
+ *
+ *  An object must not be used by several threads at the same time, but
+ *  any number of objects can share the same CST.
+ */
+template<class t_cst>
+class ms_stream
+{
+    public:
+        typedef typename t_cst::size_type size_type;
+        typedef typename t_cst::node_type node_type;
+        typedef typename t_cst::char_type char_type;
+
+    private:
+        struct sl_entry {
+            size_type lb = (size_type)-1;
+            size_type rb = 0;
+            node_type sl;
+        };
+        const t_cst*           m_cst;
+        std::deque<char_type>  m_buf;              // current match S[i..i+d)
+        node_type              m_v;                // locus of the match
+        size_type              m_v_depth    = 0;   // depth of m_v
+        node_type              m_p;                // parent of m_v, if m_p_valid
+        size_type              m_p_depth    = 0;
+        bool                   m_p_valid    = false;
+        size_type              m_char_pos   = 0;   // ISA[SA[lb(m_v)]+d-1], if m_cp_valid
+        bool                   m_cp_valid   = false;
+        size_type              m_pos        = 0;   // number of reported positions
+        std::vector<node_type> m_root_child;       // child(root, c) for each comp. character
+        std::vector<size_type> m_root_child_depth;
+        std::vector<sl_entry>  m_sl_cache;
+
+        // depth of a node; a match never reaches the end of a leaf's edge, so
+        // the depth of a leaf, which costs a SA access, is not calculated
+        size_type _depth(const node_type& w) const
+        {
+            return m_cst->is_leaf(w) ? (size_type)-1 : m_cst->depth(w);
+        }
+
+        // child of node u at depth du with character c and comp. character cc
+        node_type _child(const node_type& u, size_type du, char_type c, size_type cc, size_type& dw) const
+        {
+            if (du == 0) {
+                dw = m_root_child_depth[cc];
+                return m_root_child[cc];
+            }
+            node_type w = m_cst->child(u, c);
+            dw = _depth(w);
+            return w;
+        }
+
+        // suffix link of an inner node u != root
+        node_type _sl(const node_type& u)
+        {
+            size_type lb = m_cst->lb(u), rb = m_cst->rb(u);
+            sl_entry& e = m_sl_cache[((lb*0x9E3779B97F4A7C15ULL)^rb) & (m_sl_cache.size()-1)];
+            if (e.lb != lb or e.rb != rb) {
+                e.lb = lb;
+                e.rb = rb;
+                e.sl = m_cst->sl(u);
+            }
+            return e.sl;
+        }
+
+        // tries to extend the match by c; cc is the comp. character of c
+        bool _extend(char_type c, size_type cc)
+        {
+            size_type d = m_buf.size();
+            if (d < m_v_depth) { // in an edge
+                const auto& csa = m_cst->csa;
+                size_type cp = m_cp_valid ? csa.psi[m_char_pos] : get_char_pos(m_cst->lb(m_v), d, csa);
+                if (cp < csa.C[cc] or cp >= csa.C[cc+1])
+                    return false;
+                m_char_pos = cp;
+                m_cp_valid = true;
+            } else {             // at a node
+                size_type dw = 0;
+                node_type w = _child(m_v, m_v_depth, c, cc, dw);
+                if (w == m_cst->root())
+                    return false;
+                m_p = m_v;
+                m_p_depth = m_v_depth;
+                m_p_valid = true;
+                m_v = w;
+                m_v_depth = dw;
+                m_cp_valid = false;
+            }
+            m_buf.push_back(c);
+            return true;
+        }
+
+        // drops the first character of the non-empty match
+        void _shorten()
+        {
+            size_type d = m_buf.size()-1;
+            m_buf.pop_front();
+            m_cp_valid = false;
+            if (d == 0) {
+                _to_root();
+            } else if (d+1 == m_v_depth) { // the match ends at an inner node
+                m_v = _sl(m_v);
+                m_v_depth = d;
+                m_p_valid = false;
+            } else {
+                if (!m_p_valid) {
+                    m_p = m_cst->parent(m_v);
+                    m_p_depth = m_cst->depth(m_p);
+                }
+                node_type u = m_cst->root();
+                size_type du = 0;
+                if (m_p_depth > 0) {
+                    u  = _sl(m_p);
+                    du = m_p_depth-1;
+                }
+                // skip/count descent; at least one step as du < d
+                const auto& csa = m_cst->csa;
+                while (du < d) {
+                    char_type c = m_buf[du];
+                    size_type dw = 0;
+                    node_type w = _child(u, du, c, csa.char2comp[c], dw);
+                    m_p = u;
+                    m_p_depth = du;
+                    u = w;
+                    du = dw;
+                }
+                m_v = u;
+                m_v_depth = du;
+                m_p_valid = true;
+            }
+        }
+
+        void _to_root()
+        {
+            m_v = m_cst->root();
+            m_v_depth = 0;
+            m_p_valid = false;
+            m_cp_valid = false;
+        }
+
+    public:
+        //! Constructor
+        /*! \param cst      The CST; it has to outlive the object.
+         *  \param sl_cache Minimal number of cached suffix links.
+         */
+        explicit ms_stream(const t_cst& cst, size_type sl_cache=1024) : m_cst(&cst)
+        {
+            const auto& csa = cst.csa;
+            m_root_child.resize(csa.sigma, cst.root());
+            m_root_child_depth.resize(csa.sigma, 0);
+            for (size_type cc=1; cc < csa.sigma; ++cc) {
+                m_root_child[cc] = cst.child(cst.root(), csa.comp2char[cc]);
+                m_root_child_depth[cc] = _depth(m_root_child[cc]);
+            }
+            size_type n = 1;
+            while (n < sl_cache)
+                n <<= 1;
+            m_sl_cache.resize(n);
+            _to_root();
+        }
+
+        //! Appends character c to S and calls out(MS[i]) for each position i which is finished.
+        template<class t_out>
+        void push(char_type c, t_out out)
+        {
+            size_type cc = m_cst->csa.char2comp[c];
+            if (cc == 0) { // c does not occur in the text
+                finish(out);
+                out(0);
+                ++m_pos;
+                return;
+            }
+            while (!_extend(c, cc)) {
+                if (m_buf.empty()) {
+                    out(0);
+                    ++m_pos;
+                    return;
+                }
+                out(m_buf.size());
+                ++m_pos;
+                _shorten();
+            }
+        }
+
+        //! Appends the characters of [begin, end) to S.
+        template<class t_iter, class t_out>
+        void push(t_iter begin, t_iter end, t_out out)
+        {
+            for (; begin != end; ++begin)
+                push(*begin, out);
+        }
+
+        //! Ends S: reports the remaining positions and starts a new sequence.
+        template<class t_out>
+        void finish(t_out out)
+        {
+            for (size_type d = m_buf.size(); d > 0; --d) {
+                out(d);
+                ++m_pos;
+            }
+            m_buf.clear();
+            _to_root();
+        }
+
+        //! Number of positions reported so far.
+        size_type position() const { return m_pos; }
+
+        //! Length of the current match, i.e. the number of pending positions.
+        size_type pending() const { return m_buf.size(); }
+
+        //! The locus of the current match.
+        /*! The match ends on the edge to this node, or at it.
+         */
+        const node_type& node() const { return m_v; }
+};
+
+//! Calculates the matching statistics of a pattern against the text of a CST.
+/*!
+ * \param cst   The CST.
+ * \param begin Iterator to the begin of the pattern (inclusive).
+ * \param end   Iterator to the end of the pattern (exclusive).
+ * \return MS, where MS[i] is the length of the longest prefix of pat[i..] occurring in the text.
+ * \par Time complexity
+ *      \f$ \Order{ m \cdot (t_{wl} + t_{parent} + t_{depth}) } \f$ amortized,
+ *      where m is the length of the pattern.
+ *
+ * The pattern is processed from right to left: the match is extended by
+ * Weiner links and shortened by parent(v). In contrast to sdsl::ms_stream,
+ * this needs no SA accesses and is therefore much faster, but the pattern
+ * has to be known completely, e.g. a read of a read file.
+ */
+template<class t_cst, class t_pat_iter>
+int_vector<64>
+matching_statistics(const t_cst& cst, t_pat_iter begin, t_pat_iter end)
+{
+    typedef typename t_cst::size_type size_type;
+    typedef typename t_cst::node_type node_type;
+    int_vector<64> ms(std::distance(begin, end));
+    const auto& csa = cst.csa;
+    // the Weiner links of the root are the children of the root
+    std::vector<node_type> root_wl(csa.sigma, cst.root());
+    for (size_type cc=1; cc < csa.sigma; ++cc)
+        root_wl[cc] = cst.child(cst.root(), csa.comp2char[cc]);
+    node_type v = cst.root();
+    size_type d = 0; // length of the match; locus v
+    for (size_type i = ms.size(); i > 0; --i) {
+        auto c  = *(begin + (i-1));
+        auto cc = csa.char2comp[c];
+        if (cc == 0) { // c does not occur in the text
+            v = cst.root();
+            d = 0;
+        } else {
+            while (true) {
+                if (d == 0) {
+                    v = root_wl[cc];
+                    break;
+                }
+                node_type w = cst.wl(v, c);
+                if (w != cst.root()) {
+                    v = w;
+                    break;
+                }
+                v = cst.parent(v);
+                d = (v == cst.root()) ? 0 : cst.depth(v);
+            }
+            ++d;
+        }
+        ms[i-1] = d;
+    }
+    return ms;
+}
+
+//! Calculates a longest common substring of a pattern and the text of a CST.
+/*!
+ * \param cst   The CST.
+ * \param begin Iterator to the begin of the pattern (inclusive).
+ * \param end   Iterator to the end of the pattern (exclusive).
+ * \return A pair (i, l) such that pat[i..i+l) is the leftmost longest
+ *         substring of the pattern which occurs in the text.
+ */
+template<class t_cst, class t_pat_iter>
+std::pair<typename t_cst::size_type, typename t_cst::size_type>
+longest_common_substring(const t_cst& cst, t_pat_iter begin, t_pat_iter end)
+{
+    typedef typename t_cst::size_type size_type;
+    std::pair<size_type, size_type> res(0, 0);
+    auto ms = matching_statistics(cst, begin, end);
+    for (size_type i=0; i < ms.size(); ++i) {
+        if (ms[i] > res.second)
+            res = {i, ms[i]};
+    }
+    return res;
+}
+
+} // end namespace sdsl
+
+#endif
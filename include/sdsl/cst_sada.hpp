@@ -183,7 +183,7 @@ class cst_sada
             }
             {
                 auto event = memory_monitor::event("clcp");
-                cache_config tmp_config(false, config.dir, config.id, config.file_map);
+                cache_config tmp_config(false, config.dir, config.id, config.file_map, config.threads);
                 construct_lcp(m_lcp, *this, tmp_config);
                 config.file_map = tmp_config.file_map;
             }
@@ -83,6 +83,11 @@ struct bp_interval;
  * application in sequence analysis. 17 applications are in the book
  * "Algorithms on Strings, Trees, and Sequences" of Dan Gusfield.
  *
+ * \par Thread safety
+ * The const methods do not modify the tree and may be called by several
+ * threads concurrently, so one loaded CST can serve many workers.
+ * sdsl::query_context holds per-thread caches of SA and LCP values.
+ *
  * @ingroup cst
  */
 template<class t_csa = csa_wt<>,
@@ -1162,7 +1167,7 @@ cst_sct3<t_csa, t_lcp, t_bp_support, t_bv, t_rank, t_sel>::cst_sct3(cache_config
     }
     if (!build_only_bps) {
         auto event = memory_monitor::event("clcp");
-        cache_config tmp_config(false, config.dir, config.id, config.file_map);
+        cache_config tmp_config(false, config.dir, config.id, config.file_map, config.threads);
         construct_lcp(m_lcp, *this, tmp_config);
         config.file_map = tmp_config.file_map;
     }
@@ -1,37 +1,262 @@
-
+/*! \file fast_cache.hpp
+    \brief fast_cache.hpp contains caches for the answers of expensive queries.
+*/
 #ifndef INCLUDED_SDSL_FAST_CACHE
 #define INCLUDED_SDSL_FAST_CACHE
 
 #include "int_vector.hpp"
+#include "parallel_helper.hpp"
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace sdsl
 {
 
 #define CACHE_SIZE 0x3FFULL
 
-struct fast_cache {
-    typedef int_vector<>::size_type size_type;
-    size_type m_table[2*(CACHE_SIZE+1)];
-    // Constructor
-    fast_cache() {
-        for (size_type i=0; i < (CACHE_SIZE+1); ++i) {
-            m_table[i<<1] = (size_type)-1;
-        }
-    }
-    // Returns true if the request i is cached and
-    // x is set to the answer of request i
-    bool exists(size_type i, size_type& x) {
-        if (m_table[(i&CACHE_SIZE)<<1 ] == i) {
-            x = m_table[((i&CACHE_SIZE)<<1) + 1 ];
-            return true;
-        } else
+//! A set associative cache which maps integer requests to integer answers.
+/*! The cache consists of a power of two number of sets with t_ways entries
+ *  each. Request i is stored in set i mod #sets. A full set replaces its
+ *  entries in CLOCK order: each entry has a reference bit, which is set by
+ *  a hit, and the hand of the set skips (and clears) referenced entries. A
+ *  new entry starts unreferenced, so entries which are requested only once
+ *  are replaced before the hot ones.
+ *
+ *  \tparam t_ways Number of entries per set in [1..16]. t_ways=1 results in
+ *                 a direct mapped cache.
+ *
+ *  The request (size_type)-1 can not be cached. The object is not thread-safe;
+ *  use one object per thread or a sdsl::sharded_cache.
+ */
+template<uint8_t t_ways = 4>
+class assoc_cache
+{
+        static_assert(t_ways > 0 and t_ways <= 16, "assoc_cache: t_ways has to be in [1..16]");
+    public:
+        typedef int_vector<>::size_type size_type;
+        enum { ways = t_ways };
+
+    private:
+        struct entry {
+            size_type key   = (size_type)-1;
+            size_type value = 0;
+        };
+        std::vector<entry>    m_entries; // set s occupies [s*t_ways..(s+1)*t_ways)
+        std::vector<uint32_t> m_clock;   // per set: reference bits [0..15], hand [16..23]
+        size_type             m_mask   = 0;
+        size_type             m_hits   = 0;
+        size_type             m_misses = 0;
+
+    public:
+        //! Constructor
+        /*! \param capacity Minimal number of entries. It is rounded up
+         *                  to the next power of two times t_ways.
+         */
+        explicit assoc_cache(size_type capacity = CACHE_SIZE+1)
+        {
+            size_type sets = 1;
+            while (sets*t_ways < capacity)
+                sets <<= 1;
+            m_entries = std::vector<entry>(sets*t_ways);
+            m_clock   = std::vector<uint32_t>(sets, 0);
+            m_mask    = sets-1;
+        }
+
+        //! Number of entries.
+        size_type capacity() const { return m_entries.size(); }
+
+        //! Number of successful calls of exists.
+        size_type hits() const { return m_hits; }
+
+        //! Number of unsuccessful calls of exists.
+        size_type misses() const { return m_misses; }
+
+        // Returns true if the request i is cached and
+        // x is set to the answer of request i
+        bool exists(size_type i, size_type& x)
+        {
+            size_type s = i & m_mask;
+            entry* e = m_entries.data() + s*t_ways;
+            for (uint32_t w=0; w < t_ways; ++w) {
+                if (e[w].key == i) {
+                    x = e[w].value;
+                    m_clock[s] |= 1U << w;
+                    ++m_hits;
+                    return true;
+                }
+            }
+            ++m_misses;
             return false;
-    }
-    // Writes the answer for request i to the cache
-    void write(size_type i, size_type x) {
-        m_table[(i&CACHE_SIZE)<<1 ] = i;
-        m_table[((i&CACHE_SIZE)<<1) + 1 ] = x;
-    }
+        }
+
+        // Writes the answer for request i to the cache
+        void write(size_type i, size_type x)
+        {
+            assert(i != (size_type)-1);
+            size_type s = i & m_mask;
+            entry* e = m_entries.data() + s*t_ways;
+            uint32_t w = 0;
+            while (w < t_ways and e[w].key != i and e[w].key != (size_type)-1)
+                ++w;
+            if (w == t_ways) { // set is full; find the victim
+                uint32_t ref  = m_clock[s] & 0xFFFF;
+                uint32_t hand = m_clock[s] >> 16;
+                while (ref & (1U << hand)) {
+                    ref &= ~(1U << hand);
+                    hand = (hand+1) % t_ways;
+                }
+                w = hand;
+                m_clock[s] = (((hand+1) % t_ways) << 16) | ref;
+            }
+            e[w].key   = i;
+            e[w].value = x;
+        }
+
+        //! Returns the cached answer of request i or caches and returns f(i).
+        template<class t_f>
+        size_type fetch(size_type i, t_f f)
+        {
+            size_type x = 0;
+            if (!exists(i, x)) {
+                x = f(i);
+                write(i, x);
+            }
+            return x;
+        }
+
+        //! Removes all entries and resets the counters.
+        void clear()
+        {
+            std::fill(m_entries.begin(), m_entries.end(), entry());
+            std::fill(m_clock.begin(), m_clock.end(), 0);
+            m_hits = m_misses = 0;
+        }
+};
+
+//! A cache which can be used by several threads at the same time.
+/*! The requests are distributed by a hash function over a power of two
+ *  number of shards. Each shard is a t_cache protected by its own mutex,
+ *  so threads only wait for each other if they access the same shard.
+ *
+ *  \tparam t_cache Cache type of a shard, e.g. sdsl::assoc_cache.
+ */
+template<class t_cache = assoc_cache<>>
+class sharded_cache
+{
+    public:
+        typedef typename t_cache::size_type size_type;
+
+    private:
+        struct shard {
+            std::mutex mtx;
+            t_cache    cache;
+            explicit shard(size_type capacity) : cache(capacity) {}
+        };
+        std::vector<std::unique_ptr<shard>> m_shards;
+        uint8_t                             m_log_shards = 0;
+
+        shard& _shard(size_type i) const
+        {
+            if (m_log_shards == 0)
+                return *m_shards[0];
+            return *m_shards[(i * 0x9E3779B97F4A7C15ULL) >> (64 - m_log_shards)];
+        }
+
+    public:
+        //! Constructor
+        /*! \param capacity Minimal number of entries of all shards together.
+         *  \param shards   Minimal number of shards; by default four per hardware thread.
+         */
+        explicit sharded_cache(size_type capacity = CACHE_SIZE+1,
+                               size_type shards = 4*hardware_threads())
+        {
+            while ((1ULL << m_log_shards) < shards)
+                ++m_log_shards;
+            size_type n = 1ULL << m_log_shards;
+            for (size_type j=0; j < n; ++j)
+                m_shards.emplace_back(new shard((capacity+n-1)/n));
+        }
+
+        //! Number of shards.
+        size_type shards() const { return m_shards.size(); }
+
+        //! Number of entries.
+        size_type capacity() const
+        {
+            size_type res = 0;
+            for (auto& s : m_shards)
+                res += s->cache.capacity();
+            return res;
+        }
+
+        //! Number of successful calls of exists.
+        size_type hits() const
+        {
+            size_type res = 0;
+            for (auto& s : m_shards) {
+                std::lock_guard<std::mutex> lock(s->mtx);
+                res += s->cache.hits();
+            }
+            return res;
+        }
+
+        //! Number of unsuccessful calls of exists.
+        size_type misses() const
+        {
+            size_type res = 0;
+            for (auto& s : m_shards) {
+                std::lock_guard<std::mutex> lock(s->mtx);
+                res += s->cache.misses();
+            }
+            return res;
+        }
+
+        // Returns true if the request i is cached and
+        // x is set to the answer of request i
+        bool exists(size_type i, size_type& x)
+        {
+            shard& s = _shard(i);
+            std::lock_guard<std::mutex> lock(s.mtx);
+            return s.cache.exists(i, x);
+        }
+
+        // Writes the answer for request i to the cache
+        void write(size_type i, size_type x)
+        {
+            shard& s = _shard(i);
+            std::lock_guard<std::mutex> lock(s.mtx);
+            s.cache.write(i, x);
+        }
+
+        //! Returns the cached answer of request i or caches and returns f(i).
+        /*! f is called without holding a lock, so concurrent calls for the
+         *  same request may both evaluate f.
+         */
+        template<class t_f>
+        size_type fetch(size_type i, t_f f)
+        {
+            size_type x = 0;
+            if (!exists(i, x)) {
+                x = f(i);
+                write(i, x);
+            }
+            return x;
+        }
+
+        //! Removes all entries and resets the counters.
+        void clear()
+        {
+            for (auto& s : m_shards) {
+                std::lock_guard<std::mutex> lock(s->mtx);
+                s->cache.clear();
+            }
+        }
+};
+
+//! Direct mapped cache with CACHE_SIZE+1 entries.
+struct fast_cache : public assoc_cache<1> {
+    fast_cache() : assoc_cache<1>(CACHE_SIZE+1) {}
 };
 
 } // end namespace sdsl
@@ -581,21 +581,65 @@ class int_vector
         }
 
         //! Read the size and int_width of a int_vector
-        static void read_header(int_vector_size_type& size, int_width_type& int_width, std::istream& in)
+        /*! Skips the padding of a header written by write_header, so the
+         *  stream points to the data afterwards.
+         *  \return The number of bytes of the header.
+         */
+        static uint64_t read_header(int_vector_size_type& size, int_width_type& int_width, std::istream& in)
         {
+            uint64_t header = t_width ? 8 : 9;
             read_member(size, in);
+            bool padded = false;
             if (0 == t_width) {
                 read_member(int_width, in);
+                padded = int_width & 0x80;
+                int_vector_trait<t_width>::set_width(int_width & 0x7F, int_width);
+            } else {
+                padded = size >> 63;
+                size &= bits::lo_set[63];
+            }
+            if (padded) {
+                uint8_t pad = 0;
+                read_member(pad, in);
+                in.ignore(pad);
+                header += 1 + pad;
             }
+            return header;
         }
 
         //! Write the size and int_width of a int_vector
-        static uint64_t write_header(uint64_t size, uint8_t int_width, std::ostream& out)
-        {
+        /*! If the position of out is known, the header is padded such that
+         *  the data starts at a multiple of `align` bytes in the stream,
+         *  which lets load_from_file_mapped use it in place. The padding
+         *  is flagged by the highest bit of int_width for int_vector<0>
+         *  and of size otherwise, followed by a byte which holds the
+         *  number of zero bytes of the padding.
+         *  \param align Alignment in bytes, at most 256.
+         */
+        static uint64_t write_header(uint64_t size, uint8_t int_width, std::ostream& out, uint64_t align=8)
+        {
+            uint64_t header = t_width ? 8 : 9;
+            std::streamoff pos = out.tellp();
+            uint8_t pad = 0;
+            bool padded = align > 1 and pos >= 0 and (pos+header)%align;
+            if (padded) {
+                pad = (align - (pos+header+1)%align) % align;
+                if (t_width) {
+                    size |= 1ULL << 63;
+                } else {
+                    int_width |= 0x80;
+                }
+            }
             uint64_t written_bytes = write_member(size, out);
             if (0 == t_width) {
                 written_bytes += write_member(int_width, out);
             }
+            if (padded) {
+                written_bytes += write_member(pad, out);
+                for (uint8_t i=0; i < pad; ++i) {
+                    written_bytes += write_member((uint8_t)0, out);
+                }
+            }
             return written_bytes;
         }
 
@@ -1544,6 +1588,18 @@ void int_vector<t_width>::load(std::istream& in)
     size_type size;
     int_vector<t_width>::read_header(size, m_width, in);
 
+    if (auto buf = dynamic_cast<mmap_filebuf*>(in.rdbuf())) {
+        // zero-copy load: the data points into the mapped file if it is
+        // aligned to 8 bytes; otherwise it is read below
+        uint64_t bytes = ((size+63)>>6)<<3;
+        if (uint64_t* data = buf->map(bytes)) {
+            memory_manager::clear(*this);
+            m_size = size;
+            m_data = data;
+            memory_monitor::record(bytes);
+            return;
+        }
+    }
     bit_resize(size);
     uint64_t* p = m_data;
     size_type idx = 0;
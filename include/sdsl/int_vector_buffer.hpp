@@ -23,15 +23,98 @@
 
 #include "int_vector.hpp"
 #include "iterators.hpp"
+#include "construct_config.hpp"
 #include <cassert>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <stdio.h>
 #include <string>
+#include <thread>
 
 namespace sdsl
 {
 
+//! A thread which runs the reads and writes of an asynchronous int_vector_buffer one at a time.
+class int_vector_buffer_io
+{
+    private:
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        std::function<void()>   m_task;          // posted task, empty if none
+        bool                    m_busy = false;  // a task is posted or running
+        bool                    m_stop = false;
+        std::exception_ptr      m_error;         // exception of the last task
+        std::thread             m_thread;
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                m_cv.wait(lock, [this]() { return m_stop or m_task; });
+                if (!m_task) {
+                    return;
+                }
+                std::function<void()> task = std::move(m_task);
+                m_task = nullptr;
+                lock.unlock();
+                try {
+                    task();
+                } catch (...) {
+                    lock.lock();
+                    m_error = std::current_exception();
+                    lock.unlock();
+                }
+                lock.lock();
+                m_busy = false;
+                m_cv.notify_all();
+            }
+        }
+
+    public:
+        int_vector_buffer_io() : m_thread(&int_vector_buffer_io::run, this) {}
+
+        int_vector_buffer_io(const int_vector_buffer_io&) = delete;
+        int_vector_buffer_io& operator=(const int_vector_buffer_io&) = delete;
+
+        ~int_vector_buffer_io()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+        }
+
+        //! Runs task in the background after the previous task finished.
+        void post(std::function<void()> task)
+        {
+            wait();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_task = std::move(task);
+            m_busy = true;
+            m_cv.notify_all();
+        }
+
+        //! Waits for the posted task and rethrows its exception.
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return !m_busy; });
+            if (m_error) {
+                std::exception_ptr e = m_error;
+                m_error = nullptr;
+                std::rethrow_exception(e);
+            }
+        }
+};
+
 template<uint8_t t_width=0>
 class int_vector_buffer
 {
@@ -52,42 +135,124 @@ class int_vector_buffer
         uint64_t            m_buffersize = 8;    // in elements! m_buffersize*width() must be a multiple of 8!
         uint64_t            m_size       = 0;    // size of int_vector_buffer
         uint64_t            m_begin      = 0;    // number in elements
+        // asynchronous mode: the next block in the direction of the last
+        // block change is read ahead and written blocks are written behind
+        // by the I/O thread of the buffer
+        bool                m_async      = false;
+        int_vector<t_width> m_pbuffer;           // block read ahead, valid if m_pvalid
+        int_vector<t_width> m_wbuffer;           // block to write, pending if m_wpending
+        uint64_t            m_pbegin     = 0;
+        uint64_t            m_wbegin     = 0;
+        uint64_t            m_wbytes     = 0;
+        bool                m_pvalid     = false;
+        bool                m_wpending   = false;
+        std::unique_ptr<int_vector_buffer_io> m_io; // started on the first background task
+
+        //! Waits for the background task.
+        void wait_io()
+        {
+            if (m_io) {
+                m_io->wait();
+            }
+        }
 
-        //! Read block containing element at index idx.
-        void read_block(const uint64_t idx)
+        //! Read the block starting at element begin into buf.
+        void read_block(int_vector<t_width>& buf, const uint64_t begin, const uint64_t size)
         {
-            m_begin = (idx/m_buffersize)*m_buffersize;
-            if (m_begin >= m_size) {
-                util::set_to_value(m_buffer, 0);
+            if (begin >= size) {
+                util::set_to_value(buf, 0);
             } else {
-                m_ifile.seekg(m_offset+(m_begin*width())/8);
+                m_ifile.seekg(m_offset+(begin*width())/8);
                 assert(m_ifile.good());
-                m_ifile.read((char*) m_buffer.data(), (m_buffersize*width())/8);
+                m_ifile.read((char*) buf.data(), (m_buffersize*width())/8);
                 if ((uint64_t)m_ifile.gcount() < (m_buffersize*width())/8) {
                     m_ifile.clear();
                 }
                 assert(m_ifile.good());
-                for (uint64_t i=m_size-m_begin; i<m_buffersize; ++i) {
-                    m_buffer[i] = 0;
+                for (uint64_t i=size-begin; i<m_buffersize; ++i) {
+                    buf[i] = 0;
                 }
             }
         }
 
+        //! Write the first bytes of buf to the block starting at element begin.
+        void write_block(const int_vector<t_width>& buf, const uint64_t begin, const uint64_t bytes)
+        {
+            m_ofile.seekp(m_offset+(begin*width())/8);
+            assert(m_ofile.good());
+            m_ofile.write((const char*) buf.data(), bytes);
+            m_ofile.flush();
+            assert(m_ofile.good());
+        }
+
+        //! Wait for the background task and write a pending block.
+        void finish_io()
+        {
+            wait_io();
+            if (m_wpending) {
+                write_block(m_wbuffer, m_wbegin, m_wbytes);
+                m_wpending = false;
+            }
+        }
+
+        //! Read block containing element at index idx.
+        void read_block(const uint64_t idx)
+        {
+            uint64_t begin = (idx/m_buffersize)*m_buffersize;
+            if (!m_async) {
+                m_begin = begin;
+                read_block(m_buffer, m_begin, m_size);
+                return;
+            }
+            wait_io();
+            if (m_pvalid and m_pbegin == begin) {
+                m_buffer.swap(m_pbuffer);
+            } else {
+                finish_io();
+                read_block(m_buffer, begin, m_size);
+            }
+            // a right-to-left scan reads the preceding block ahead
+            bool backward = begin+m_buffersize == m_begin;
+            m_begin  = begin;
+            m_pvalid = false;
+            // write the last block and read the next block in the background
+            bool write = m_wpending;
+            bool read  = backward ? begin > 0 : begin+m_buffersize < m_size;
+            if (write or read) {
+                m_wpending = false;
+                m_pvalid   = read;
+                m_pbegin   = backward ? begin-m_buffersize : begin+m_buffersize;
+                uint64_t wbegin = m_wbegin, wbytes = m_wbytes, pbegin = m_pbegin, size = m_size;
+                if (!m_io) {
+                    m_io.reset(new int_vector_buffer_io());
+                }
+                m_io->post([this, write, read, wbegin, wbytes, pbegin, size]() {
+                    if (write)
+                        write_block(m_wbuffer, wbegin, wbytes);
+                    if (read)
+                        read_block(m_pbuffer, pbegin, size);
+                });
+            }
+        }
+
         //! Write current block to file.
         void write_block()
         {
             if (m_need_to_write) {
-                m_ofile.seekp(m_offset+(m_begin*width())/8);
-                assert(m_ofile.good());
+                uint64_t bytes = (m_buffersize*width())/8;
                 if (m_begin+m_buffersize >= m_size) {
                     //last block in file
-                    uint64_t wb = ((m_size-m_begin)*width()+7)/8;
-                    m_ofile.write((char*) m_buffer.data(), wb);
+                    bytes = ((m_size-m_begin)*width()+7)/8;
+                }
+                if (m_async) {
+                    finish_io();
+                    m_wbuffer.swap(m_buffer); // m_buffer is refilled by read_block
+                    m_wbegin   = m_begin;
+                    m_wbytes   = bytes;
+                    m_wpending = true;
                 } else {
-                    m_ofile.write((char*) m_buffer.data(), (m_buffersize*width())/8);
+                    write_block(m_buffer, m_begin, bytes);
                 }
-                m_ofile.flush();
-                assert(m_ofile.good());
                 m_need_to_write = false;
             }
         }
@@ -138,10 +303,17 @@ class int_vector_buffer
          *  \param is_plain   If false (default) the file will be interpreted as int_vector.
          *                    If true the file will be interpreted as plain array with t_width bits per integer.
          *                    In second case (is_plain==true), t_width must be 8, 16, 32 or 64.
+         *  \param async      If true, the block after the current block (or before it, if
+         *                    the last block change went to the left) is read ahead and
+         *                    written blocks are written behind by a background thread, i.e.
+         *                    a sequential scan in either direction does not wait for the file. This needs
+         *                    three buffers of buffer_size bytes and pays off for buffers of
+         *                    some kB and more. The default is construct_config::async_io.
          */
-        int_vector_buffer(const std::string filename, std::ios::openmode mode=std::ios::in, const uint64_t buffer_size=1024*1024, const uint8_t int_width=t_width, const bool is_plain=false)
+        int_vector_buffer(const std::string filename, std::ios::openmode mode=std::ios::in, const uint64_t buffer_size=1024*1024, const uint8_t int_width=t_width, const bool is_plain=false, const bool async=construct_config::async_io)
         {
             m_filename = filename;
+            m_async = async;
             assert(!(mode&std::ios::app));
             mode &= ~std::ios::app;
             m_buffer.width(int_width);
@@ -149,7 +321,11 @@ class int_vector_buffer
                 // is_plain is only allowed with width() in {8, 16, 32, 64}
                 assert(8==width() or 16==width() or 32==width() or 64==width());
             } else {
-                m_offset = t_width ? 8 : 9;
+                // pad the header of int_vector<0> such that the data is aligned to 8 bytes
+                m_offset = 8;
+                if (0 == t_width) {
+                    m_offset = 16;
+                }
             }
 
             // Open file for IO
@@ -164,7 +340,7 @@ class int_vector_buffer
                     size = m_ifile.tellg()*8;
                 } else {
                     uint8_t width = 0;
-                    int_vector<t_width>::read_header(size, width, m_ifile);
+                    m_offset = int_vector<t_width>::read_header(size, width, m_ifile);
                     m_buffer.width(width);
                 }
                 assert(m_ifile.good());
@@ -174,15 +350,21 @@ class int_vector_buffer
         }
 
         //! Move constructor.
-        int_vector_buffer(int_vector_buffer&& ivb) :
-            m_filename(std::move(ivb.m_filename)),
-            m_buffer(std::move(ivb.m_buffer)),
-            m_need_to_write(ivb.m_need_to_write),
-            m_offset(ivb.m_offset),
-            m_buffersize(ivb.m_buffersize),
-            m_size(ivb.m_size),
-            m_begin(ivb.m_begin)
+        int_vector_buffer(int_vector_buffer&& ivb)
         {
+            ivb.finish_io();
+            ivb.m_pvalid = false;
+            m_filename = std::move(ivb.m_filename);
+            m_buffer = std::move(ivb.m_buffer);
+            m_need_to_write = ivb.m_need_to_write;
+            m_offset = ivb.m_offset;
+            m_buffersize = ivb.m_buffersize;
+            m_size = ivb.m_size;
+            m_begin = ivb.m_begin;
+            m_async = ivb.m_async;
+            m_pbuffer = std::move(ivb.m_pbuffer);
+            m_wbuffer = std::move(ivb.m_wbuffer);
+            m_io = std::move(ivb.m_io);
             ivb.m_ifile.close();
             ivb.m_ofile.close();
             m_ifile.open(m_filename, std::ios::in|std::ios::binary);
@@ -209,6 +391,8 @@ class int_vector_buffer
         int_vector_buffer<t_width>& operator=(int_vector_buffer&& ivb)
         {
             close();
+            ivb.finish_io();
+            ivb.m_pvalid = false;
             ivb.m_ifile.close();
             ivb.m_ofile.close();
             m_filename = ivb.m_filename;
@@ -223,6 +407,10 @@ class int_vector_buffer
             m_buffersize = ivb.m_buffersize;
             m_size = ivb.m_size;
             m_begin = ivb.m_begin;
+            m_async = ivb.m_async;
+            m_pbuffer = (int_vector<t_width>&&)ivb.m_pbuffer;
+            m_wbuffer = (int_vector<t_width>&&)ivb.m_wbuffer;
+            m_io = std::move(ivb.m_io);
             // set ivb to default-constructor state
             ivb.m_filename = "";
             ivb.m_buffer = int_vector<t_width>();
@@ -265,6 +453,8 @@ class int_vector_buffer
             if (0ULL == buffersize)
                 buffersize = 8;
             write_block();
+            finish_io();
+            m_pvalid = false;
             if (0==(buffersize*8)%width()) {
                 m_buffersize = buffersize*8/width(); // m_buffersize might not be multiple of 8, but m_buffersize*width() is.
             } else {
@@ -272,6 +462,10 @@ class int_vector_buffer
                 m_buffersize = element_buffersize+7 - (element_buffersize+7)%8; // take next multiple of 8
             }
             m_buffer = int_vector<t_width>(m_buffersize, 0, width());
+            if (m_async) {
+                m_pbuffer = int_vector<t_width>(m_buffersize, 0, width());
+                m_wbuffer = int_vector<t_width>(m_buffersize, 0, width());
+            }
             if (0!=m_buffersize) read_block(0);
         }
 
@@ -287,9 +481,17 @@ class int_vector_buffer
             return m_ifile.is_open() and m_ofile.is_open();;
         }
 
+        //! Returns whether the file is read and written asynchronously.
+        bool async() const
+        {
+            return m_async;
+        }
+
         //! Delete all content and set size to 0
         void reset()
         {
+            wait_io();
+            m_pvalid = m_wpending = false;
             // reset file
             assert(m_ifile.good());
             assert(m_ofile.good());
@@ -334,10 +536,16 @@ class int_vector_buffer
             if (is_open()) {
                 if (!remove_file) {
                     write_block();
+                    finish_io();
                     if (0 < m_offset) { // in case of int_vector, write header and trailing zeros
                         uint64_t size = m_size*width();
+                        // the header keeps its length, as the data starts at m_offset;
+                        // it is built in memory since m_ofile may not report its position
+                        std::stringstream header;
+                        int_vector<t_width>::write_header(size, width(), header, m_offset);
+                        assert((uint64_t)header.tellp() == m_offset);
                         m_ofile.seekp(0, std::ios::beg);
-                        int_vector<t_width>::write_header(size, width(), m_ofile);
+                        m_ofile.write(header.str().data(), m_offset);
                         assert(m_ofile.good());
                         uint64_t wb = (size+7)/8;
                         if (wb%8) {
@@ -347,7 +555,10 @@ class int_vector_buffer
                             assert(m_ofile.good());
                         }
                     }
+                } else {
+                    wait_io();
                 }
+                m_pvalid = m_wpending = false;
                 m_ifile.close();
                 assert(m_ifile.good());
                 m_ofile.close();
@@ -372,6 +583,9 @@ class int_vector_buffer
         void swap(int_vector_buffer<t_width>& ivb)
         {
             if (this != &ivb) {
+                finish_io();
+                ivb.finish_io();
+                m_pvalid = ivb.m_pvalid = false;
                 m_ifile.close();
                 ivb.m_ifile.close();
                 m_ofile.close();
@@ -391,6 +605,10 @@ class int_vector_buffer
                 std::swap(m_buffersize, ivb.m_buffersize);
                 std::swap(m_size, ivb.m_size);
                 std::swap(m_begin, ivb.m_begin);
+                std::swap(m_async, ivb.m_async);
+                std::swap(m_pbuffer, ivb.m_pbuffer);
+                std::swap(m_wbuffer, ivb.m_wbuffer);
+                std::swap(m_io, ivb.m_io);
             }
         }
 
@@ -42,16 +42,19 @@ class int_vector_mapper
                     if (m_data_offset) {
                         // update size in the on disk representation and
                         // truncate if necessary
+                        // keep the flag of a padded header, see int_vector::write_header
                         uint64_t* size_in_file = (uint64_t*)m_mapped_data;
-                        if (*size_in_file != m_wrapper.m_size) {
-                            *size_in_file = m_wrapper.m_size;
+                        uint64_t size = m_wrapper.m_size | (t_width ? (*size_in_file & (1ULL<<63)) : 0);
+                        if (*size_in_file != size) {
+                            *size_in_file = size;
                         }
                         if (t_width==0) {
                             // if size is variable and we map a sdsl vector
                             // we might have to update the stored width
                             uint8_t stored_width = m_mapped_data[8];
-                            if (stored_width != m_wrapper.m_width) {
-                                m_mapped_data[8] = m_wrapper.m_width;
+                            uint8_t width = m_wrapper.m_width | (stored_width & 0x80);
+                            if (stored_width != width) {
+                                m_mapped_data[8] = width;
                             }
                         }
                     }
@@ -138,14 +141,12 @@ class int_vector_mapper
                         "int_vector_mapper: file does not exist.");
                 }
                 if (!is_plain) {
-                    int_vector<t_width>::read_header(size_in_bits, int_width, f);
+                    m_data_offset = int_vector<t_width>::read_header(size_in_bits, int_width, f);
                 }
             }
             m_file_size_bytes = util::file_size(m_file_name);
 
-            if (!is_plain) {
-                m_data_offset = t_width ? 8 : 9;
-            } else {
+            if (is_plain) {
                 if (8 != t_width and 16 != t_width and 32 != t_width and 64 != t_width) {
                     throw std::runtime_error("int_vector_mapper: plain vector can "
                                              "only be of width 8, 16, 32, 64.");
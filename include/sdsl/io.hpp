@@ -24,6 +24,7 @@
 #include "util.hpp"
 #include "sdsl_concepts.hpp"
 #include "structure_tree.hpp"
+#include "mmap_filebuf.hpp"
 #include <algorithm>
 #include <string>
 #include <vector>
@@ -171,6 +172,22 @@ void load(std::vector<X>& x, std::istream& in)
 template<class T>
 bool load_from_file(T& v, const std::string& file);
 
+//! Load sdsl-object v from a memory mapping of a file without copying its int_vectors.
+/*!
+ * \param v    sdsl-object.
+ * \param file Name of the serialized file.
+ *
+ * The data of each int_vector member of v points into a copy-on-write
+ * mapping of the file, so loading takes time proportional to the number of
+ * members instead of the size of v, and processes loading the same file
+ * share the page cache. The mapping is released when the last int_vector
+ * using it is destroyed or resized. Members which do not consist of
+ * int_vectors are loaded as usual. Files in the RAM file system are
+ * loaded with load_from_file.
+ */
+template<class T>
+bool load_from_file_mapped(T& v, const std::string& file);
+
 //! Load an int_vector from a plain array of `num_bytes`-byte integers with X in \{0, 1,2,4,8\} from disk.
 // TODO: Remove ENDIAN dependency.
 template<class t_int_vec>
@@ -745,6 +762,27 @@ bool load_from_file(T& v, const std::string& file)
     return true;
 }
 
+template<class T>
+bool load_from_file_mapped(T& v, const std::string& file)
+{
+    if (is_ram_file(file)) {
+        return load_from_file(v, file);
+    }
+    mmap_filebuf buf;
+    if (!buf.open(file)) {
+        if (util::verbose) {
+            std::cerr << "Could not map file `" << file << "`" << std::endl;
+        }
+        return false;
+    }
+    std::istream in(&buf);
+    load(v, in);
+    if (util::verbose) {
+        std::cerr << "Load mapped file `" << file << "`" << std::endl;
+    }
+    return true;
+}
+
 template<class T>
 bool load_from_checked_file(T& v, const std::string& file)
 {
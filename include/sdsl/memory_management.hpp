@@ -18,6 +18,7 @@
 #include <cstddef>
 #include <stack>
 #include <vector>
+#include <atomic>
 #include "config.hpp"
 #include <fcntl.h>
 
@@ -283,16 +284,167 @@ class hugepage_allocator
 };
 #endif
 
+//! Describes how memory_manager places large allocations, see memory_manager::use_policy.
+struct alloc_policy {
+    enum page_type {
+        default_pages,          //!< Pages chosen by the system.
+        transparent_hugepages,  //!< 2MB aligned mappings advised with MADV_HUGEPAGE.
+        hugepages_1g            //!< Explicit 1GB pages; falls back to transparent hugepages.
+    };
+    enum numa_type {
+        first_touch,  //!< Pages are placed on the node of the first writing thread.
+        interleave,   //!< Pages are interleaved round robin over all nodes.
+        preferred     //!< Pages are placed on node `node` while it has free memory.
+    };
+    page_type pages     = default_pages;
+    numa_type numa      = first_touch;
+    uint32_t  node      = 0;
+    size_t    min_bytes = 4ULL*1024*1024; //!< Smaller allocations are served by calloc.
+};
+
+#ifndef MSVC_COMPILER
+//! Serves allocations of at least alloc_policy::min_bytes with their own anonymous mapping.
+/*! Each mapping gets the page size and NUMA placement of the current policy.
+ *  Placement is best effort: if the system does not support a request
+ *  (e.g. no 1GB pages are reserved or mbind is not permitted) the memory is
+ *  still returned, only without the requested property.
+ */
+class policy_allocator
+{
+    private:
+        alloc_policy m_policy;
+        std::atomic<bool> m_active{false};
+        std::atomic<size_t> m_min_bytes{0};
+        std::atomic<uint64_t> m_cnt{0};     // number of live mappings
+        struct block {
+            size_t len;    // length of the mapping in bytes
+            size_t align;  // page size the length is rounded to
+        };
+        std::mutex m_mutex;
+        std::map<uint8_t*, block> m_blocks; // start address -> mapping
+    private:
+        uint8_t* map_block(size_t size, block& b);
+        void apply_numa(void* addr, size_t len, const alloc_policy& policy);
+        size_t block_length(void* ptr);
+    public:
+        void set_policy(const alloc_policy& policy, bool active)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_policy = policy;
+            m_min_bytes = policy.min_bytes;
+            m_active = active;
+        }
+        alloc_policy policy()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_policy;
+        }
+        //! True if allocations of size bytes are served by this allocator.
+        bool applies(size_t size)
+        {
+            return m_active and size >= m_min_bytes;
+        }
+        void* mm_alloc(size_t size_in_bytes);
+        void* mm_realloc(void* ptr, size_t size);
+        void mm_free(void* ptr);
+        bool in_address_space(void* ptr)
+        {
+            // Mappings start at a page boundary, which heap blocks do only by
+            // chance, so most frees of heap blocks do not take the lock.
+            return m_cnt > 0 and ptr != nullptr and 0 == ((uintptr_t)ptr & 4095)
+                   and block_length(ptr) > 0;
+        }
+        static policy_allocator& the_allocator()
+        {
+            static policy_allocator a;
+            return a;
+        }
+};
+#endif
+
 class memory_manager
 {
     private:
+        struct mapped_region {
+            uint64_t size;  // size of the mapping in bytes
+            uint64_t refs;  // number of references to the mapping
+        };
         bool hugepages = false;
+        std::atomic<uint64_t> m_mapped_cnt{0}; // number of registered mappings
+        std::mutex m_mapped_mutex;
+        std::map<uint8_t*, mapped_region> m_mapped; // start address -> mapping
     private:
         static memory_manager& the_manager()
         {
             static memory_manager m;
             return m;
         }
+        // Returns the mapping containing ptr or m_mapped.end(). Requires m_mapped_mutex.
+        std::map<uint8_t*, mapped_region>::iterator find_mapped(const void* ptr)
+        {
+            uint8_t* p = (uint8_t*)ptr;
+            auto it = m_mapped.upper_bound(p);
+            if (it == m_mapped.begin()) {
+                return m_mapped.end();
+            }
+            --it;
+            return (p < it->first + it->second.size) ? it : m_mapped.end();
+        }
+    public:
+        //! Registers the file mapping [addr..addr+size) with one reference.
+        /*! The mapping is unmapped as soon as release_mapped removed the last
+         *  reference. Memory inside the mapping can be passed to free_mem and
+         *  realloc_mem, which release the reference instead of freeing it.
+         */
+        static void register_mapped(void* addr, uint64_t size)
+        {
+            auto& m = the_manager();
+            std::lock_guard<std::mutex> lock(m.m_mapped_mutex);
+            m.m_mapped[(uint8_t*)addr] = mapped_region{size, 1};
+            ++m.m_mapped_cnt;
+        }
+        //! Adds a reference to the mapping which contains ptr.
+        static void acquire_mapped(const void* ptr)
+        {
+            auto& m = the_manager();
+            std::lock_guard<std::mutex> lock(m.m_mapped_mutex);
+            auto it = m.find_mapped(ptr);
+            if (it != m.m_mapped.end()) {
+                ++it->second.refs;
+            }
+        }
+        //! Removes a reference from the mapping which contains ptr.
+        /*! \return False if ptr does not point into a registered mapping.
+         */
+        static bool release_mapped(const void* ptr)
+        {
+            auto& m = the_manager();
+            if (0 == m.m_mapped_cnt or nullptr == ptr) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m.m_mapped_mutex);
+            auto it = m.find_mapped(ptr);
+            if (it == m.m_mapped.end()) {
+                return false;
+            }
+            if (0 == --it->second.refs) {
+                mem_unmap(it->first, it->second.size);
+                m.m_mapped.erase(it);
+                --m.m_mapped_cnt;
+            }
+            return true;
+        }
+        //! Returns the number of bytes in [ptr..end of its mapping), or 0 if ptr is not mapped.
+        static uint64_t mapped_bytes(const void* ptr)
+        {
+            auto& m = the_manager();
+            if (0 == m.m_mapped_cnt or nullptr == ptr) {
+                return 0;
+            }
+            std::lock_guard<std::mutex> lock(m.m_mapped_mutex);
+            auto it = m.find_mapped(ptr);
+            return it == m.m_mapped.end() ? 0 : it->first + it->second.size - (uint8_t*)ptr;
+        }
     public:
         static uint64_t* alloc_mem(size_t size_in_bytes)
         {
@@ -301,27 +453,63 @@ class memory_manager
             if (m.hugepages) {
                 return (uint64_t*)hugepage_allocator::the_allocator().mm_alloc(size_in_bytes);
             }
+            if (policy_allocator::the_allocator().applies(size_in_bytes)) {
+                return (uint64_t*)policy_allocator::the_allocator().mm_alloc(size_in_bytes);
+            }
 #endif
             return (uint64_t*)calloc(size_in_bytes, 1);
         }
         static void free_mem(uint64_t* ptr)
         {
+            if (release_mapped(ptr)) {
+                return;
+            }
 #ifndef MSVC_COMPILER
             auto& m = the_manager();
             if (m.hugepages and hugepage_allocator::the_allocator().in_address_space(ptr)) {
                 hugepage_allocator::the_allocator().mm_free(ptr);
                 return;
             }
+            if (policy_allocator::the_allocator().in_address_space(ptr)) {
+                policy_allocator::the_allocator().mm_free(ptr);
+                return;
+            }
 #endif
             std::free(ptr);
         }
-        static uint64_t* realloc_mem(uint64_t* ptr, size_t size)
+        //! Resizes the block at ptr to size bytes.
+        /*! If old_size, the number of used bytes at ptr, is given, a heap
+         *  block which grows to alloc_policy::min_bytes or more is moved into
+         *  a mapping with the current policy.
+         */
+        static uint64_t* realloc_mem(uint64_t* ptr, size_t size, size_t old_size=0)
         {
+            if (uint64_t mapped = mapped_bytes(ptr)) {
+                // memory inside a file mapping is never resized in place
+                uint64_t* p = alloc_mem(size);
+                if (p != nullptr) {
+                    memcpy(p, ptr, std::min((uint64_t)size, mapped));
+                    release_mapped(ptr);
+                }
+                return p;
+            }
 #ifndef MSVC_COMPILER
             auto& m = the_manager();
             if (m.hugepages and hugepage_allocator::the_allocator().in_address_space(ptr)) {
                 return (uint64_t*)hugepage_allocator::the_allocator().mm_realloc(ptr, size);
             }
+            auto& pa = policy_allocator::the_allocator();
+            if (pa.in_address_space(ptr)) {
+                return (uint64_t*)pa.mm_realloc(ptr, size);
+            }
+            if (pa.applies(size) and (ptr == nullptr or old_size > 0)) {
+                uint64_t* p = (uint64_t*)pa.mm_alloc(size);
+                if (p != nullptr and ptr != nullptr) {
+                    memcpy(p, ptr, std::min(size, old_size));
+                    std::free(ptr);
+                }
+                return p;
+            }
 #endif
             return (uint64_t*)realloc(ptr, size);
         }
@@ -334,6 +522,25 @@ class memory_manager
             m.hugepages = true;
 #else
             throw std::runtime_error("hugepages not support on MSVC_COMPILER");
+#endif
+        }
+        //! Places all following allocations of at least policy.min_bytes according to policy.
+        /*! Existing vectors move to the policy when they are resized above
+         *  policy.min_bytes. Has no effect on allocations served by use_hugepages.
+         */
+        static void use_policy(const alloc_policy& policy)
+        {
+#ifndef MSVC_COMPILER
+            policy_allocator::the_allocator().set_policy(policy, true);
+#else
+            throw std::runtime_error("allocation policies not support on MSVC_COMPILER");
+#endif
+        }
+        //! Returns to plain calloc/realloc for new allocations.
+        static void reset_policy()
+        {
+#ifndef MSVC_COMPILER
+            policy_allocator::the_allocator().set_policy(alloc_policy(), false);
 #endif
         }
         template<class t_vec>
@@ -349,7 +556,7 @@ class memory_manager
                 // access to this padding to answer rank(size()) if size()%64 ==0.
                 // Note that this padding is not counted in the serialize method!
                 size_t allocated_bytes = (size_t)(((size + 64) >> 6) << 3);
-                v.m_data = memory_manager::realloc_mem(v.m_data, allocated_bytes);
+                v.m_data = memory_manager::realloc_mem(v.m_data, allocated_bytes, old_size_in_bytes);
                 if (allocated_bytes != 0 && v.m_data == nullptr) {
                     throw std::bad_alloc();
                 }
@@ -429,6 +636,41 @@ class memory_manager
             return nullptr;
         }
 
+        //! Maps a file copy-on-write: the mapping is writable, but changes are not written back to the file.
+        /*! The mapping is followed by `tail` zero bytes, so it has to be
+         *  unmapped with size file_size+tail.
+         */
+        static void* mmap_file_private(int fd,uint64_t file_size,uint64_t tail=0) {
+#ifdef MSVC_COMPILER
+            SYSTEM_INFO si;
+            GetSystemInfo(&si);
+            if (tail > (si.dwPageSize - file_size % si.dwPageSize) % si.dwPageSize) {
+                return nullptr; // a view can not extend beyond the last page of the file
+            }
+            HANDLE fh = (HANDLE)_get_osfhandle(fd);
+            if (fh == INVALID_HANDLE_VALUE) {
+                return nullptr;
+            }
+            HANDLE fm = CreateFileMapping(fh, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            if (fm == NULL) {
+                return nullptr;
+            }
+            void* map = MapViewOfFile(fm, FILE_MAP_COPY, 0, 0, file_size);
+            CloseHandle(fm);
+            return map;
+#else
+            // reserve anonymous zero pages for the tail and map the file over their start
+            void* map = mmap(NULL,file_size+tail,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1, 0);
+            if(map == MAP_FAILED) return nullptr; // unify windows and unix error behaviour
+            if(mmap(map,file_size,PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_FIXED,fd, 0) == MAP_FAILED) {
+                munmap(map, file_size+tail);
+                return nullptr;
+            }
+            return map;
+#endif
+            return nullptr;
+        }
+
         static int mem_unmap(void* addr,const uint64_t size) {
 #ifdef MSVC_COMPILER
             if (UnmapViewOfFile(addr)) return 0;
@@ -0,0 +1,62 @@
+/*!\file mmap_filebuf.hpp
+   \brief mmap_filebuf.hpp contains a stream buffer which reads a memory mapped file.
+*/
+#ifndef INCLUDED_SDSL_MMAP_FILEBUF
+#define INCLUDED_SDSL_MMAP_FILEBUF
+
+#include <streambuf>
+#include <string>
+#include <stdint.h>
+
+namespace sdsl
+{
+
+//! A read-only stream buffer over a copy-on-write memory mapping of a file.
+/*! Besides the usual stream interface, map() hands out pointers into the
+ *  mapping. int_vector::load uses it to let its data point into the file
+ *  instead of copying it, see load_from_file_mapped. Each pointer holds a
+ *  reference to the mapping, so the mapping outlives the buffer as long
+ *  as a loaded structure still uses it.
+ */
+class mmap_filebuf : public std::streambuf
+{
+    private:
+        char*    m_base = nullptr;  // start of the mapping
+        uint64_t m_size = 0;        // size of the mapped file
+    public:
+        mmap_filebuf() {}
+        mmap_filebuf(const mmap_filebuf&) = delete;
+        mmap_filebuf& operator=(const mmap_filebuf&) = delete;
+        virtual ~mmap_filebuf();
+
+        //! Maps the file. Returns nullptr if the file can not be mapped.
+        mmap_filebuf* open(const std::string& file);
+
+        bool is_open() const { return m_base != nullptr; }
+
+        //! Drops the reference of the buffer to the mapping.
+        mmap_filebuf* close();
+
+        //! Returns a pointer to the next `bytes` bytes and skips them.
+        /*! Returns nullptr if fewer than `bytes` bytes are left or if the
+         *  data does not start at a multiple of `align` bytes. In both
+         *  cases nothing is skipped and the caller reads the data. The
+         *  mapping is followed by eight zero bytes, which serve as the
+         *  padding word int_vector expects after the data of the last
+         *  member of the file.
+         *  The caller owns one reference to the mapping and returns it
+         *  with memory_manager::free_mem.
+         */
+        uint64_t* map(uint64_t bytes, uint64_t align=alignof(uint64_t));
+
+    protected:
+        pos_type seekoff(off_type off, std::ios_base::seekdir way,
+                         std::ios_base::openmode which = std::ios_base::in) override;
+
+        pos_type seekpos(pos_type sp,
+                         std::ios_base::openmode which = std::ios_base::in) override;
+};
+
+} // end namespace
+
+#endif
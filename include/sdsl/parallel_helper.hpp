@@ -0,0 +1,124 @@
+/*! \file parallel_helper.hpp
+    \brief parallel_helper.hpp contains helper functions to distribute work among threads.
+*/
+#ifndef INCLUDED_SDSL_PARALLEL_HELPER
+#define INCLUDED_SDSL_PARALLEL_HELPER
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stdint.h>
+
+namespace sdsl
+{
+
+//! Returns the number of concurrent threads supported by the machine (at least 1).
+inline uint64_t hardware_threads()
+{
+    uint64_t t = std::thread::hardware_concurrency();
+    return t ? t : 1;
+}
+
+//! Calls f(i, t) for each i in [0, n) using `threads` threads.
+/*! \param n       Number of work items.
+ *  \param threads Number of threads. For threads<=1 all items are processed
+ *                 by the calling thread.
+ *  \param f       Functor f(i, t), where t in [0, threads) is the id of the
+ *                 thread which executes item i. t can be used to index
+ *                 thread local buffers.
+ *  \param grain   Number of consecutive items fetched by a thread at once.
+ *
+ *  Items are distributed dynamically, i.e. a thread fetches the next `grain`
+ *  items as soon as it finished its current ones. An exception thrown by f
+ *  is rethrown in the calling thread after all threads have finished.
+ */
+template<class t_f>
+void parallel_for(uint64_t n, uint64_t threads, t_f f, uint64_t grain=1)
+{
+    if (grain == 0) {
+        grain = 1;
+    }
+    threads = std::min(threads, (n+grain-1)/grain);
+    if (threads <= 1) {
+        for (uint64_t i=0; i < n; ++i) {
+            f(i, 0);
+        }
+        return;
+    }
+    std::atomic<uint64_t> next(0);
+    std::exception_ptr error = nullptr;
+    std::mutex error_mutex;
+    auto worker = [&](uint64_t t) {
+        try {
+            uint64_t b;
+            while ((b = next.fetch_add(grain)) < n) {
+                uint64_t e = std::min(b+grain, n);
+                for (uint64_t i=b; i < e; ++i) {
+                    f(i, t);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = n; // let the other threads stop early
+        }
+    };
+    std::vector<std::thread> pool;
+    for (uint64_t t=1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& th : pool) {
+        th.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+//! Sorts [first, last) with respect to comp using `threads` threads.
+/*! The range is split into `threads` parts which are sorted concurrently
+ *  by std::sort and merged afterwards. The merge steps use std::inplace_merge
+ *  and hence may allocate a temporary buffer.
+ */
+template<class t_rac_it, class t_comp>
+void parallel_sort(t_rac_it first, t_rac_it last, t_comp comp, uint64_t threads)
+{
+    uint64_t n = last-first;
+    if (threads <= 1 or n < 1024) {
+        std::sort(first, last, comp);
+        return;
+    }
+    uint64_t left_threads = threads/2;
+    t_rac_it mid = first + (n * left_threads)/threads;
+    std::exception_ptr left_error = nullptr, right_error = nullptr;
+    std::thread left([&]() {
+        try {
+            parallel_sort(first, mid, comp, left_threads);
+        } catch (...) {
+            left_error = std::current_exception();
+        }
+    });
+    try {
+        parallel_sort(mid, last, comp, threads-left_threads);
+    } catch (...) {
+        right_error = std::current_exception();
+    }
+    left.join();
+    if (left_error) {
+        std::rethrow_exception(left_error);
+    }
+    if (right_error) {
+        std::rethrow_exception(right_error);
+    }
+    std::inplace_merge(first, mid, last, comp);
+}
+
+} // end namespace sdsl
+
+#endif
@@ -0,0 +1,731 @@
+/*!\file pef_vector.hpp
+   \brief pef_vector.hpp contains the sdsl::pef_vector class, a partitioned
+          Elias-Fano bit vector, and classes which support rank and select
+          for pef_vector.
+*/
+#ifndef INCLUDED_SDSL_PEF_VECTOR
+#define INCLUDED_SDSL_PEF_VECTOR
+
+#include "int_vector.hpp"
+#include "util.hpp"
+#include "iterators.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+template<uint8_t t_b=1>// forward declaration needed for friend declaration
+class rank_support_pef;  // in pef_vector
+
+template<uint8_t t_b=1>// forward declaration needed for friend declaration
+class select_support_pef;  // in pef_vector
+
+class pef_vector;  // in pef_vector
+
+//! Class for in-place construction of pef_vector from a strictly increasing sequence
+/*! The positions are buffered and partitioned when the pef_vector is
+ *  constructed, as the optimal partition depends on all of them.
+ */
+class pef_vector_builder
+{
+        friend class pef_vector;
+
+    public:
+        typedef bit_vector::size_type size_type;
+
+    private:
+        size_type m_size, m_capacity;
+        size_type m_tail, m_items;
+
+        int_vector<> m_pos;
+
+    public:
+        pef_vector_builder();
+
+        //! Constructor
+        /*! \param n Vector size.
+         *  \param m The number of 1-bits.
+         */
+        pef_vector_builder(size_type n, size_type m);
+
+        inline size_type size() const { return m_size; }
+        inline size_type capacity() const { return m_capacity; }
+        inline size_type tail() const { return m_tail; }
+        inline size_type items() const { return m_items; }
+
+        //! Set a bit to 1.
+        /*! \param i The position of the bit.
+         *  \par The position must be strictly greater than for the previous call.
+         */
+        inline void set(size_type i)
+        {
+            assert(i >= m_tail && i < m_size);
+            assert(m_items < m_capacity);
+
+            m_pos[m_items++] = i;
+            m_tail = i + 1;
+        }
+
+        //! Swap method
+        void swap(pef_vector_builder& pb);
+};
+
+//! A partitioned Elias-Fano bit vector.
+/*!
+ * The ones are split into chunks of consecutive ones. A chunk covers the
+ * positions after the last one of the previous chunk up to its own last
+ * one and is stored in the cheapest of three encodings:
+ *   - a run, if its ones are consecutive; it needs no payload,
+ *   - a plain bitmap of the covered positions,
+ *   - Elias-Fano coding of the positions relative to the chunk start.
+ * The partition minimizes the total size by dynamic programming over
+ * chunk boundaries at multiples of chunk_granularity ones, with at most
+ * max_chunk_size ones per chunk. Clustered sets are therefore stored with
+ * a local low width instead of the global one of sd_vector, and dense
+ * regions are decoded with popcounts.
+ *
+ * For each chunk the last position, the number of ones before it and the
+ * payload offset are stored; the encoding follows from the payload size.
+ * Chunks are found by sampled binary search, so rank, select and
+ * successor queries touch the top level and one payload.
+ *
+ * \par Reference
+ *  - G. Ottaviano, R. Venturini: ,,Partitioned Elias-Fano Indexes'',
+ *             Proceedings of SIGIR 2014.
+ */
+class pef_vector
+{
+    public:
+        typedef bit_vector::size_type                    size_type;
+        typedef size_type                                value_type;
+        typedef bit_vector::difference_type              difference_type;
+        typedef random_access_const_iterator<pef_vector> iterator;
+        typedef bv_tag                                   index_category;
+
+        friend class rank_support_pef<1>;
+        friend class rank_support_pef<0>;
+        friend class select_support_pef<1>;
+        friend class select_support_pef<0>;
+
+        typedef rank_support_pef<1>     rank_1_type;
+        typedef rank_support_pef<0>     rank_0_type;
+        typedef select_support_pef<1> select_1_type;
+        typedef select_support_pef<0> select_0_type;
+
+        enum { chunk_granularity = 64 };   // chunk boundaries are multiples of this number of ones
+        enum { max_chunk_size    = 1024 }; // maximal number of ones in a chunk
+    private:
+        size_type    m_size         = 0; // length of the original bit vector
+        size_type    m_ones         = 0; // number of ones
+        uint8_t      m_rank_shift   = 0; // log of the number of positions per rank sample
+        uint8_t      m_select_shift = 0; // log of the number of ones per select sample
+        int_vector<> m_end;              // m_end[c] = position of the last one of chunk c
+        int_vector<> m_cnt;              // m_cnt[c] = number of ones before chunk c
+        int_vector<> m_off;              // m_off[c] = offset of the payload of chunk c in m_data
+        bit_vector   m_data;             // payloads of the chunks
+        int_vector<> m_rank_samples;     // m_rank_samples[b] = first chunk c with m_end[c] >= b*2^m_rank_shift
+        int_vector<> m_select_samples;   // m_select_samples[b] = chunk of the one with rank b*2^m_select_shift
+
+        enum { enc_run = 0, enc_bitmap = 1, enc_ef = 2 };
+
+        // a decoded entry of the top level
+        struct chunk_t {
+            size_type base; // first position covered by the chunk
+            size_type u;    // number of covered positions
+            size_type k;    // number of ones
+            size_type cnt;  // number of ones before the chunk
+            size_type off;  // offset of the payload in m_data
+            uint8_t   enc;  // encoding
+            uint8_t   wl;   // width of the low parts of an Elias-Fano chunk
+        };
+
+        //! Width of the low parts of an Elias-Fano chunk with k ones in [0..u).
+        static uint8_t ef_width(size_type k, size_type u)
+        {
+            return u > k ? bits::hi(u/k) : 0;
+        }
+
+        //! Size of an Elias-Fano chunk with k ones in [0..u); the low parts are followed by the high parts.
+        static size_type ef_bits(size_type k, size_type u)
+        {
+            uint8_t wl = ef_width(k, u);
+            return k*wl + k + ((u-1)>>wl) + 1;
+        }
+
+        //! Payload size of a chunk with k ones in [0..u), where the ones span `span` positions.
+        static size_type payload_bits(size_type k, size_type u, size_type span)
+        {
+            return span == k ? 0 : std::min(u, ef_bits(k, u));
+        }
+
+        //! Partitions the sorted positions `pos` of the ones into chunks; m_size has to be set.
+        void build(const int_vector<>& pos);
+
+        size_type chunks()const
+        {
+            return m_end.size();
+        }
+
+        chunk_t chunk(size_type c)const
+        {
+            chunk_t ch;
+            ch.base = c ? m_end[c-1]+1 : 0;
+            ch.u    = m_end[c] - ch.base + 1;
+            ch.cnt  = m_cnt[c];
+            ch.k    = (c+1 < chunks() ? m_cnt[c+1] : m_ones) - ch.cnt;
+            ch.off  = m_off[c];
+            size_type len = m_off[c+1] - ch.off;
+            ch.enc  = len == 0 ? enc_run : (ch.u <= ef_bits(ch.k, ch.u) ? enc_bitmap : enc_ef);
+            ch.wl   = ef_width(ch.k, ch.u);
+            return ch;
+        }
+
+        //! First chunk c with m_end[c] >= i or chunks() if there is none; i <= size().
+        size_type chunk_of_pos(size_type i)const
+        {
+            size_type b = i >> m_rank_shift;
+            size_type lb = m_rank_samples[b], rb = m_rank_samples[b+1];
+            while (lb < rb) {
+                size_type mid = (lb+rb)/2;
+                if (m_end[mid] < i) {
+                    lb = mid+1;
+                } else {
+                    rb = mid;
+                }
+            }
+            return lb;
+        }
+
+        //! Chunk which contains the one with rank j; j < m_ones.
+        size_type chunk_of_one(size_type j)const
+        {
+            size_type b = j >> m_select_shift;
+            size_type lb = m_select_samples[b], rb = m_select_samples[b+1];
+            while (lb < rb) {
+                size_type mid = (lb+rb+1)/2;
+                if (m_cnt[mid] <= j) {
+                    lb = mid;
+                } else {
+                    rb = mid-1;
+                }
+            }
+            return lb;
+        }
+
+        //! Number of zeros before chunk c; c <= chunks().
+        size_type zeros_before(size_type c)const
+        {
+            size_type base = c ? m_end[c-1]+1 : 0;
+            return base - (c < chunks() ? m_cnt[c] : m_ones);
+        }
+
+        //! Position of the t-th one (t>0) in m_data at or after position a; the one has to exist.
+        size_type data_select1(size_type a, size_type t)const
+        {
+            const uint64_t* d = m_data.data() + (a>>6);
+            uint64_t x = *d & bits::lo_unset[a&63];
+            size_type c = bits::cnt(x);
+            while (c < t) {
+                t -= c;
+                x = *(++d);
+                c = bits::cnt(x);
+            }
+            return ((d - m_data.data())<<6) + bits::sel(x, t);
+        }
+
+        //! Position of the t-th zero (t>0) in m_data at or after position a; the zero has to exist.
+        size_type data_select0(size_type a, size_type t)const
+        {
+            const uint64_t* d = m_data.data() + (a>>6);
+            uint64_t x = ~*d & bits::lo_unset[a&63];
+            size_type c = bits::cnt(x);
+            while (c < t) {
+                t -= c;
+                x = ~*(++d);
+                c = bits::cnt(x);
+            }
+            return ((d - m_data.data())<<6) + bits::sel(x, t);
+        }
+
+        //! Number of ones in m_data[a..b).
+        size_type data_ones(size_type a, size_type b)const
+        {
+            const uint64_t* d = m_data.data();
+            size_type res = 0;
+            while (a < b) {
+                size_type len = std::min((size_type)64 - (a&63), b-a);
+                res += bits::cnt((d[a>>6] >> (a&63)) & bits::lo_set[len]);
+                a += len;
+            }
+            return res;
+        }
+
+        //! Low part of the t-th element of an Elias-Fano chunk.
+        uint64_t ef_low(const chunk_t& ch, size_type t)const
+        {
+            if (ch.wl == 0) {
+                return 0;
+            }
+            size_type p = ch.off + t*ch.wl;
+            return bits::read_int(m_data.data() + (p>>6), p&63, ch.wl);
+        }
+
+        //! Number of ones before x in an Elias-Fano chunk; q is set to the position
+        //! in m_data where the high part of the next one is inserted.
+        size_type ef_rank(const chunk_t& ch, size_type x, size_type& q)const
+        {
+            const size_type hoff = ch.off + ch.k*ch.wl;
+            const size_type h = x >> ch.wl;
+            q = h ? data_select0(hoff, h)+1 : hoff;
+            size_type t = q - hoff - h;
+            const uint64_t xl = x & bits::lo_set[ch.wl];
+            while (t < ch.k and m_data[q] and ef_low(ch, t) < xl) {
+                ++t; ++q;
+            }
+            return t;
+        }
+
+        //! Number of ones before x < ch.u in chunk ch.
+        size_type chunk_rank(const chunk_t& ch, size_type x)const
+        {
+            if (ch.enc == enc_run) {
+                return x > ch.u-ch.k ? x-(ch.u-ch.k) : 0;
+            } else if (ch.enc == enc_bitmap) {
+                return data_ones(ch.off, ch.off+x);
+            }
+            size_type q;
+            return ef_rank(ch, x, q);
+        }
+
+        //! Relative position of the t-th one (t < ch.k, 0-based) in chunk ch.
+        size_type chunk_select(const chunk_t& ch, size_type t)const
+        {
+            if (ch.enc == enc_run) {
+                return ch.u-ch.k+t;
+            } else if (ch.enc == enc_bitmap) {
+                return data_select1(ch.off, t+1)-ch.off;
+            }
+            const size_type hoff = ch.off + ch.k*ch.wl;
+            size_type p = data_select1(hoff, t+1)-hoff;
+            return ((p-t)<<ch.wl) | ef_low(ch, t);
+        }
+
+        //! Relative position of the first one at or after x < ch.u in chunk ch.
+        size_type chunk_next(const chunk_t& ch, size_type x)const
+        {
+            if (ch.enc == enc_run) {
+                return std::max(x, ch.u-ch.k);
+            } else if (ch.enc == enc_bitmap) {
+                return data_select1(ch.off+x, 1)-ch.off;
+            }
+            size_type q;
+            size_type t = ef_rank(ch, x, q);
+            const size_type hoff = ch.off + ch.k*ch.wl;
+            size_type p = data_select1(q, 1)-hoff;
+            return ((p-t)<<ch.wl) | ef_low(ch, t);
+        }
+
+        //! Relative position of the j-th zero (j > 0) in chunk ch.
+        size_type chunk_select0(const chunk_t& ch, size_type j)const
+        {
+            if (ch.enc == enc_run) {
+                return j-1;
+            } else if (ch.enc == enc_bitmap) {
+                return data_select0(ch.off, j)-ch.off;
+            }
+            // number of ones before the j-th zero; the t-th one is preceded by chunk_select(t)-t zeros
+            size_type lb = 0, rb = ch.k;
+            while (lb < rb) {
+                size_type mid = (lb+rb)/2;
+                if (chunk_select(ch, mid)-mid < j) {
+                    lb = mid+1;
+                } else {
+                    rb = mid;
+                }
+            }
+            return j-1+lb;
+        }
+
+        //! Number of ones in [0..i).
+        size_type rank1(size_type i)const
+        {
+            if (m_ones == 0) {
+                return 0;
+            }
+            size_type c = chunk_of_pos(i);
+            if (c == chunks()) {
+                return m_ones;
+            }
+            chunk_t ch = chunk(c);
+            return ch.cnt + chunk_rank(ch, i-ch.base);
+        }
+
+        //! Position of the j-th one; j in [1..m_ones].
+        size_type select1(size_type j)const
+        {
+            chunk_t ch = chunk(chunk_of_one(j-1));
+            return ch.base + chunk_select(ch, j-1-ch.cnt);
+        }
+
+        //! Position of the j-th zero; j in [1..size()-m_ones].
+        size_type select0(size_type j)const
+        {
+            // last chunk c with zeros_before(c) < j; chunks() stands for the zeros after the last one
+            size_type lb = 0, rb = chunks();
+            while (lb < rb) {
+                size_type mid = (lb+rb+1)/2;
+                if (zeros_before(mid) < j) {
+                    lb = mid;
+                } else {
+                    rb = mid-1;
+                }
+            }
+            if (lb == chunks()) {
+                return (lb ? m_end[lb-1]+1 : 0) + j-1 - zeros_before(lb);
+            }
+            chunk_t ch = chunk(lb);
+            return ch.base + chunk_select0(ch, j-zeros_before(lb));
+        }
+
+    public:
+        pef_vector() { }
+
+        pef_vector(const bit_vector& bv)
+        {
+            m_size = bv.size();
+            int_vector<> pos(util::cnt_one_bits(bv), 0, m_size ? bits::hi(m_size)+1 : 1);
+            const uint64_t* bvp = bv.data();
+            for (size_type i=0, mm=0; i < (m_size+63)/64; ++i) {
+                uint64_t w = bvp[i];
+                if ((i+1)*64 > m_size) {
+                    w &= bits::lo_set[m_size-i*64];
+                }
+                while (w) {
+                    pos[mm++] = i*64 + bits::lo(w);
+                    w &= w-1;
+                }
+            }
+            build(pos);
+        }
+
+        template<class t_itr>
+        pef_vector(const t_itr begin, const t_itr end)
+        {
+            if (begin == end) {
+                return;
+            }
+            if (! std::is_sorted(begin,end)) {
+                throw std::runtime_error("pef_vector: source list is not sorted.");
+            }
+            m_size = *(end-1)+1;
+            int_vector<> pos(std::distance(begin,end), 0, bits::hi(m_size)+1);
+            size_type mm = 0;
+            for (auto itr = begin; itr != end; ++itr) {
+                if (mm > 0 and (size_type)*itr == pos[mm-1]) {
+                    throw std::runtime_error("pef_vector: source list contains duplicates.");
+                }
+                pos[mm++] = *itr;
+            }
+            build(pos);
+        }
+
+        pef_vector(pef_vector_builder& builder)
+        {
+            if (builder.items() != builder.capacity()) {
+                throw std::runtime_error("pef_vector: the builder is not full.");
+            }
+            m_size = builder.m_size;
+            build(builder.m_pos);
+            builder = pef_vector_builder();
+        }
+
+        //! Accessing the i-th element of the original bit_vector
+        /*! \param i An index i with \f$ 0 \leq i < size()  \f$.
+         *  \return The i-th bit of the original bit_vector
+         *  \par Time complexity
+         *     \f$ \Order{\log c} \f$ for the chunk search, where c is the
+         *     number of chunks between two rank samples, and a scan of
+         *     one payload.
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(i < m_size);
+            if (m_ones == 0) {
+                return 0;
+            }
+            size_type c = chunk_of_pos(i);
+            if (c == chunks()) {
+                return 0;
+            }
+            chunk_t ch = chunk(c);
+            size_type x = i - ch.base;
+            if (ch.enc == enc_run) {
+                return x >= ch.u-ch.k;
+            } else if (ch.enc == enc_bitmap) {
+                return m_data[ch.off+x];
+            }
+            return chunk_next(ch, x) == x;
+        }
+
+        //! Get the integer value of the binary string of length len starting at position idx.
+        /*! \param idx Starting index of the binary representation of the integer.
+         *  \param len Length of the binary representation of the integer. Default value is 64.
+         *   \returns The integer value of the binary string of length len starting at position idx.
+         *
+         *  \pre idx+len-1 in [0..size()-1]
+         *  \pre len in [1..64]
+         */
+        uint64_t get_int(size_type idx, uint8_t len=64)const
+        {
+            assert(idx+len-1 < m_size);
+            uint64_t res = 0;
+            for (size_type p = successor(idx); p < idx+len; p = successor(p+1)) {
+                res |= 1ULL << (p-idx);
+            }
+            return res;
+        }
+
+        //! Position of the first one at or after position i.
+        /*! \param i A position.
+         *  \return The smallest position j >= i with a one, or size() if there is none.
+         */
+        size_type successor(size_type i)const
+        {
+            if (i >= m_size or m_ones == 0) {
+                return m_size;
+            }
+            size_type c = chunk_of_pos(i);
+            if (c == chunks()) {
+                return m_size;
+            }
+            chunk_t ch = chunk(c);
+            return ch.base + chunk_next(ch, i-ch.base);
+        }
+
+        //! Position of the last one at or before position i.
+        /*! \param i A position; values >= size() are treated as size()-1.
+         *  \return The largest position j <= i with a one, or size() if there is none.
+         */
+        size_type predecessor(size_type i)const
+        {
+            if (m_ones == 0) {
+                return m_size;
+            }
+            i = std::min(i, m_size-1);
+            size_type c = chunk_of_pos(i);
+            if (c == chunks()) {
+                return m_end[c-1];
+            }
+            if (m_end[c] == i) {
+                return i;
+            }
+            chunk_t ch = chunk(c);
+            size_type r = chunk_rank(ch, i-ch.base+1);
+            if (r > 0) {
+                return ch.base + chunk_select(ch, r-1);
+            }
+            return c ? m_end[c-1] : m_size;
+        }
+
+        //! Returns the size of the original bit vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_ones, out, child, "ones");
+            written_bytes += write_member(m_rank_shift, out, child, "rank_shift");
+            written_bytes += write_member(m_select_shift, out, child, "select_shift");
+            written_bytes += m_end.serialize(out, child, "end");
+            written_bytes += m_cnt.serialize(out, child, "cnt");
+            written_bytes += m_off.serialize(out, child, "off");
+            written_bytes += m_data.serialize(out, child, "data");
+            written_bytes += m_rank_samples.serialize(out, child, "rank_samples");
+            written_bytes += m_select_samples.serialize(out, child, "select_samples");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            read_member(m_ones, in);
+            read_member(m_rank_shift, in);
+            read_member(m_select_shift, in);
+            m_end.load(in);
+            m_cnt.load(in);
+            m_off.load(in);
+            m_data.load(in);
+            m_rank_samples.load(in);
+            m_select_samples.load(in);
+        }
+
+        void swap(pef_vector& v)
+        {
+            if (this != &v) {
+                std::swap(m_size, v.m_size);
+                std::swap(m_ones, v.m_ones);
+                std::swap(m_rank_shift, v.m_rank_shift);
+                std::swap(m_select_shift, v.m_select_shift);
+                m_end.swap(v.m_end);
+                m_cnt.swap(v.m_cnt);
+                m_off.swap(v.m_off);
+                m_data.swap(v.m_data);
+                m_rank_samples.swap(v.m_rank_samples);
+                m_select_samples.swap(v.m_select_samples);
+            }
+        }
+
+        iterator begin() const
+        {
+            return iterator(this, 0);
+        }
+
+        iterator end() const
+        {
+            return iterator(this, size());
+        }
+};
+
+//! Rank support for pef_vector; the ones of the chunks are counted by the vector itself.
+template<uint8_t t_b>
+class rank_support_pef
+{
+        static_assert(t_b == 1 or t_b == 0 , "rank_support_pef only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef pef_vector            bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+    public:
+
+        rank_support_pef(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the number of occurrences of the bit pattern in [0..i).
+        size_type rank(size_type i) const
+        {
+            assert(m_v != nullptr);
+            assert(i <= m_v->size());
+            if (t_b) return m_v->rank1(i);
+            return i - m_v->rank1(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return rank(i);
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        rank_support_pef& operator=(const rank_support_pef& rs)
+        {
+            if (this != &rs) {
+                set_vector(rs.m_v);
+            }
+            return *this;
+        }
+
+        void swap(rank_support_pef&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+//! Select support for pef_vector; the select samples are part of the vector.
+template<uint8_t t_b>
+class select_support_pef
+{
+        static_assert(t_b == 1 or t_b == 0 , "select_support_pef only supports bitpatterns 0 or 1.");
+    public:
+        typedef bit_vector::size_type size_type;
+        typedef pef_vector            bit_vector_type;
+        enum { bit_pat = t_b };
+        enum { bit_pat_len = (uint8_t)1 };
+    private:
+        const bit_vector_type* m_v;
+
+    public:
+
+        select_support_pef(const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        //! Returns the position of the i-th occurrence in the bit vector.
+        size_type select(size_type i) const
+        {
+            assert(m_v != nullptr);
+            assert(i > 0);
+            if (t_b) return m_v->select1(i);
+            return m_v->select0(i);
+        }
+
+        size_type operator()(size_type i)const
+        {
+            return select(i);
+        }
+
+        size_type size()const
+        {
+            return m_v->size();
+        }
+
+        void set_vector(const bit_vector_type* v=nullptr)
+        {
+            m_v = v;
+        }
+
+        select_support_pef& operator=(const select_support_pef& ss)
+        {
+            if (this != &ss) {
+                set_vector(ss.m_v);
+            }
+            return *this;
+        }
+
+        void swap(select_support_pef&) { }
+
+        void load(std::istream&, const bit_vector_type* v=nullptr)
+        {
+            set_vector(v);
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            return serialize_empty_object(out, v, name, this);
+        }
+};
+
+} // end namespace sdsl
+#endif
@@ -0,0 +1,339 @@
+/*! \file posting_list_algorithm.hpp
+    \brief posting_list_algorithm.hpp contains algorithms which intersect and
+           unite sorted lists of integers stored in an sd_vector or an enc_vector.
+*/
+#ifndef INCLUDED_SDSL_POSTING_LIST_ALGORITHM
+#define INCLUDED_SDSL_POSTING_LIST_ALGORITHM
+
+#include "int_vector.hpp"
+#include "sd_vector.hpp"
+#include "enc_vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+//! Index of the first element >= x in the sorted array a[0..n), or n.
+/*! Compares eight elements per step with AVX2, if the CPU supports it.
+ *  \pre The elements and x are smaller than 2^63.
+ */
+uint64_t
+first_geq_in_block(const uint64_t* a, uint64_t n, uint64_t x);
+
+//! A cursor which iterates over a sorted list of distinct integers.
+/*! The specializations decode the list in blocks and provide
+ *    - size():        the number of elements,
+ *    - universe():    an upper bound for the elements,
+ *    - end():         true if the cursor is behind the last element,
+ *    - value():       the current element,
+ *    - next():        moves to the next element,
+ *    - next_geq(x):   moves to the first element >= x, never backwards.
+ */
+template<class t_list>
+class list_cursor;
+
+//! Cursor over the positions of the ones of an sd_vector.
+/*! next_geq searches the current block of decoded positions. Targets
+ *  which are expected in the next block are found by decoding it, farther
+ *  targets by a rank query, which selects the bucket of the target in the
+ *  high part.
+ */
+template<class t_hi_bit_vector, class t_select_1, class t_select_0>
+class list_cursor<sd_vector<t_hi_bit_vector, t_select_1, t_select_0>>
+{
+    public:
+        typedef sd_vector<t_hi_bit_vector, t_select_1, t_select_0> list_type;
+        typedef typename list_type::size_type                       size_type;
+        enum { block_size = 64 };
+    private:
+        const list_type*                                                      m_v;
+        rank_support_sd<1, t_hi_bit_vector, t_select_1, t_select_0>          m_rank;
+        size_type m_size = 0; // number of ones
+        size_type m_idx  = 0; // index of the first element of the block
+        size_type m_pos  = 0; // position of the current element in the block
+        size_type m_len  = 0; // number of elements of the block
+        uint64_t  m_skip = 0; // expected distance covered by a block
+        uint64_t  m_buf[block_size];
+
+        void fill(size_type i)
+        {
+            m_idx = i;
+            m_pos = 0;
+            m_len = std::min((size_type)block_size, m_size-i);
+            if (m_len > 0) {
+                m_v->decode(i, m_len, m_buf);
+            }
+        }
+
+    public:
+        list_cursor(const list_type& v) : m_v(&v), m_rank(&v), m_size(v.low.size())
+        {
+            m_skip = m_size ? block_size*(v.size()/m_size) : 0;
+            fill(0);
+        }
+
+        size_type size()const { return m_size; }
+        size_type universe()const { return m_v->size(); }
+        bool end()const { return m_len == 0; }
+        uint64_t value()const { return m_buf[m_pos]; }
+
+        void next()
+        {
+            if (++m_pos == m_len) {
+                fill(m_idx+m_len);
+            }
+        }
+
+        void next_geq(uint64_t x)
+        {
+            if (end() or value() >= x) {
+                return;
+            }
+            if (x <= m_buf[m_len-1]) {
+                m_pos += first_geq_in_block(m_buf+m_pos, m_len-m_pos, x);
+            } else if (x >= m_v->size()) {
+                fill(m_size);
+            } else if (x - m_buf[m_len-1] <= m_skip) {
+                fill(m_idx+m_len);
+                next_geq(x);
+            } else {
+                fill(m_rank(x));
+            }
+        }
+};
+
+//! Cursor over the elements of an enc_vector which stores a strictly increasing sequence.
+/*! next_geq searches the current block of decoded elements and gallops
+ *  over the samples to farther targets, so only the block of the target
+ *  is decoded.
+ */
+template<class t_coder, uint32_t t_dens, uint8_t t_width>
+class list_cursor<enc_vector<t_coder, t_dens, t_width>>
+{
+    public:
+        typedef enc_vector<t_coder, t_dens, t_width> list_type;
+        typedef typename list_type::size_type        size_type;
+        enum { block_size = t_dens };
+    private:
+        const list_type* m_v;
+        size_type m_size   = 0; // number of elements
+        size_type m_blocks = 0; // number of samples
+        size_type m_block  = 0; // index of the current block
+        size_type m_pos    = 0; // position of the current element in the block
+        size_type m_len    = 0; // number of elements of the block
+        uint64_t  m_buf[block_size];
+
+        void fill(size_type b)
+        {
+            m_block = b;
+            m_pos   = 0;
+            m_len   = b < m_blocks ? std::min((size_type)block_size, m_size-b*block_size) : 0;
+            if (m_len > 0) {
+                m_v->get_inter_sampled_values(b, m_buf);
+                const uint64_t s = m_v->sample(b);
+                for (size_type j=0; j < m_len; ++j) {
+                    m_buf[j] += s;
+                }
+            }
+        }
+
+    public:
+        list_cursor(const list_type& v) : m_v(&v), m_size(v.size()),
+            m_blocks((v.size()+block_size-1)/block_size)
+        {
+            fill(0);
+        }
+
+        size_type size()const { return m_size; }
+        size_type universe()const { return m_size ? (*m_v)[m_size-1]+1 : 0; }
+        bool end()const { return m_len == 0; }
+        uint64_t value()const { return m_buf[m_pos]; }
+
+        void next()
+        {
+            if (++m_pos == m_len) {
+                fill(m_block+1);
+            }
+        }
+
+        void next_geq(uint64_t x)
+        {
+            if (end() or value() >= x) {
+                return;
+            }
+            if (x <= m_buf[m_len-1]) {
+                m_pos += first_geq_in_block(m_buf+m_pos, m_len-m_pos, x);
+                return;
+            }
+            // gallop to the last block lb with sample(lb) < x
+            size_type lb = m_block+1;
+            if (lb >= m_blocks or m_v->sample(lb) >= x) {
+                fill(lb);
+                return;
+            }
+            size_type rb = lb+1;
+            for (size_type step=1; rb < m_blocks and m_v->sample(rb) < x; step <<= 1) {
+                lb = rb;
+                rb = lb+2*step;
+            }
+            rb = std::min(rb, m_blocks);
+            while (rb-lb > 1) {
+                size_type mid = lb+(rb-lb)/2;
+                if (m_v->sample(mid) < x) {
+                    lb = mid;
+                } else {
+                    rb = mid;
+                }
+            }
+            fill(lb);
+            m_pos = first_geq_in_block(m_buf, m_len, x);
+            if (m_pos == m_len) {
+                fill(lb+1);
+            }
+        }
+};
+
+//! Width of the int_vector which stores elements of a list with the given universe.
+inline uint8_t _list_width(uint64_t universe)
+{
+    return universe > 1 ? bits::hi(universe-1)+1 : 1;
+}
+
+//! Intersects sorted lists of distinct integers.
+/*!
+ * \param lists Pointers to the lists, e.g. sd_vectors or enc_vectors.
+ * \return The elements which occur in all lists, in increasing order.
+ *
+ * The lists are ordered by increasing length. A candidate is taken from
+ * the shortest list and looked up in the other lists in this order with
+ * next_geq, i.e. by a search in the decoded block or a skip over the
+ * samples. If a list does not contain the candidate, its next element
+ * becomes the new candidate and the search restarts at the shortest list.
+ * Long lists are therefore only touched at the candidates of the short
+ * ones and the running time adapts to the size of the shortest list.
+ *
+ * \par Time complexity
+ *      \f$ \Order{m \cdot k \cdot t_{skip}} \f$, where m is the length of
+ *      the shortest list, k the number of lists and t_{skip} the time of
+ *      next_geq.
+ */
+template<class t_list>
+int_vector<>
+intersect_lists(const std::vector<const t_list*>& lists)
+{
+    typedef list_cursor<t_list> cursor_type;
+    int_vector<> res;
+    if (lists.empty()) {
+        return res;
+    }
+    std::vector<cursor_type> c;
+    c.reserve(lists.size());
+    for (auto l : lists) {
+        c.emplace_back(*l);
+    }
+    std::vector<cursor_type*> p;
+    for (auto& x : c) {
+        p.push_back(&x);
+    }
+    std::sort(p.begin(), p.end(), [](const cursor_type* a, const cursor_type* b) {
+        return a->size() < b->size();
+    });
+    res = int_vector<>(p[0]->size(), 0, _list_width(p[0]->universe()));
+
+    typename cursor_type::size_type k = 0;
+    uint64_t x = 0;
+    bool done = false;
+    while (!done) {
+        p[0]->next_geq(x);
+        if (p[0]->end()) {
+            break;
+        }
+        x = p[0]->value();
+        size_t i = 1;
+        for (; i < p.size(); ++i) {
+            p[i]->next_geq(x);
+            if (p[i]->end()) {
+                done = true;
+                break;
+            }
+            if (p[i]->value() != x) {
+                x = p[i]->value();
+                break;
+            }
+        }
+        if (i == p.size()) {
+            res[k++] = x++;
+        }
+    }
+    res.resize(k);
+    return res;
+}
+
+//! Unites sorted lists of distinct integers.
+/*!
+ * \param lists Pointers to the lists, e.g. sd_vectors or enc_vectors.
+ * \return The elements which occur in at least one list, in increasing order.
+ *
+ * The lists are merged with a heap of their current elements; a list
+ * stays on top as long as its elements are not larger than the next
+ * element of the heap, so runs are copied without heap operations.
+ *
+ * \par Time complexity
+ *      \f$ \Order{n \log k} \f$, where n is the total length of the k lists.
+ */
+template<class t_list>
+int_vector<>
+unite_lists(const std::vector<const t_list*>& lists)
+{
+    typedef list_cursor<t_list>                  cursor_type;
+    typedef std::pair<uint64_t, size_t>          entry_type;
+    int_vector<> res;
+    if (lists.empty()) {
+        return res;
+    }
+    std::vector<cursor_type> c;
+    c.reserve(lists.size());
+    typename cursor_type::size_type total = 0;
+    uint64_t universe = 0;
+    for (auto l : lists) {
+        c.emplace_back(*l);
+        total += c.back().size();
+        universe = std::max(universe, (uint64_t)c.back().universe());
+    }
+    res = int_vector<>(total, 0, _list_width(universe));
+
+    std::priority_queue<entry_type, std::vector<entry_type>, std::greater<entry_type>> q;
+    for (size_t i=0; i < c.size(); ++i) {
+        if (!c[i].end()) {
+            q.emplace(c[i].value(), i);
+        }
+    }
+    typename cursor_type::size_type k = 0;
+    while (!q.empty()) {
+        size_t i = q.top().second;
+        q.pop();
+        uint64_t bound = q.empty() ? (uint64_t)-1 : q.top().first;
+        cursor_type& ci = c[i];
+        do {
+            if (k == 0 or res[k-1] != ci.value()) {
+                res[k++] = ci.value();
+            }
+            ci.next();
+        } while (!ci.end() and ci.value() <= bound);
+        if (!ci.end()) {
+            q.emplace(ci.value(), i);
+        }
+    }
+    res.resize(k);
+    return res;
+}
+
+} // end namespace sdsl
+
+#endif
@@ -0,0 +1,130 @@
+/*! \file query_context.hpp
+    \brief query_context.hpp contains a per-thread cache for queries on a shared CSA or CST.
+*/
+#ifndef INCLUDED_SDSL_QUERY_CONTEXT
+#define INCLUDED_SDSL_QUERY_CONTEXT
+
+#include "sdsl_concepts.hpp"
+#include "fast_cache.hpp"
+#include <type_traits>
+
+namespace sdsl
+{
+
+//! Cache of one thread for queries on a shared CSA or CST.
+/*! The CSA and CST classes are immutable after construction or load, so
+ *  any number of threads can call const methods of one index object at
+ *  the same time. Mutable state which speeds up a sequence of queries
+ *  lives in a query_context instead. Each thread owns its own context.
+ *  A context must not be shared between threads, but it may outlive
+ *  many queries.
+ *
+ *  \tparam t_index A CSA (index_category csa_tag) or a CST (cst_tag).
+ *  \tparam t_cache Cache type, e.g. sdsl::assoc_cache.
+ *  \par Example
+ *  \code
+ *  std::vector<query_context<cst_sct3<>>> ctx(64, query_context<cst_sct3<>>(cst));
+ *  parallel_for(n, 64, [&](uint64_t i, uint64_t t) {
+ *      sum[t] += ctx[t].lcp(i);
+ *  });
+ *  \endcode
+ */
+template<class t_index, class t_cache = assoc_cache<>>
+class query_context
+{
+    public:
+        typedef t_index                            index_type;
+        typedef t_cache                            cache_type;
+        typedef typename t_index::size_type        size_type;
+        typedef typename t_index::csa_type         csa_type;
+        typedef typename t_index::index_category   index_category;
+
+    private:
+        const t_index* m_idx = nullptr;
+        t_cache        m_sa_cache;
+        t_cache        m_isa_cache;
+        t_cache        m_psi_cache;
+        t_cache        m_lcp_cache;
+
+        static const csa_type& _csa(const t_index& idx, csa_tag)
+        {
+            return idx;
+        }
+
+        static const csa_type& _csa(const t_index& idx, cst_tag)
+        {
+            return idx.csa;
+        }
+
+    public:
+        //! Creates an empty cache for queries on idx.
+        /*! \param idx      The index.
+         *  \param capacity Minimal number of entries of each of the SA, ISA, PSI and LCP caches.
+         */
+        explicit query_context(const t_index& idx, size_type capacity=CACHE_SIZE+1) :
+            m_idx(&idx), m_sa_cache(capacity), m_isa_cache(capacity),
+            m_psi_cache(capacity), m_lcp_cache(capacity) {}
+
+        //! The index of the context.
+        const t_index& index() const
+        {
+            return *m_idx;
+        }
+
+        //! The CSA of the index, i.e. the index itself or the CSA of a CST.
+        const csa_type& csa() const
+        {
+            return _csa(*m_idx, index_category());
+        }
+
+        //! Returns SA[i]; recent answers are cached.
+        size_type sa(size_type i)
+        {
+            return m_sa_cache.fetch(i, [this](size_type j) { return csa()[j]; });
+        }
+
+        //! Returns ISA[i]; recent answers are cached.
+        size_type isa(size_type i)
+        {
+            return m_isa_cache.fetch(i, [this](size_type j) { return csa().isa[j]; });
+        }
+
+        //! Returns PSI[i]; recent answers are cached.
+        size_type psi(size_type i)
+        {
+            return m_psi_cache.fetch(i, [this](size_type j) { return csa().psi[j]; });
+        }
+
+        //! Returns LCP[i] of a CST; recent answers are cached.
+        size_type lcp(size_type i)
+        {
+            static_assert(std::is_same<index_category, cst_tag>::value,
+                          "query_context::lcp requires a CST");
+            return m_lcp_cache.fetch(i, [this](size_type j) { return m_idx->lcp[j]; });
+        }
+
+        //! Number of queries answered from the caches.
+        size_type hits() const
+        {
+            return m_sa_cache.hits() + m_isa_cache.hits() + m_psi_cache.hits() + m_lcp_cache.hits();
+        }
+
+        //! Number of queries which were not answered from the caches.
+        size_type misses() const
+        {
+            return m_sa_cache.misses() + m_isa_cache.misses() + m_psi_cache.misses() + m_lcp_cache.misses();
+        }
+
+        //! Forgets all cached answers, e.g. after the index was reloaded.
+        void clear()
+        {
+            m_sa_cache.clear();
+            m_isa_cache.clear();
+            m_psi_cache.clear();
+            m_lcp_cache.clear();
+        }
+};
+
+} // end namespace sdsl
+
+#endif
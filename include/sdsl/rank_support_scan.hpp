@@ -97,6 +97,13 @@ inline typename rank_support_scan<t_b, t_pat_len>::size_type rank_support_scan<t
     const uint64_t* p   = m_v->data();
     size_type       i   = 0;
     size_type   result  = 0;
+    if (1 == t_pat_len) { // count the full words with the multi-word popcount
+        i      = (idx>>6)<<6;
+        result = bits::cnt(p, idx>>6);
+        if (0 == t_b) {
+            result = i - result;
+        }
+    }
     while (i+64 <= idx) {
         result += rank_support_trait<t_b, t_pat_len>::full_word_rank(p, i);
         i += 64;
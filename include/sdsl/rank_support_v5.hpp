@@ -61,6 +61,8 @@ class rank_support_v5 : public rank_support
     private:
 //      basic block for interleaved storage of superblockrank and blockrank
         int_vector<64> m_basic_block;
+        // number of queries rank_batch prefetches ahead
+        static const size_type rank_batch_dist = 16;
     public:
         explicit rank_support_v5(const bit_vector* v = nullptr) {
             set_vector(v);
@@ -136,6 +138,31 @@ class rank_support_v5 : public rank_support
         inline size_type operator()(size_type idx)const {
             return rank(idx);
         }
+
+        //! Prefetches the data which is accessed by rank(idx).
+        void prefetch(size_type idx)const {
+            SDSL_PREFETCH(m_basic_block.data() + ((idx>>10)&0xFFFFFFFFFFFFFFFEULL));
+            SDSL_PREFETCH(m_v->data() + (idx>>6) - ((idx>>6)&0x1FULL)%6);
+            SDSL_PREFETCH(m_v->data() + (idx>>6));
+        }
+
+        //! Answers n independent rank queries.
+        /*! \param idx Array of n positions.
+         *  \param n   Number of queries.
+         *  \param out Array of size n. out[i] = rank(idx[i]).
+         *
+         *  The counts and the words of the block of the query
+         *  rank_batch_dist positions ahead are prefetched, so
+         *  that the cache misses of independent queries overlap.
+         */
+        void rank_batch(const size_type* idx, size_type n, size_type* out)const {
+            for (size_type i=0; i < n; ++i) {
+                if (i + rank_batch_dist < n) {
+                    prefetch(idx[i+rank_batch_dist]);
+                }
+                out[i] = rank(idx[i]);
+            }
+        }
         size_type size()const {
             return m_v->size();
         }
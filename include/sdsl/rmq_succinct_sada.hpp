@@ -30,6 +30,7 @@
 #include "util.hpp"
 #include <utility> // for pair
 #include <stack>
+#include <vector>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -88,6 +89,9 @@ class rmq_succinct_sada
 
         typedef rmq_succinct_sct<t_min> rmq_construct_helper_type;
 
+        // number of queries of a group in rmq_batch
+        static const size_t rmq_batch_size = 32;
+
         // helper class for the construction
         struct state {
             size_type l, r;  // left and right interval
@@ -224,6 +228,51 @@ class rmq_succinct_sada
             return m_ect_bp_rank10(f-1);
         }
 
+        //! Answers a batch of independent range minimum/maximum queries.
+        /*!
+         * \param q Vector of intervals \f$[\ell..r]\f$ with \f$ \ell \leq r < size() \f$.
+         * \return Vector res with res[k] = (*this)(q[k].first, q[k].second).
+         *
+         * The queries are processed in groups of rmq_batch_size. Each step of
+         * a query (select of `10`, rmq on the BPS, rank of `10`) is done for
+         * all queries of the group before the next step starts, so the cache
+         * misses of different queries overlap. The bit vector words needed by
+         * the next step are prefetched.
+         */
+        std::vector<size_type> rmq_batch(const std::vector<std::pair<size_type, size_type>>& q)const {
+            std::vector<size_type> res(q.size());
+            size_type x[rmq_batch_size], y[rmq_batch_size], act[rmq_batch_size];
+            for (size_type b=0; b < q.size(); b += rmq_batch_size) {
+                const size_type m = std::min((size_type)rmq_batch_size, q.size()-b);
+                size_type n_act = 0;
+                // (1) positions of the `10` patterns of l and r
+                for (size_type k=0; k < m; ++k) {
+                    const size_type l = q[b+k].first, r = q[b+k].second;
+                    assert(l <= r); assert(r < size());
+                    res[b+k] = l;
+                    if (l < r) {
+                        x[k] = m_ect_bp_select10(l+1);
+                        y[k] = m_ect_bp_select10(r+1);
+                        SDSL_PREFETCH(m_ect_bp.data() + (x[k]>>6));
+                        act[n_act++] = k;
+                    }
+                }
+                // (2) minimal excess between them
+                for (size_type a=0; a < n_act; ++a) {
+                    const size_type k = act[a];
+                    x[k] = m_ect_bp_support.rmq(x[k], y[k]);
+                    SDSL_PREFETCH(m_ect_bp.data() + (x[k]>>6));
+                }
+                // (3) index of the corresponding `10` pattern
+                for (size_type a=0; a < n_act; ++a) {
+                    const size_type k = act[a];
+                    const size_type f = x[k] + 1 - 2*(m_ect_bp[x[k]]);
+                    res[b+k] = m_ect_bp_rank10(f-1);
+                }
+            }
+            return res;
+        }
+
         size_type size()const {
             return m_ect_bp.size()/4;
         }
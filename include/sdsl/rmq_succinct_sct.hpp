@@ -26,6 +26,8 @@
 #include "bp_support_sada.hpp"
 #include "suffix_tree_helper.hpp"
 #include "util.hpp"
+#include <utility> // for pair
+#include <vector>
 
 //! Namespace for the succinct data structure library.
 namespace sdsl
@@ -62,6 +64,9 @@ class rmq_succinct_sct
             m_sct_bp_support.set_vector(&m_sct_bp);
         }
 
+        // number of queries of a group in rmq_batch
+        static const size_t rmq_batch_size = 32;
+
     public:
         typedef typename bit_vector::size_type size_type;
         typedef typename bit_vector::size_type value_type;
@@ -156,6 +161,66 @@ class rmq_succinct_sct
             }
         }
 
+        //! Answers a batch of independent range minimum/maximum queries.
+        /*!
+         * \param q Vector of intervals \f$[\ell..r]\f$ with \f$ \ell \leq r < size() \f$.
+         * \return Vector res with res[k] = (*this)(q[k].first, q[k].second).
+         *
+         * The queries are processed in groups of rmq_batch_size. Each step of
+         * a query (select, find_close, rr_enclose, rank) is done for all
+         * queries of the group before the next step starts, so the cache
+         * misses of different queries overlap. The bit vector words needed
+         * by the next step are prefetched.
+         */
+        std::vector<size_type> rmq_batch(const std::vector<std::pair<size_type, size_type>>& q)const {
+            std::vector<size_type> res(q.size());
+            size_type i[rmq_batch_size], j[rmq_batch_size], act[rmq_batch_size];
+            for (size_type b=0; b < q.size(); b += rmq_batch_size) {
+                const size_type m = std::min((size_type)rmq_batch_size, q.size()-b);
+                size_type n_act = 0;
+                // (1) opening parentheses of l and r
+                for (size_type k=0; k < m; ++k) {
+                    const size_type l = q[b+k].first, r = q[b+k].second;
+                    assert(l <= r); assert(r < size());
+                    res[b+k] = l;
+                    if (l < r) {
+                        i[k] = m_sct_bp_support.select(l+1);
+                        j[k] = m_sct_bp_support.select(r+1);
+                        SDSL_PREFETCH(m_sct_bp.data() + (i[k]>>6));
+                        act[n_act++] = k;
+                    }
+                }
+                // (2) l is the answer if j is enclosed by i
+                size_type n_next = 0;
+                for (size_type a=0; a < n_act; ++a) {
+                    const size_type k = act[a];
+                    if (j[k] > m_sct_bp_support.find_close(i[k])) {
+                        SDSL_PREFETCH(m_sct_bp.data() + (j[k]>>6));
+                        act[n_next++] = k;
+                    }
+                }
+                n_act = n_next;
+                // (3) range restricted enclosing pair or r
+                n_next = 0;
+                for (size_type a=0; a < n_act; ++a) {
+                    const size_type k = act[a];
+                    i[k] = m_sct_bp_support.rr_enclose(i[k], j[k]);
+                    if (i[k] == m_sct_bp_support.size()) {
+                        res[b+k] = q[b+k].second;
+                    } else {
+                        SDSL_PREFETCH(m_sct_bp.data() + (i[k]>>6));
+                        act[n_next++] = k;
+                    }
+                }
+                // (4) index of the enclosing pair
+                for (size_type a=0; a < n_next; ++a) {
+                    const size_type k = act[a];
+                    res[b+k] = m_sct_bp_support.rank(i[k])-1;
+                }
+            }
+            return res;
+        }
+
         size_type size()const {
             return m_sct_bp.size()/2;
         }
@@ -36,6 +36,12 @@ class rmq_support_sparse_table;
 template<class t_rac = int_vector<> >
 using range_maximum_support_sparse_table = rmq_support_sparse_table<t_rac,false>;
 
+template<class t_rac = int_vector<>, bool t_min=true>
+class rmq_support_sparse_table_blocked;
+
+template<class t_rac = int_vector<> >
+using range_maximum_support_sparse_table_blocked = rmq_support_sparse_table_blocked<t_rac,false>;
+
 
 //! A class to support range minimum or range maximum queries on a random access container.
 /*!
@@ -79,7 +85,7 @@ class rmq_support_sparse_table
             if (m_v == nullptr)
                 return;
             const size_type n = m_v->size();
-            if (n < 2)  // for n<2 the queries could be answerd without any table
+            if (n < 3)  // for n<3 the queries could be answerd without any table
                 return;
             size_type k=0;
             while (2*(1ULL<<k) < n) ++k;  // calculate maximal
@@ -198,5 +204,190 @@ class rmq_support_sparse_table
         }
 };
 
+//! A cache-friendly variant of rmq_support_sparse_table for small ranges.
+/*!
+ * \tparam t_rac Type of random access container for which the structure should be build.
+ * \tparam t_min        Specifies whether the data structure should answer range min/max queries (mimumum=true)
+ *
+ * The container is divided into blocks of 64 elements. For each position
+ * r a word stores the positions i in the block of r with \f$ i \leq r \f$
+ * and \f$ v[i] \leq v[j] \f$ for all \f$ i < j \leq r \f$, i.e. the stack
+ * of the Cartesian tree construction. A query inside a block is answered
+ * by the lowest set bit \f$ \geq \ell \f$ of the word of r, i.e. with
+ * one memory access and without accessing the container. The minima of
+ * the blocks are supported by a sparse table over the blocks. A query
+ * spanning several blocks needs about twice as many memory accesses as
+ * one of rmq_support_sparse_table, but the structure is much smaller.
+ *
+ * \par Time complexity
+ *        \f$ \Order{1} \f$ for the range minimum/maximum queries.
+ * \par Space complexity:
+ *      \f$ 64n + \Order{\frac{n}{64}\log^2 n} \f$ bits for the data structure ( \f$ n=size() \f$ ).
+ */
+template<class t_rac, bool t_min>
+class rmq_support_sparse_table_blocked
+{
+        const t_rac*              m_v;       // pointer to the supported random access container
+        int_vector<64>            m_stack;   // in-block Cartesian tree stack of each position
+        bit_vector::size_type     m_k;       // size of m_table
+        std::vector<int_vector<>> m_table;   // m_table[i][j] = position of the min/max of blocks [j..j+2^i)
+        typedef min_max_trait<t_rac, t_min> mm_trait;
+
+        void copy(const rmq_support_sparse_table_blocked& rm)
+        {
+            m_v = rm.m_v;
+            m_stack = rm.m_stack;
+            m_k = rm.m_k;
+            m_table = rm.m_table;
+        }
+
+        // the leftmost of the minimal/maximal positions p1 < p2
+        bit_vector::size_type select_pos(bit_vector::size_type p1, bit_vector::size_type p2)const
+        {
+            return mm_trait::compare((*m_v)[p1], (*m_v)[p2]) ? p1 : p2;
+        }
+
+        // position of the min/max of the blocks [l..r]
+        bit_vector::size_type block_rmq(bit_vector::size_type l, bit_vector::size_type r)const
+        {
+            if (l == r)
+                return m_table[0][l];
+            bit_vector::size_type k = bits::hi(r-l);
+            return select_pos(m_table[k][l], m_table[k][r-(1ULL<<k)+1]);
+        }
+
+    public:
+        typedef typename t_rac::size_type size_type;
+        typedef typename t_rac::size_type value_type;
+
+        rmq_support_sparse_table_blocked(const t_rac* v=nullptr):m_v(v), m_k(0)
+        {
+            if (m_v == nullptr)
+                return;
+            const size_type n = m_v->size();
+            m_stack = int_vector<64>(n);
+            const size_type blocks = (n+63)/64;
+            const uint8_t width = bits::hi(n)+1;
+            size_type k=1; // levels for the blocks between the first and the last block of a query
+            while (blocks > 2 and (1ULL<<k) <= blocks-2) ++k;
+            m_table.resize(k);
+            m_k = k;
+            m_table[0] = int_vector<>(blocks, 0, width);
+            uint64_t stack = 0;
+            for (size_type i=0; i < n; ++i) {
+                if ((i & 0x3F) == 0)
+                    stack = 0;
+                while (stack and mm_trait::strict_compare((*m_v)[i], (*m_v)[(i & ~0x3FULL) + bits::hi(stack)]))
+                    stack ^= 1ULL << bits::hi(stack);
+                stack |= 1ULL << (i & 0x3F);
+                m_stack[i] = stack;
+                if ((i & 0x3F) == 0x3F or i+1 == n)
+                    m_table[0][i>>6] = (i & ~0x3FULL) + bits::lo(stack);
+            }
+            for (size_type i=1; i < k; ++i) {
+                m_table[i] = int_vector<>(blocks-(1ULL<<i)+1, 0, width);
+                for (size_type j=0; j<m_table[i].size(); ++j) {
+                    m_table[i][j] = select_pos(m_table[i-1][j], m_table[i-1][j+(1ULL<<(i-1))]);
+                }
+            }
+        }
+
+        //! Copy constructor
+        rmq_support_sparse_table_blocked(const rmq_support_sparse_table_blocked& rm)
+        {
+            copy(rm);
+        }
+
+        //! Move constructor
+        rmq_support_sparse_table_blocked(rmq_support_sparse_table_blocked&& rm)
+        {
+            *this = std::move(rm);
+        }
+
+        rmq_support_sparse_table_blocked& operator=(const rmq_support_sparse_table_blocked& rm)
+        {
+            if (this != &rm) {
+                copy(rm);
+            }
+            return *this;
+        }
+
+        rmq_support_sparse_table_blocked& operator=(rmq_support_sparse_table_blocked&& rm)
+        {
+            if (this != &rm) {
+                m_v = rm.m_v;
+                m_stack = std::move(rm.m_stack);
+                m_k = rm.m_k;
+                m_table = std::move(rm.m_table);
+            }
+            return *this;
+        }
+
+        void swap(rmq_support_sparse_table_blocked& rm)
+        {
+            m_stack.swap(rm.m_stack);
+            std::swap(m_k, rm.m_k);
+            m_table.swap(rm.m_table);
+        }
+
+        void set_vector(const t_rac* v)
+        {
+            m_v = v;
+        }
+
+        //! Range minimum/maximum query for the supported random access container v.
+        /*!
+         * \param l Leftmost position of the interval \f$[\ell..r]\f$.
+         * \param r Rightmost position of the interval \f$[\ell..r]\f$.
+         * \return The minimal index i with \f$\ell \leq i \leq r\f$ for which \f$ v[i] \f$ is minimal/maximal.
+         * \pre
+         *   - r < size()
+         *   - \f$ \ell \leq r \f$
+         * \par Time complexity
+         *      \f$ \Order{1} \f$
+         */
+        size_type operator()(const size_type l, const size_type r)const
+        {
+            assert(l <= r); assert(r < size());
+            const size_type bl = l>>6, br = r>>6;
+            if (bl == br)
+                return l + bits::lo(m_stack[r] >> (l & 0x3F));
+            size_type res = l + bits::lo(m_stack[(bl<<6)+63] >> (l & 0x3F));
+            if (bl+1 < br)
+                res = select_pos(res, block_rmq(bl+1, br-1));
+            return select_pos(res, (br<<6) + bits::lo(m_stack[r]));
+        }
+
+        size_type size()const
+        {
+            if (m_v == nullptr)
+                return 0;
+            else
+                return m_v->size();
+        }
+
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            size_type written_bytes = 0;
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            written_bytes += m_stack.serialize(out, child, "stack");
+            written_bytes += write_member(m_k, out, child, "k");
+            for (size_type i=0; i < m_k; ++i)
+                written_bytes += m_table[i].serialize(out, child, "table");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        void load(std::istream& in, const t_rac* v)
+        {
+            set_vector(v);
+            m_stack.load(in);
+            read_member(m_k, in);
+            m_table.resize(m_k);
+            for (size_type i=0; i < m_k; ++i)
+                m_table[i].load(in);
+        }
+};
+
 }// end namespace sds;
 #endif
@@ -169,6 +169,98 @@ class sd_vector
             m_high_0_select.set_vector(&m_high);
         }
 
+        // reads up to 64 bits of m_high starting at position i
+        uint64_t high_word(size_type i)const
+        {
+            return m_high.get_int(i, std::min((size_type)64, m_high.size()-i));
+        }
+
+        // number of consecutive ones in m_high starting at position i
+        size_type high_ones_from(size_type i)const
+        {
+            size_type cnt = 0;
+            while (i < m_high.size()) {
+                uint64_t w = ~high_word(i);
+                if (w) {
+                    return cnt + bits::lo(w);
+                }
+                cnt += 64; i += 64;
+            }
+            return cnt;
+        }
+
+        // number of consecutive ones in m_high ending at position i-1
+        size_type high_ones_before(size_type i)const
+        {
+            size_type cnt = 0;
+            while (i > 0) {
+                size_type len = std::min((size_type)64, i);
+                uint64_t w = ~m_high.get_int(i-len, len) & bits::lo_set[len];
+                if (w) {
+                    return cnt + len-1-bits::hi(w);
+                }
+                cnt += len; i -= len;
+            }
+            return cnt;
+        }
+
+        // position of the first one in m_high at or after position i; the one has to exist
+        size_type high_next_one(size_type i)const
+        {
+            uint64_t w;
+            while (!(w = high_word(i)))
+                i += 64;
+            return i + bits::lo(w);
+        }
+
+        // position of the last one in m_high before position i; the one has to exist
+        size_type high_prev_one(size_type i)const
+        {
+            while (true) {
+                size_type len = std::min((size_type)64, i);
+                uint64_t w = m_high.get_int(i-len, len) & bits::lo_set[len];
+                if (w) {
+                    return i-len + bits::hi(w);
+                }
+                i -= len;
+            }
+        }
+
+        // number of elements of the sorted sequence m_low[a..a+c) which are smaller than v < 2^wl.
+        // Up to 64/wl low parts are compared at once: a field x is >= v iff
+        // the top bit of x is set and that of v not, or the top bits are equal
+        // and the top bit of (x|2^(wl-1)) - (v mod 2^(wl-1)) is set.
+        size_type low_count_less(size_type a, size_type c, size_type v)const
+        {
+            size_type res = 0;
+            if (c > 1 and m_wl <= 32) {
+                const size_type f = 64 / m_wl; // fields per word
+                uint64_t lo = 1;               // lowest bit of each field
+                for (size_type s = m_wl; s < 64; s <<= 1)
+                    lo |= lo << s;
+                lo &= bits::lo_set[f*m_wl];
+                const uint64_t hi = lo << (m_wl-1);
+                const uint64_t vv = v * lo;
+                const uint64_t* data = m_low.data();
+                size_type off = a * m_wl;
+                while (c > 0) {
+                    const size_type k = std::min(f, c);
+                    const uint64_t x  = bits::read_int(data + (off>>6), off & 0x3F, k*m_wl);
+                    const uint64_t d  = (x | hi) - (vv & ~hi);
+                    const uint64_t ge = ((x & ~vv) | (~(x ^ vv) & d)) & hi & bits::lo_set[k*m_wl];
+                    const size_type lt = k - bits::cnt(ge);
+                    res += lt;
+                    if (lt < k)
+                        break;
+                    c -= k; off += k*m_wl;
+                }
+                return res;
+            }
+            for (; c > 0 and m_low[a] < v; ++a, --c)
+                ++res;
+            return res;
+        }
+
     public:
         const uint8_t&               wl            = m_wl;
         const hi_bit_vector_type&    high          = m_high;
@@ -358,6 +450,94 @@ class sd_vector
             }
         }
 
+        //! Returns the position of the first one at or after position i.
+        /*! \param i A position.
+         *  \return The smallest position \f$ j \geq i \f$ with B[j]=1, or size() if there is none.
+         *  \par Time complexity
+         *       \f$ \Order{t_{select0} + k \cdot wl/64} \f$, where k is the number of
+         *       ones with the same high part as i.
+         *
+         *  The select structure for the zeros of HI serves as skip pointers
+         *  to the ones with the high part of i. The low parts of these ones
+         *  are compared with the low part of i word by word.
+         */
+        size_type successor(size_type i)const
+        {
+            if (i >= m_size or m_low.empty())
+                return m_size;
+            const size_type high_val = i >> m_wl;
+            size_type sel_high = high_val ? m_high_0_select(high_val) + 1 : 0;
+            size_type rank_low = sel_high - high_val;
+            size_type cnt = high_ones_from(sel_high);
+            size_type lt  = low_count_less(rank_low, cnt, i & bits::lo_set[m_wl]);
+            if (lt < cnt)
+                return (high_val << m_wl) + m_low[rank_low+lt];
+            rank_low += cnt;
+            if (rank_low == m_low.size())
+                return m_size;
+            sel_high = high_next_one(sel_high + cnt);
+            return ((sel_high - rank_low) << m_wl) + m_low[rank_low];
+        }
+
+        //! Returns the position of the last one at or before position i.
+        /*! \param i A position.
+         *  \return The largest position \f$ j \leq i \f$ with B[j]=1, or size() if there is none.
+         *  \par Time complexity
+         *       \f$ \Order{t_{select0} + k \cdot wl/64} \f$, where k is the number of
+         *       ones with the same high part as i.
+         */
+        size_type predecessor(size_type i)const
+        {
+            if (m_low.empty())
+                return m_size;
+            if (i >= m_size)
+                i = m_size-1;
+            const size_type high_val = i >> m_wl;
+            const size_type val_low  = i & bits::lo_set[m_wl];
+            size_type sel_high = m_high_0_select(high_val + 1);
+            size_type cnt = high_ones_before(sel_high);
+            size_type rank_low = sel_high - high_val - cnt;
+            size_type le = (val_low == bits::lo_set[m_wl]) ? cnt : low_count_less(rank_low, cnt, val_low+1);
+            if (le > 0)
+                return (high_val << m_wl) + m_low[rank_low+le-1];
+            if (rank_low == 0)
+                return m_size;
+            --rank_low;
+            sel_high = high_prev_one(sel_high - cnt);
+            return ((sel_high - rank_low) << m_wl) + m_low[rank_low];
+        }
+
+        //! Decodes the positions of a range of ones.
+        /*! \param i   Number of ones before the range, i.e. the first decoded one is the (i+1)-th.
+         *  \param n   Number of decoded ones; \f$ i+n \f$ is at most the number of ones.
+         *  \param out Array of size n; out[k] is the position of the (i+k+1)-th one.
+         *  \par Time complexity
+         *       \f$ \Order{t_{select1} + n + z/64} \f$, where z is the number of
+         *       zeros of HI between the decoded ones.
+         *
+         *  After one select, HI and the low parts are read sequentially word by word.
+         */
+        void decode(size_type i, size_type n, size_type* out)const
+        {
+            if (n == 0)
+                return;
+            assert(i+n <= m_low.size());
+            size_type pos = m_high_1_select(i+1);
+            uint64_t w = high_word(pos);
+            const uint64_t* low_data = m_low.data();
+            size_type low_off = i * m_wl;
+            for (size_type k=0; k < n; ++k, ++i) {
+                while (!w) {
+                    pos += 64;
+                    w = high_word(pos);
+                }
+                out[k] = ((pos + bits::lo(w) - i) << m_wl)
+                         + bits::read_int(low_data + (low_off>>6), low_off & 0x3F, m_wl);
+                w &= w-1;
+                low_off += m_wl;
+            }
+        }
+
         //! Swap method
         void swap(sd_vector& v)
         {
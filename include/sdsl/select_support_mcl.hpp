@@ -96,6 +96,16 @@ class select_support_mcl : public select_support
         inline size_type select(size_type i) const;
         //! Alias for select(i).
         inline size_type operator()(size_type i)const;
+        //! Answers n independent select queries.
+        /*! \param i   Array of n arguments in [1..number of set bits].
+         *  \param n   Number of queries.
+         *  \param out Array of size n. out[k] = select(i[k]).
+         *
+         *  The samples and the bit vector word of queries ahead
+         *  are prefetched in two stages, so that the cache misses
+         *  of independent queries overlap.
+         */
+        void select_batch(const size_type* i, size_type n, size_type* out)const;
         size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const;
         void load(std::istream& in, const bit_vector* v=nullptr);
         void set_vector(const bit_vector* v=nullptr);
@@ -398,6 +408,49 @@ inline auto select_support_mcl<t_b,t_pat_len>::operator()(size_type i)const -> s
     return select(i);
 }
 
+template<uint8_t t_b, uint8_t t_pat_len>
+void select_support_mcl<t_b,t_pat_len>::select_batch(const size_type* i, size_type n, size_type* out)const
+{
+    const size_type dist = 4; // distance between the prefetch stages
+    auto prefetch_entry = [](const int_vector<0>& v, size_type k) {
+        SDSL_PREFETCH(v.data() + ((k*v.width())>>6));
+    };
+    auto is_long = [&](size_type sb_idx) {
+        return m_longsuperblock!=nullptr and !m_longsuperblock[sb_idx].empty();
+    };
+    for (size_type k=0; k < n; ++k) {
+        // (1) prefetch the samples of the superblock
+        if (k + 3*dist < n) {
+            size_type sb_idx = (i[k+3*dist]-1)>>12;
+            prefetch_entry(m_superblock, sb_idx);
+            SDSL_PREFETCH(m_miniblock + sb_idx);
+            if (m_longsuperblock != nullptr) {
+                SDSL_PREFETCH(m_longsuperblock + sb_idx);
+            }
+        }
+        // (2) prefetch the answer or the sample of the miniblock
+        if (k + 2*dist < n) {
+            size_type j = i[k+2*dist]-1;
+            size_type sb_idx = j>>12;
+            if (is_long(sb_idx)) {
+                prefetch_entry(m_longsuperblock[sb_idx], j&0xFFF);
+            } else {
+                prefetch_entry(m_miniblock[sb_idx], (j&0xFFF)>>6);
+            }
+        }
+        // (3) prefetch the word in which the scan starts
+        if (k + dist < n) {
+            size_type j = i[k+dist]-1;
+            size_type sb_idx = j>>12;
+            if (!is_long(sb_idx)) {
+                size_type pos = m_superblock[sb_idx] + m_miniblock[sb_idx][(j&0xFFF)>>6] + 1;
+                SDSL_PREFETCH(m_v->data() + (pos>>6));
+            }
+        }
+        out[k] = select(i[k]);
+    }
+}
+
 template<uint8_t t_b, uint8_t t_pat_len>
 void select_support_mcl<t_b,t_pat_len>::initData()
 {
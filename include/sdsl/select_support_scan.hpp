@@ -49,6 +49,7 @@ class select_support_scan : public select_support
     public:
         typedef bit_vector bit_vector_type;
         enum { bit_pat = t_b };
+        enum { bit_pat_len = t_pat_len };
     public:
         explicit select_support_scan(const bit_vector* v=nullptr) : select_support(v) {}
         select_support_scan(const select_support_scan<t_b,t_pat_len>& ss) : select_support(ss.m_v) {}
@@ -92,6 +93,21 @@ inline typename select_support_scan<t_b,t_pat_len>::size_type select_support_sca
     }
     word_pos+=1;
     size_type sum_args = args;
+    if (1 == t_pat_len) { // skip blocks of 8 words with the multi-word popcount
+        const uint64_t* end = m_v->data() + (m_v->capacity()>>6);
+        while (data+9 <= end) {
+            size_type block_args = bits::cnt(data+1, 8);
+            if (0 == t_b) {
+                block_args = 512 - block_args;
+            }
+            if (sum_args + block_args >= i) {
+                break;
+            }
+            sum_args += block_args;
+            data     += 8;
+            word_pos += 8;
+        }
+    }
     carry = select_support_trait<t_b,t_pat_len>::get_carry(*data);
     uint64_t old_carry = carry;
     args = select_support_trait<t_b,t_pat_len>::args_in_the_word(*(++data), carry);
@@ -22,7 +22,9 @@
 #define INCLUDED_SDSL_SUFFIX_ARRAY_ALGORITHM
 
 #include <iterator>
+#include <vector>
 #include "suffix_array_helper.hpp"
+#include "parallel_helper.hpp"
 
 namespace sdsl
 {
@@ -238,6 +240,81 @@ backward_search(
     return r+1-l;
 }
 
+//! Prefetches the data accessed first by csa.bwt.rank(i, c), if the wavelet tree supports it.
+template<class t_csa>
+auto _prefetch_bwt_rank(const t_csa& csa, typename t_csa::size_type i, int)
+-> decltype(csa.wavelet_tree.prefetch(i), void())
+{
+    csa.wavelet_tree.prefetch(i);
+}
+
+template<class t_csa>
+void _prefetch_bwt_rank(const t_csa&, typename t_csa::size_type, long) {}
+
+//! Backward search for many patterns in the CSA.
+/*!
+ * \tparam t_csa     CSA type.
+ * \tparam t_pat_vec Random access container of patterns. Each pattern
+ *                   provides random access iterators begin() and end().
+ *
+ * \param csa   The CSA object.
+ * \param pats  The patterns.
+ * \param l_res l_res[i] will contain the left border of the interval of pats[i].
+ * \param r_res r_res[i] will contain the right border of the interval of pats[i].
+ *
+ * The result equals the one of backward_search(csa, 0, csa.size()-1, ...)
+ * for each pattern. The patterns are advanced in lockstep: each round
+ * prepends one character to every pattern which still has a non-empty
+ * interval. The rank queries of different patterns are independent, so
+ * their cache misses overlap. In addition, the first wavelet tree node
+ * accessed by the pattern `dist` positions ahead in the round is
+ * prefetched, if the wavelet tree supports it (see wt_pc::prefetch).
+ *
+ * \par Time complexity
+ *       \f$ \Order{ \sum_i |pats[i]| \cdot t_{rank\_bwt} } \f$
+ */
+template<class t_csa, class t_pat_vec>
+void backward_search_batch(
+    const t_csa& csa,
+    const t_pat_vec& pats,
+    std::vector<typename t_csa::size_type>& l_res,
+    std::vector<typename t_csa::size_type>& r_res,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typedef typename t_csa::size_type size_type;
+    const size_type dist = 8; // prefetch distance in patterns
+    const size_type m = pats.size();
+    l_res.assign(m, 0);
+    r_res.assign(m, csa.size()-1);
+    std::vector<size_type> rest(m); // length of the unprocessed pattern prefix
+    std::vector<size_type> active;
+    for (size_type i=0; i < m; ++i) {
+        rest[i] = std::distance(pats[i].begin(), pats[i].end());
+        if (rest[i] > 0) {
+            active.push_back(i);
+        }
+    }
+    while (!active.empty()) {
+        size_type k = 0;
+        for (size_type j=0; j < active.size(); ++j) {
+            if (j + dist < active.size()) {
+                size_type p = active[j+dist];
+                _prefetch_bwt_rank(csa, l_res[p], 0);
+                _prefetch_bwt_rank(csa, r_res[p]+1, 0);
+            }
+            size_type p = active[j];
+            --rest[p];
+            auto c = (typename t_csa::char_type)*(pats[p].begin()+rest[p]);
+            backward_search(csa, l_res[p], r_res[p], c, l_res[p], r_res[p]);
+            if (rest[p] > 0 and r_res[p]+1-l_res[p] > 0) {
+                active[k++] = p;
+            }
+        }
+        active.resize(k);
+    }
+}
+
 //! Bidirectional search for a character c on an interval \f$[l_fwd..r_fwd]\f$ of the suffix array.
 /*!
  * \param csa_fwd   The CSA object of the forward text in which the backward_search should be done.
@@ -475,6 +552,38 @@ typename t_csx::size_type count(
     return count(csx, pat.begin(), pat.end(), tag);
 }
 
+//! Counts the number of occurrences of many patterns in a CSA.
+/*!
+ * \tparam t_csa     CSA type.
+ * \tparam t_pat_vec Random access container of patterns.
+ *
+ * \param csa  The CSA object.
+ * \param pats The patterns.
+ * \return A vector whose i-th entry is the number of occurrences of pats[i].
+ *
+ * \par Time complexity
+ *        \f$ \Order{ t_{backward\_search\_batch} } \f$
+ * \sa backward_search_batch
+ */
+template<class t_csa, class t_pat_vec>
+std::vector<typename t_csa::size_type> count_batch(
+    const t_csa& csa,
+    const t_pat_vec& pats,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typedef typename t_csa::size_type size_type;
+    std::vector<size_type> l_res, r_res;
+    backward_search_batch(csa, pats, l_res, r_res);
+    std::vector<size_type> res(pats.size(), 0);
+    for (size_type i=0; i < pats.size(); ++i) {
+        if ((size_type)std::distance(pats[i].begin(), pats[i].end()) <= csa.size()) {
+            res[i] = r_res[i]+1-l_res[i];
+        }
+    }
+    return res;
+}
+
 //! Calculates all occurrences of a pattern pat in a CSA.
 /*!
  * \tparam t_csa      CSA type.
@@ -530,6 +639,117 @@ t_rac locate(
     return locate<t_csx, decltype(pat.begin()), t_rac>(csx, pat.begin(), pat.end(), tag);
 }
 
+//! Generic step of an SA walk: calculates csa[i] directly.
+/*!
+ * csa_wt and csa_sada provide overloads which perform one LF or Psi step
+ * per call, so that locate_par can interleave the walks of several positions.
+ * \return True if the walk is finished, i.e. res contains the SA value.
+ */
+template<class t_csa>
+bool _sa_walk_step(const t_csa& csa, int_vector<>::size_type& i, int_vector<>::size_type&, int_vector<>::size_type& res)
+{
+    res = csa[i];
+    return true;
+}
+
+//! Calculates occ[j] = csa[sa_begin+j] for j in [b..e).
+/*!
+ * Up to `slots` walks are in flight at once. Each round advances every
+ * active walk by one step. As the steps of different walks are independent,
+ * their cache misses overlap. A finished walk is replaced by the walk of
+ * the next position.
+ */
+template<class t_csa, class t_rac>
+void _locate_interleaved(const t_csa& csa, typename t_csa::size_type sa_begin,
+                         typename t_csa::size_type b, typename t_csa::size_type e, t_rac& occ)
+{
+    typedef int_vector<>::size_type size_type;
+    const size_type slots = 16;
+    size_type pos[slots], cur[slots], off[slots];
+    size_type active = 0;
+    for (; active < slots and b < e; ++active, ++b) {
+        pos[active] = b; cur[active] = sa_begin+b; off[active] = 0;
+    }
+    while (active > 0) {
+        for (size_type s=0; s < active;) {
+            size_type res;
+            if (_sa_walk_step(csa, cur[s], off[s], res)) {
+                occ[pos[s]] = res;
+                if (b < e) {
+                    pos[s] = b; cur[s] = sa_begin+b; off[s] = 0;
+                    ++b; ++s;
+                } else {
+                    --active;
+                    pos[s] = pos[active]; cur[s] = cur[active]; off[s] = off[active];
+                }
+            } else {
+                ++s;
+            }
+        }
+    }
+}
+
+//! Calculates all occurrences of a pattern pat in a CSA using several threads.
+/*!
+ * \tparam t_csa      CSA type.
+ * \tparam t_pat_iter Pattern iterator type.
+ * \tparam t_rac      Resizeable random access container.
+ *
+ * \param csa     The CSA object.
+ * \param begin   Iterator to the begin of the pattern (inclusive).
+ * \param end     Iterator to the end of the pattern (exclusive).
+ * \param threads Number of threads.
+ * \return A vector containing the occurrences of the pattern in the CSA.
+ *         The result equals the one of locate.
+ *
+ * The SA interval of the pattern is split into blocks which are processed
+ * concurrently. Inside a block the LF (csa_wt) or Psi (csa_sada) walks of
+ * 16 positions are interleaved, see _locate_interleaved. The block size is
+ * a multiple of 64, so threads never write to the same word of a bit-compressed
+ * t_rac.
+ *
+ * \par Time complexity
+ *        \f$ \Order{ t_{backward\_search} + z \cdot t_{SA} / threads } \f$, where \f$z\f$ is the number of
+ *         occurrences of pattern in the CSA.
+ */
+template<class t_csa, class t_pat_iter, class t_rac=int_vector<64>>
+t_rac locate_par(
+    const t_csa&  csa,
+    t_pat_iter begin,
+    t_pat_iter end,
+    uint64_t threads,
+    SDSL_UNUSED typename std::enable_if<std::is_same<csa_tag, typename t_csa::index_category>::value, csa_tag>::type x = csa_tag()
+)
+{
+    typedef typename t_csa::size_type size_type;
+    size_type occ_begin, occ_end, occs;
+    occs = backward_search(csa, 0, csa.size()-1, begin, end, occ_begin, occ_end);
+    t_rac occ(occs);
+    const size_type block = 1024;
+    parallel_for((occs+block-1)/block, threads, [&](uint64_t j, uint64_t) {
+        _locate_interleaved(csa, occ_begin, j*block, std::min(occs, (j+1)*block), occ);
+    });
+    return occ;
+}
+
+//! Calculates all occurrences of a pattern pat in a CSA/CST using several threads.
+/*!
+ * \param csx     The CSA/CST object.
+ * \param pat     The pattern.
+ * \param threads Number of threads.
+ * \sa locate_par
+ */
+template<class t_csx, class t_rac=int_vector<64>>
+t_rac locate_par(
+    const t_csx&  csx,
+    const typename t_csx::string_type& pat,
+    uint64_t threads
+)
+{
+    typename t_csx::index_category tag;
+    return locate_par<t_csx, decltype(pat.begin()), t_rac>(csx, pat.begin(), pat.end(), threads, tag);
+}
+
 
 //! Writes the substring T[begin..end] of the original text T to text[0..end-begin+1].
 /*!
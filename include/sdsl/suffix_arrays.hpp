@@ -30,7 +30,9 @@
 #include "csa_sada.hpp"
 #include "wavelet_trees.hpp"
 #include "construct.hpp"
+#include "construct_merge.hpp"
 #include "suffix_array_algorithm.hpp"
+#include "query_context.hpp"
 
 namespace sdsl
 {
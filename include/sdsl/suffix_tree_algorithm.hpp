@@ -21,7 +21,11 @@
 #ifndef INCLUDED_SDSL_SUFFIX_TREE_ALGORITHM
 #define INCLUDED_SDSL_SUFFIX_TREE_ALGORITHM
 
+#include <deque>
 #include <iterator>
+#include <queue>
+#include <tuple>
+#include <vector>
 #include "suffix_array_algorithm.hpp"
 
 namespace sdsl
@@ -155,6 +159,22 @@ t_rac locate(
     return locate(cst.csa, begin, end);
 }
 
+//! Calculates all occurrences of a pattern pat in a CST using several threads.
+/*!
+ * \sa locate_par for CSAs.
+ */
+template<class t_cst, class t_pat_iter, class t_rac=int_vector<64>>
+t_rac locate_par(
+    const t_cst& cst,
+    t_pat_iter begin,
+    t_pat_iter end,
+    uint64_t threads,
+    SDSL_UNUSED typename std::enable_if<std::is_same<cst_tag, typename t_cst::index_category>::value, cst_tag>::type x = cst_tag()
+)
+{
+    return locate_par(cst.csa, begin, end, threads);
+}
+
 //! Calculate the concatenation of edge labels from the root to the node v of a CST.
 /*!
  * \tparam t_cst       CST type.
@@ -274,6 +294,181 @@ std::pair<double,size_t> Hk(const t_cst& cst, typename t_cst::size_type k)
     return {hk,context};
 }
 
+//! Splits a CST into independent subtrees for a parallel traversal.
+/*!
+ * \param cst   The suffix tree.
+ * \param parts Desired number of subtrees.
+ * \param top   Filled with the expanded nodes. top[k].first is a node and
+ *              top[k].second the indexes of its children in `top` (expanded
+ *              nodes) or ~index in the result (subtrees), in child order.
+ *              Parents precede their children; top[0] is the root.
+ * \return      The roots of the subtrees in depth first order.
+ *
+ * The largest subtree is expanded as long as there are less than `parts`
+ * subtrees and it contains more than 1/parts of the leaves.
+ */
+template<class t_cst>
+std::vector<typename t_cst::node_type>
+cst_split(const t_cst& cst, typename t_cst::size_type parts,
+          std::vector<std::pair<typename t_cst::node_type, std::vector<int64_t>>>& top)
+{
+    using size_type = typename t_cst::size_type;
+    using node_type = typename t_cst::node_type;
+    top.clear();
+    std::vector<node_type> sub;
+    if (cst.size() == 0)
+        return sub;
+    // candidate subtrees: (leaves, index in `top`, position in parent's child list)
+    typedef std::tuple<size_type, size_type, size_type> cand_type;
+    std::priority_queue<cand_type> pq;
+    std::vector<node_type> open; // nodes of the current candidates
+    auto expand = [&](size_type k) {
+        for (const auto& c : cst.children(top[k].first)) {
+            top[k].second.push_back(~(int64_t)open.size());
+            if (!cst.is_leaf(c)) {
+                pq.emplace(cst.size(c), k, top[k].second.size()-1);
+            }
+            open.push_back(c);
+        }
+    };
+    if (cst.is_leaf(cst.root())) {
+        sub.push_back(cst.root());
+        return sub;
+    }
+    top.emplace_back(cst.root(), std::vector<int64_t>());
+    expand(0);
+    size_type subtrees = open.size();
+    while (!pq.empty() and subtrees < parts and std::get<0>(pq.top())*parts > cst.size()) {
+        auto x = pq.top(); pq.pop();
+        int64_t& slot = top[std::get<1>(x)].second[std::get<2>(x)];
+        node_type v = open[~slot];
+        size_type k = top.size();
+        slot = k;
+        top.emplace_back(v, std::vector<int64_t>());
+        expand(k);
+        subtrees += top[k].second.size() - 1;
+    }
+    // number the remaining subtrees in depth first order
+    std::vector<std::pair<size_type, size_type>> stack(1, {0, 0}); // (index in `top`, next child)
+    while (!stack.empty()) {
+        size_type k = stack.back().first;
+        if (stack.back().second == top[k].second.size()) {
+            stack.pop_back();
+            continue;
+        }
+        int64_t& c = top[k].second[stack.back().second++];
+        if (c >= 0) {
+            stack.emplace_back(c, 0);
+        } else {
+            sub.push_back(open[~c]);
+            c = ~(int64_t)(sub.size()-1);
+        }
+    }
+    return sub;
+}
+
+//! Calls f(v, t) for each node v of the CST using `threads` threads.
+/*!
+ * \param cst     The suffix tree.
+ * \param f       Functor f(v, t), where t in [0, threads) is the id of the
+ *                calling thread. It is called once for each node.
+ * \param threads Number of threads.
+ *
+ * The tree is split by cst_split into subtrees, which are distributed
+ * dynamically over the threads. Within a subtree the nodes are visited in
+ * depth first order; the nodes above the subtrees are visited first by the
+ * calling thread.
+ */
+template<class t_cst, class t_f>
+void dfs_par(const t_cst& cst, t_f f, uint64_t threads=hardware_threads())
+{
+    std::vector<std::pair<typename t_cst::node_type, std::vector<int64_t>>> top;
+    auto sub = cst_split(cst, 8*threads, top);
+    for (const auto& x : top) {
+        f(x.first, 0);
+    }
+    parallel_for(sub.size(), threads, [&](uint64_t k, uint64_t t) {
+        const auto& v = sub[k];
+        if (cst.is_leaf(v)) {
+            f(v, t);
+            return;
+        }
+        for (auto it = cst.begin(v), end = cst.end(v); it != end; ++it) {
+            if (it.visit() == 1) {
+                f(*it, t);
+            }
+        }
+    });
+}
+
+//! Computes an aggregate bottom-up for each node of the CST using `threads` threads.
+/*!
+ * \tparam T      Type of the aggregate; a default constructed T is the
+ *                initial aggregate of an inner node.
+ * \param cst     The suffix tree.
+ * \param leaf    Functor leaf(v, t) returning the aggregate of leaf v.
+ * \param merge   Functor merge(T& acc, const T& x) adding the aggregate x
+ *                of a child to acc. The children are merged from left to right.
+ * \param inner   Functor inner(v, T& acc, t), called for an inner node v
+ *                after all children were merged into acc, e.g. to report v.
+ *                acc is the aggregate of v afterwards.
+ * \param threads Number of threads.
+ * \return        The aggregate of the root.
+ *
+ * t in [0, threads) is the id of the calling thread. The subtrees of
+ * cst_split are processed in parallel; their aggregates are merged into the
+ * nodes above them by the calling thread.
+ */
+template<class T, class t_cst, class t_leaf, class t_merge, class t_inner>
+T bottom_up_par(const t_cst& cst, t_leaf leaf, t_merge merge, t_inner inner,
+                uint64_t threads=hardware_threads())
+{
+    using node_type = typename t_cst::node_type;
+    std::vector<std::pair<node_type, std::vector<int64_t>>> top;
+    auto sub = cst_split(cst, 8*threads, top);
+    // std::deque instead of std::vector, as std::vector<bool> packs its
+    // elements, which can neither be written concurrently nor moved
+    std::deque<T> sub_res(sub.size());
+    parallel_for(sub.size(), threads, [&](uint64_t k, uint64_t t) {
+        const auto& v = sub[k];
+        if (cst.is_leaf(v)) {
+            sub_res[k] = leaf(v, t);
+            return;
+        }
+        std::deque<T> stack; // aggregates of the inner nodes on the current path
+        for (auto it = cst.begin(v), end = cst.end(v); it != end; ++it) {
+            if (cst.is_leaf(*it)) {
+                merge(stack.back(), leaf(*it, t));
+            } else if (it.visit() == 1) {
+                stack.emplace_back();
+            } else {
+                T acc = std::move(stack.back());
+                stack.pop_back();
+                inner(*it, acc, t);
+                if (stack.empty()) {
+                    sub_res[k] = std::move(acc);
+                } else {
+                    merge(stack.back(), acc);
+                }
+            }
+        }
+    });
+    if (top.empty()) {
+        return sub.empty() ? T() : std::move(sub_res[0]);
+    }
+    // children in `top` have larger indexes than their parents
+    std::deque<T> top_res(top.size());
+    for (size_t k = top.size(); k-- > 0;) {
+        T acc = T();
+        for (auto c : top[k].second) {
+            merge(acc, c < 0 ? sub_res[~c] : top_res[c]);
+        }
+        inner(top[k].first, acc, 0);
+        top_res[k] = std::move(acc);
+    }
+    return std::move(top_res[0]);
+}
+
 
 } // end namespace
 #endif
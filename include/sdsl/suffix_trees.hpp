@@ -36,5 +36,7 @@
 #include "cst_sct3.hpp"
 #include "cst_sada.hpp"
 #include "cst_fully.hpp"
+#include "query_context.hpp"
+#include "cst_matching.hpp"
 
 #endif
@@ -50,6 +50,8 @@
 
 #ifndef MSVC_COMPILER
 #define SDSL_UNUSED __attribute__ ((unused))
+// hint the processor to load the cache line containing address p
+#define SDSL_PREFETCH(p) __builtin_prefetch((const void*)(p))
 #include <sys/time.h>  // for struct timeval
 #include <sys/resource.h> // for struct rusage
 #include <libgen.h>    // for basename
@@ -58,6 +60,7 @@
 #include <process.h>
 #include <iso646.h>
 #define SDSL_UNUSED
+#define SDSL_PREFETCH(p)
 #endif
 
 //! Namespace for the succinct data structure library.
@@ -522,12 +525,10 @@ typename t_int_vec::size_type util::cnt_one_bits(const t_int_vec& v)
     const uint64_t* data = v.data();
     if (v.empty())
         return 0;
-    typename t_int_vec::size_type result = bits::cnt(*data);
-    for (typename t_int_vec::size_type i=1; i < (v.capacity()>>6); ++i) {
-        result += bits::cnt(*(++data));
-    }
+    typename t_int_vec::size_type words = v.capacity()>>6;
+    typename t_int_vec::size_type result = bits::cnt(data, words);
     if (v.bit_size()&0x3F) {
-        result -= bits::cnt((*data) & (~bits::lo_set[v.bit_size()&0x3F]));
+        result -= bits::cnt(data[words-1] & (~bits::lo_set[v.bit_size()&0x3F]));
     }
     return result;
 }
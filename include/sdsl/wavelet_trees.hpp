@@ -36,6 +36,7 @@
 #include "wt_hutu.hpp"
 #include "wt_int.hpp"
 #include "wm_int.hpp"
+#include "wm_kary.hpp"
 #include "wt_rlmn.hpp"
 #include "wt_ap.hpp"
 #include "construct.hpp"
@@ -95,8 +95,6 @@ class wm_int
         uint32_t               m_max_level = 0;
         int_vector<64>         m_zero_cnt;     // m_zero_cnt[i] contains the number of zeros in level i
         int_vector<64>         m_rank_level;   // m_rank_level[i] contains m_tree_rank(i*size())
-        mutable int_vector<64> m_path_off;     // array keeps track of path offset in select-like methods
-        mutable int_vector<64> m_path_rank_off;// array keeps track of rank values for the offsets
 
         void copy(const wm_int& wt)
         {
@@ -112,16 +110,40 @@ class wm_int
             m_max_level     = wt.m_max_level;
             m_zero_cnt      = wt.m_zero_cnt;
             m_rank_level    = wt.m_rank_level;
-            m_path_off      = wt.m_path_off;
-            m_path_rank_off = wt.m_path_rank_off;
         }
 
     private:
 
-        void init_buffers(uint32_t max_level)
+        //! Builds the matrix level by level with multiple threads.
+        /*! The elements of buf are stored in arrays of type t_int, so that
+         *  the threads can move them concurrently. See _par_partition_level.
+         */
+        template<class t_int, uint8_t int_width>
+        void construct_par(int_vector_buffer<int_width>& buf, uint64_t threads)
         {
-            m_path_off = int_vector<64>(max_level+1);
-            m_path_rank_off = int_vector<64>(max_level+1);
+            std::vector<t_int> rac(m_size), tmp(m_size);
+            for (size_type i=0; i < m_size; ++i) {
+                rac[i] = buf[i];
+            }
+            bit_vector tree(m_size*m_max_level, 0);
+            m_zero_cnt = int_vector<64>(m_max_level, 0); // zeros at level i
+            for (uint32_t k=0; k<m_max_level; ++k) {
+                const uint64_t mask = 1ULL<<(m_max_level-k-1);
+                // each level of the matrix is partitioned as a single node
+                m_zero_cnt[k] = _par_partition_level(rac, tmp, tree, k*m_size, mask,
+                [](uint64_t) { return 0; }, threads);
+            }
+            m_sigma = std::unique(rac.begin(), rac.end()) - rac.begin();
+            std::vector<t_int>().swap(rac);
+            std::vector<t_int>().swap(tmp);
+            m_tree = bit_vector_type(std::move(tree));
+            util::init_support(m_tree_rank, &m_tree);
+            util::init_support(m_tree_select0, &m_tree);
+            util::init_support(m_tree_select1, &m_tree);
+            m_rank_level = int_vector<64>(m_max_level, 0);
+            for (uint32_t k=0; k<m_rank_level.size(); ++k) {
+                m_rank_level[k] = m_tree_rank(k*m_size);
+            }
         }
 
     public:
@@ -133,24 +155,25 @@ class wm_int
         //! Default constructor
         wm_int()
         {
-            init_buffers(m_max_level);
         };
 
         //! Semi-external constructor
         /*! \param buf         File buffer of the int_vector for which the wm_int should be build.
          *  \param size        Size of the prefix of v, which should be indexed.
          *  \param max_level   Maximal level of the wavelet tree. If set to 0, determined automatically.
+         *  \param threads     Number of threads used to build the levels of the matrix.
          *    \par Time complexity
          *        \f$ \Order{n\log|\Sigma|}\f$, where \f$n=size\f$
          *        I.e. we need \Order{n\log n} if rac is a permutation of 0..n-1.
          *    \par Space complexity
          *        \f$ n\log|\Sigma| + O(1)\f$ bits, where \f$n=size\f$.
+         *        For threads > 1 the sequence and a buffer are held in memory
+         *        as arrays of 8, 16, 32 or 64-bit integers.
          */
         template<uint8_t int_width>
         wm_int(int_vector_buffer<int_width>& buf, size_type size,
-               uint32_t max_level=0) : m_size(size)
+               uint32_t max_level=0, uint64_t threads=1) : m_size(size)
         {
-            init_buffers(m_max_level);
             if (0 == m_size)
                 return;
             size_type n = buf.size();  // set n
@@ -174,8 +197,20 @@ class wm_int
             } else {
                 m_max_level = max_level;
             }
-            init_buffers(m_max_level);
 
+            if (threads > 1) {
+                rac.resize(0);
+                if (buf.width() <= 8) {
+                    construct_par<uint8_t>(buf, threads);
+                } else if (buf.width() <= 16) {
+                    construct_par<uint16_t>(buf, threads);
+                } else if (buf.width() <= 32) {
+                    construct_par<uint32_t>(buf, threads);
+                } else {
+                    construct_par<uint64_t>(buf, threads);
+                }
+                return;
+            }
 
             std::string tree_out_buf_file_name = tmp_file(buf.filename(), "_m_tree");
             osfstream tree_out_buf(tree_out_buf_file_name, std::ios::binary | std::ios::trunc | std::ios::out);   // open buffer for tree
@@ -271,8 +306,6 @@ class wm_int
                 m_max_level     = std::move(wt.m_max_level);
                 m_zero_cnt      = std::move(wt.m_zero_cnt);
                 m_rank_level    = std::move(wt.m_rank_level);
-                m_path_off      = std::move(wt.m_path_off);
-                m_path_rank_off = std::move(wt.m_path_rank_off);
             }
             return *this;
         }
@@ -290,8 +323,6 @@ class wm_int
                 std::swap(m_max_level,  wt.m_max_level);
                 m_zero_cnt.swap(wt.m_zero_cnt);
                 m_rank_level.swap(wt.m_rank_level);
-                m_path_off.swap(wt.m_path_off);
-                m_path_rank_off.swap(wt.m_path_rank_off);
             }
         }
 
@@ -331,6 +362,16 @@ class wm_int
             return res;
         };
 
+        //! Prefetches the data which is accessed first by rank(i, c).
+        /*! The lower levels depend on the result of the first level,
+         *  so only the first level is prefetched. This hides the first
+         *  cache miss when many independent queries are interleaved.
+         */
+        void prefetch(size_type i)const
+        {
+            _prefetch(m_tree_rank, i, 0);
+        }
+
         //! Calculates how many symbols c are in the prefix [0..i-1] of the supported vector.
         /*!
          *  \param i The exclusive index of the prefix range [0..i-1], so \f$i\in[0..size()]\f$.
@@ -410,7 +451,8 @@ class wm_int
         {
             assert(1 <= i and i <= rank(size(), c));
             uint64_t mask = 1ULL << (m_max_level-1);
-            m_path_off[0] = m_path_rank_off[0] = 0;
+            size_type path_off[65], path_rank_off[65]; // path offsets and their ranks; local to keep select thread-safe
+            path_off[0] = path_rank_off[0] = 0;
             size_type b = 0; // start position of the interval
             size_type r = i;
             for (uint32_t k=0; k < m_max_level and i; ++k) {
@@ -425,13 +467,13 @@ class wm_int
                     b = (k+1)*m_size + (b - k*m_size - ones_p);
                 }
                 mask >>= 1;
-                m_path_off[k+1] = b;
-                m_path_rank_off[k] = rank_b;
+                path_off[k+1] = b;
+                path_rank_off[k] = rank_b;
             }
             mask = 1ULL;
             for (uint32_t k=m_max_level; k>0; --k) {
-                b = m_path_off[k-1];
-                size_type rank_b = m_path_rank_off[k-1];
+                b = path_off[k-1];
+                size_type rank_b = path_rank_off[k-1];
                 if (c & mask) { // right child => search i'th one
                     i = m_tree_select1(rank_b + i) - b + 1;
                 } else { // left child => search i'th zero
@@ -488,40 +530,187 @@ class wm_int
                     size_type i = j;
                     size_type c = v.sym;
                     for (uint32_t k=m_max_level; k>0; --k) {
-                        size_type offset = is[k-1];
-                        size_type rank_offset = rank_off[k-1];
-                        if (c&1) {
-                            i = m_tree_select1(rank_offset+i)-offset+1;
-                        } else {
-                            i = m_tree_select0(offset-rank_offset+i)-offset+1;
-                        }
+                        i = _r2d_to_parent(i, c&1, is[k-1], rank_off[k-1]);
                         c >>= 1;
                     }
                     point_vec.emplace_back(is[0]+i-1, v.sym);
                 }
                 cnt_answers += sdsl::size(r);
                 return;
-            } else {
-                rank_off[v.level] = m_tree_rank(is[v.level]);
             }
-            size_type irb = ilb + (1ULL << (m_max_level-v.level));
-            size_type mid = (irb + ilb)>>1;
+            _r2d_expand(v, get<0>(r), get<1>(r), ilb, vlb, vrb, rank_off[v.level],
+            [&](const node_type& c, size_type c_lb, size_type c_rb,
+                value_type c_ilb, value_type c_vlb, value_type c_vrb) {
+                _range_search_2d(c, range_type(c_lb, c_rb), c_vlb, c_vrb, c_ilb,
+                                 is, rank_off, point_vec, report, cnt_answers);
+            });
+        }
+
+        //! Counts the points in each of the rectangles.
+        /*! \param rects Rectangles [lb..rb]x[vlb..vrb].
+         *  \return res[q] equals range_search_2d(lb, rb, vlb, vrb, false).first for rects[q].
+         *
+         *  The rectangles are processed together, level by level, and the
+         *  rank data of upcoming nodes is prefetched. Nodes whose values lie
+         *  completely inside the value interval are counted without visiting
+         *  their subtrees, so no point is materialized.
+         */
+        std::vector<size_type>
+        range_count_2d_batch(const range_2d_rect_vec_type& rects) const
+        {
+            std::vector<size_type> cnt;
+            _range_2d_batch<false>(rects, cnt, nullptr);
+            return cnt;
+        }
+
+        //! Reports the points in each of the rectangles.
+        /*! \param rects Rectangles [lb..rb]x[vlb..vrb].
+         *  \return res[q] equals range_search_2d(lb, rb, vlb, vrb) for rects[q].
+         *  \sa range_count_2d_batch
+         */
+        std::vector<r2d_res_type>
+        range_search_2d_batch(const range_2d_rect_vec_type& rects) const
+        {
+            std::vector<size_type> cnt;
+            std::vector<point_vec_type> points;
+            _range_2d_batch<true>(rects, cnt, &points);
+            std::vector<r2d_res_type> res(rects.size());
+            for (size_type q=0; q < rects.size(); ++q) {
+                res[q] = r2d_res_type(cnt[q], std::move(points[q]));
+            }
+            return res;
+        }
+
+    private:
+
+        // A rectangle restricted to a node in the batched range search
+        struct r2d_task {
+            size_type  q;          // index of the rectangle
+            size_type  lb, rb;     // index interval inside the node
+            size_type  offset;     // start of the node in m_tree
+            size_type  node_size;
+            value_type ilb;        // smallest value of the node
+            value_type vlb, vrb;   // value interval inside the node
+            value_type sym;        // symbol prefix of the node
+            size_type  parent;     // parent in the path records
+        };
+
+        // Start of a visited range, needed to map leaf positions back to the sequence
+        struct r2d_path {
+            size_type is, rank_off, parent;
+        };
 
-            auto c_v = expand(v);
-            auto c_r = expand(v, r);
+        // One step of the range search: maps the interval [lb..rb] of the
+        // inner node v, whose smallest value is ilb, to the children of v and
+        // calls f(child, lb, rb, ilb, vlb, vrb) for each child which contains
+        // a part of the interval and of the value interval [vlb..vrb].
+        // rank_lb is set to the number of ones in m_tree before v.offset+lb.
+        template<class t_f>
+        void _r2d_expand(const node_type& v, size_type lb, size_type rb, value_type ilb,
+                         value_type vlb, value_type vrb, size_type& rank_lb, t_f f) const
+        {
+            size_type rank_b  = m_tree_rank(v.offset);
+            rank_lb           = m_tree_rank(v.offset + lb);
+            size_type rank_rb = m_tree_rank(v.offset + rb + 1);
+            size_type ones    = m_tree_rank(v.offset + v.size) - rank_b; // ones in [b..size)
+            size_type ones_p  = rank_b - m_rank_level[v.level];          // ones in [level_b..b)
+            size_type ones_lb = rank_lb - rank_b;                        // ones in [b..b+lb)
+            size_type ones_rb = rank_rb - rank_b;                        // ones in [b..b+rb]
+            value_type mid = ilb + (1ULL << (m_max_level-v.level-1));
+            if (vlb < mid and lb - ones_lb < rb + 1 - ones_rb) {
+                f(node_type((v.level+1)*m_size + (v.offset - v.level*m_size) - ones_p,
+                            v.size - ones, v.level+1, v.sym<<1),
+                  lb - ones_lb, rb - ones_rb, ilb, vlb, std::min(vrb, mid-1));
+            }
+            if (vrb >= mid and ones_lb < ones_rb) {
+                f(node_type((v.level+1)*m_size + m_zero_cnt[v.level] + ones_p,
+                            ones, v.level+1, (v.sym<<1)|1),
+                  ones_lb, ones_rb-1, mid, std::max(mid, vlb), vrb);
+            }
+        }
+
+        // Maps the i-th position of a child interval to the interval of the
+        // parent, which starts at position `is` of m_tree with rank_off ones before it
+        size_type _r2d_to_parent(size_type i, bool right, size_type is, size_type rank_off) const
+        {
+            if (right) {
+                return m_tree_select1(rank_off + i) - is + 1;
+            }
+            return m_tree_select0(is - rank_off + i) - is + 1;
+        }
 
-            if (!sdsl::empty(get<0>(c_r)) and  vlb < mid and mid) {
-                _range_search_2d(get<0>(c_v),get<0>(c_r), vlb,
-                                 std::min(vrb,mid-1), ilb, is, rank_off,
-                                 point_vec, report, cnt_answers);
+        template<bool t_report>
+        void _range_2d_batch(const range_2d_rect_vec_type& rects, std::vector<size_type>& cnt,
+                             std::vector<point_vec_type>* points) const
+        {
+            const size_type prefetch_dist = 8;
+            cnt.assign(rects.size(), 0);
+            if (t_report) {
+                points->assign(rects.size(), point_vec_type());
+            }
+            std::vector<r2d_task> cur, next;
+            std::vector<r2d_path> path_rec;
+            // adds task x of a node on level `level` to tasks
+            auto push = [&](std::vector<r2d_task>& tasks, r2d_task&& x, uint32_t level) {
+                value_type width = bits::lo_set[m_max_level-level]; // values of the node are [ilb..ilb+width]
+                if (!t_report and x.vlb <= x.ilb and x.ilb + width <= x.vrb) {
+                    cnt[x.q] += x.rb - x.lb + 1;
+                } else {
+                    tasks.push_back(std::move(x));
+                }
+            };
+            for (size_type q=0; q < rects.size(); ++q) {
+                const auto& r = rects[q];
+                value_type vrb = std::min(r.vrb, (value_type)bits::lo_set[m_max_level]);
+                if (r.lb <= r.rb and r.vlb <= vrb) {
+                    push(cur, r2d_task {q, r.lb, r.rb, 0, m_size, 0, r.vlb, vrb, 0, 0}, 0);
+                }
+            }
+            for (uint32_t level=0; level < m_max_level and !cur.empty(); ++level) {
+                next.clear();
+                for (size_type t=0; t < cur.size(); ++t) {
+                    if (t + prefetch_dist < cur.size()) {
+                        const r2d_task& y = cur[t + prefetch_dist];
+                        _prefetch(m_tree_rank, y.offset + y.lb, 0);
+                        _prefetch(m_tree_rank, y.offset + y.rb + 1, 0);
+                    }
+                    const r2d_task& x = cur[t];
+                    size_type parent = path_rec.size();
+                    size_type rank_lb = 0;
+                    _r2d_expand(node_type(x.offset, x.node_size, level, x.sym), x.lb, x.rb,
+                                x.ilb, x.vlb, x.vrb, rank_lb,
+                    [&](const node_type& c, size_type c_lb, size_type c_rb,
+                        value_type c_ilb, value_type c_vlb, value_type c_vrb) {
+                        push(next, r2d_task {x.q, c_lb, c_rb, c.offset, c.size, c_ilb,
+                                             c_vlb, c_vrb, c.sym, parent}, level+1);
+                    });
+                    if (t_report) {
+                        path_rec.push_back(r2d_path {x.offset + x.lb, rank_lb, x.parent});
+                    }
+                }
+                cur.swap(next);
             }
-            if (!sdsl::empty(get<1>(c_r)) and vrb >= mid) {
-                _range_search_2d(get<1>(c_v), get<1>(c_r), std::max(mid, vlb),
-                                 vrb, mid, is, rank_off, point_vec, report,
-                                 cnt_answers);
+            // the remaining tasks are leaves
+            for (const auto& x : cur) {
+                cnt[x.q] += x.rb - x.lb + 1;
+                for (size_type j=1; t_report and j <= x.rb - x.lb + 1; ++j) {
+                    size_type i = j;
+                    size_type c = x.sym;
+                    size_type is = x.lb; // start of the range at the root
+                    for (size_type p = x.parent, k=0; k < m_max_level; ++k) {
+                        const r2d_path& y = path_rec[p];
+                        i = _r2d_to_parent(i, c&1, y.is, y.rank_off);
+                        c >>= 1;
+                        is = y.is;
+                        p = y.parent;
+                    }
+                    (*points)[x.q].emplace_back(is + i - 1, x.sym);
+                }
             }
         }
 
+    public:
+
         //! Returns a const_iterator to the first element.
         const_iterator begin()const
         {
@@ -565,7 +754,6 @@ class wm_int
             read_member(m_max_level, in);
             m_zero_cnt.load(in);
             m_rank_level.load(in);
-            init_buffers(m_max_level);
         }
 
         //! Represents a node in the wavelet tree
@@ -754,5 +942,14 @@ class wm_int
         }
 };
 
+//! Constructs a wm_int with multiple threads, see construct_wt.
+template<class t_bitvector, class t_rank, class t_select, class t_select_zero, class t_buf>
+void construct_wt(wm_int<t_bitvector, t_rank, t_select, t_select_zero>& wt,
+                  t_buf& buf, int_vector_size_type size, uint64_t threads)
+{
+    wm_int<t_bitvector, t_rank, t_select, t_select_zero> tmp(buf, size, 0, threads);
+    wt.swap(tmp);
+}
+
 }// end namespace sdsl
 #endif
@@ -0,0 +1,512 @@
+/*! \file wm_kary.hpp
+    \brief wm_kary.hpp contains a wavelet matrix which stores a digit of
+           several bits per level.
+*/
+#ifndef INCLUDED_SDSL_WM_KARY
+#define INCLUDED_SDSL_WM_KARY
+
+#include "sdsl_concepts.hpp"
+#include "int_vector.hpp"
+#include "wt_helper.hpp"
+#include "util.hpp"
+#include <algorithm> // for std::swap
+#include <stdexcept>
+#include <vector>
+#include <utility>
+
+//! Namespace for the succinct data structure library.
+namespace sdsl
+{
+
+//! A wavelet matrix over 2^t_b-ary digits for integer sequences.
+/*!
+ * \tparam t_b Number of bits of a symbol which are consumed per level;
+ *             2 (4-ary) to 4 (16-ary).
+ *
+ * Level k stores the k-th digit (most significant first) of each symbol as
+ * a t_b-bit field and reorders the symbols stably by the digit for level
+ * k+1, like wm_int does for single bits. A query therefore needs only
+ * ceil(log|Sigma|/t_b) levels, e.g. 3 instead of 8 for a byte alphabet and
+ * t_b=3, and every level costs one rank on a digit sequence.
+ *
+ * The digits of a level are grouped in blocks of one 64-byte aligned cache
+ * line (8 words). The first words of a block hold, for every digit, the
+ * number of its occurrences since the start of the superblock (256 blocks)
+ * as 16-bit counters; the absolute numbers are stored per superblock. The occurrences inside a block are
+ * counted by comparing all fields of a word in parallel (SWAR) and one
+ * popcount per word.
+ *
+ * Space: 2^t_b 16-bit counters per 512-bit block, i.e. 1/8 (t_b=2), 1/4
+ *        (t_b=3) or 1/2 (t_b=4) of the blocks are counters.
+ *
+ *   @ingroup wt
+ */
+template<uint8_t t_b = 2>
+class wm_kary
+{
+        static_assert(t_b >= 2 and t_b <= 4, "wm_kary: t_b has to be in [2..4]");
+    public:
+
+        typedef int_vector<>::size_type               size_type;
+        typedef int_vector<>::value_type              value_type;
+        typedef int_vector<>::difference_type         difference_type;
+        typedef random_access_const_iterator<wm_kary> const_iterator;
+        typedef const_iterator                        iterator;
+        typedef wt_tag                                index_category;
+        typedef int_alphabet_tag                      alphabet_category;
+        enum 	{lex_ordered=0};
+
+        enum { arity = 1 << t_b };                      // number of different digits
+        enum { word_digits = 64 / t_b };                // digits per word
+        enum { block_words = 8 };                       // words per block
+        enum { cnt_words = arity / 4 };                 // words of 16-bit counters per block
+        enum { data_words = block_words - cnt_words };  // words of digits per block
+        enum { block_digits = data_words*word_digits }; // digits per block
+        enum { super_blocks = 256 };                    // blocks per superblock
+
+    protected:
+
+        size_type      m_size   = 0;
+        size_type      m_sigma  = 0;  //<- \f$ |\Sigma| \f$
+        uint32_t       m_levels = 0;  // number of levels
+        size_type      m_lvl_blocks = 0; // blocks per level, including a block for position size()
+        size_type      m_offset = 0;  // index of the first block in m_data
+        int_vector<64> m_data;        // blocks; level k starts at word k*m_lvl_blocks*block_words
+        int_vector<64> m_super_cnt;   // m_super_cnt[(k*supers+s)*arity+d]: d's in level k before superblock s
+        int_vector<64> m_C;           // m_C[k*arity+d]: digits smaller than d in level k
+
+        void copy(const wm_kary& wt)
+        {
+            m_size       = wt.m_size;
+            m_sigma      = wt.m_sigma;
+            m_levels     = wt.m_levels;
+            m_lvl_blocks = wt.m_lvl_blocks;
+            m_offset     = wt.m_offset;
+            m_data       = wt.m_data;
+            m_super_cnt  = wt.m_super_cnt;
+            m_C          = wt.m_C;
+            align();
+        }
+
+        size_type data_size()const
+        {
+            return m_levels*m_lvl_blocks*block_words;
+        }
+
+        //! Moves the blocks to the first 64-byte boundary of m_data, see bit_vector_cl.
+        void align()
+        {
+            if (m_data.empty()) {
+                return;
+            }
+            if (memory_manager::mapped_bytes(m_data.data())) {
+                if (0 == ((uintptr_t)(m_data.data() + m_offset) & 63)) {
+                    return;
+                }
+                int_vector<64> tmp(m_data);
+                m_data.swap(tmp);
+            }
+            if (m_data.size() < data_size() + block_words-1) {
+                m_data.resize(data_size() + block_words-1);
+            }
+            size_type offset = ((64 - ((uintptr_t)m_data.data() & 63)) & 63) >> 3;
+            if (offset != m_offset) {
+                memmove(m_data.data() + offset, m_data.data() + m_offset, data_size()*sizeof(uint64_t));
+                m_offset = offset;
+            }
+        }
+
+    private:
+
+        //! Sets the lowest bit of each field of x which equals d.
+        static uint64_t eq_mask(uint64_t x, uint64_t d)
+        {
+            // lowest bit of each of the word_digits fields
+            const uint64_t lo = (bits::all_set >> (64 - word_digits*t_b)) / (arity-1);
+            uint64_t y = x ^ (d * lo); // fields equal to d become 0
+            uint64_t z = y;
+            for (uint8_t j=1; j < t_b; ++j) {
+                z |= y >> j;
+            }
+            return ~z & lo;
+        }
+
+        size_type supers()const
+        {
+            return (m_lvl_blocks + super_blocks-1) / super_blocks;
+        }
+
+        //! Block j of level k.
+        const uint64_t* block(uint32_t k, size_type j)const
+        {
+            return m_data.data() + m_offset + (k*m_lvl_blocks + j)*block_words;
+        }
+
+        //! Digit at position i of level k.
+        uint64_t digit(uint32_t k, size_type i)const
+        {
+            size_type j = i / block_digits;
+            size_type r = i - j*block_digits;
+            return (block(k, j)[cnt_words + r/word_digits] >> ((r%word_digits)*t_b)) & (arity-1);
+        }
+
+        //! Occurrences of digit d in level k before block j.
+        size_type block_rank(uint32_t k, size_type j, uint64_t d)const
+        {
+            return m_super_cnt[(k*supers() + j/super_blocks)*arity + d]
+                   + ((block(k, j)[d/4] >> ((d%4)*16)) & 0xFFFFULL);
+        }
+
+        //! Occurrences of digit d in level k in [0..i).
+        size_type rank_digit(uint32_t k, size_type i, uint64_t d)const
+        {
+            size_type j = i / block_digits;
+            size_type r = i - j*block_digits; // digits inside the block
+            size_type full = r / word_digits;
+            uint64_t last = bits::lo_set[(r - full*word_digits)*t_b];
+            const uint64_t* p = block(k, j) + cnt_words;
+            size_type res = block_rank(k, j, d);
+            for (size_type w=0; w < full; ++w) {
+                res += bits::cnt(eq_mask(p[w], d));
+            }
+            return res + bits::cnt(eq_mask(p[full], d) & last);
+        }
+
+        //! Position of the i-th occurrence of digit d in level k.
+        size_type select_digit(uint32_t k, size_type i, uint64_t d)const
+        {
+            // last superblock and then last block with less than i occurrences before it
+            size_type lb = 0, rb = supers()-1;
+            while (lb < rb) {
+                size_type mid = (lb+rb+1)/2;
+                if (m_super_cnt[(k*supers() + mid)*arity + d] < i) {
+                    lb = mid;
+                } else {
+                    rb = mid-1;
+                }
+            }
+            size_type j_lb = lb*super_blocks;
+            size_type j_rb = std::min(m_lvl_blocks, j_lb+super_blocks)-1;
+            while (j_lb < j_rb) {
+                size_type mid = (j_lb+j_rb+1)/2;
+                if (block_rank(k, mid, d) < i) {
+                    j_lb = mid;
+                } else {
+                    j_rb = mid-1;
+                }
+            }
+            i -= block_rank(k, j_lb, d);
+            const uint64_t* p = block(k, j_lb) + cnt_words;
+            size_type res = j_lb*block_digits;
+            uint64_t x = eq_mask(*p, d);
+            size_type cnt = bits::cnt(x);
+            while (cnt < i) {
+                i -= cnt;
+                x = eq_mask(*(++p), d);
+                cnt = bits::cnt(x);
+                res += word_digits;
+            }
+            return res + bits::sel(x, i)/t_b;
+        }
+
+        //! Digit of symbol c at level k.
+        uint64_t digit_of(value_type c, uint32_t k)const
+        {
+            return (c >> ((m_levels-k-1)*t_b)) & (arity-1);
+        }
+
+        //! Stores the digits of one level and its counters.
+        template<class t_rac>
+        void build_level(uint32_t k, const t_rac& rac)
+        {
+            std::vector<size_type> cnt(arity, 0);
+            size_type super_off = k*supers()*arity;
+            for (size_type j=0; j < m_lvl_blocks; ++j) {
+                uint64_t* p = m_data.data() + m_offset + (k*m_lvl_blocks + j)*block_words;
+                for (uint64_t d=0; d < arity; ++d) {
+                    if (j % super_blocks == 0) {
+                        m_super_cnt[super_off + (j/super_blocks)*arity + d] = cnt[d];
+                    }
+                    p[d/4] |= (cnt[d] - m_super_cnt[super_off + (j/super_blocks)*arity + d]) << ((d%4)*16);
+                }
+                p += cnt_words;
+                size_type end = std::min(m_size, (j+1)*block_digits);
+                for (size_type i=j*block_digits, r=0; i < end; ++i, ++r) {
+                    uint64_t d = digit_of(rac[i], k);
+                    p[r/word_digits] |= d << ((r%word_digits)*t_b);
+                    ++cnt[d];
+                }
+            }
+            for (uint64_t d=0, sum=0; d < arity; ++d) {
+                m_C[k*arity + d] = sum;
+                sum += cnt[d];
+            }
+        }
+
+    public:
+
+        const size_type& sigma  = m_sigma;  //!< Effective alphabet size of the wavelet tree.
+        const uint32_t&  levels = m_levels; //!< Number of levels of the matrix.
+
+        //! Default constructor
+        wm_kary() {}
+
+        //! Constructor
+        /*! \param buf  File buffer of the int_vector for which the wm_kary should be build.
+         *  \param size Size of the prefix of v, which should be indexed.
+         *    \par Time complexity
+         *        \f$ \Order{n\log|\Sigma|/t_b}\f$, where \f$n=size\f$
+         *    \par Space complexity
+         *        The sequence and a buffer of the same size are held in memory.
+         */
+        template<uint8_t int_width>
+        wm_kary(int_vector_buffer<int_width>& buf, size_type size) : m_size(size)
+        {
+            if (0 == m_size)
+                return;
+            if (buf.size() < m_size) {
+                throw std::logic_error("n="+util::to_string(buf.size())+" < "+util::to_string(m_size)+"=m_size");
+                return;
+            }
+            int_vector<int_width> rac(m_size, 0, buf.width()), tmp(m_size, 0, buf.width());
+            value_type x = 1; // largest value in rac
+            for (size_type i=0; i < m_size; ++i) {
+                rac[i] = buf[i];
+                x = std::max(x, (value_type)rac[i]);
+            }
+            m_levels     = (bits::hi(x)+1 + t_b-1) / t_b;
+            m_lvl_blocks = m_size/block_digits + 1;
+            m_data       = int_vector<64>(data_size() + block_words-1, 0);
+            align();
+            m_super_cnt  = int_vector<64>(m_levels*supers()*arity, 0);
+            m_C          = int_vector<64>(m_levels*arity, 0);
+            for (uint32_t k=0; k < m_levels; ++k) {
+                build_level(k, rac);
+                // stable partition by the digit of level k
+                std::vector<size_type> pos(m_C.begin() + k*arity, m_C.begin() + (k+1)*arity);
+                for (size_type i=0; i < m_size; ++i) {
+                    tmp[pos[digit_of(rac[i], k)]++] = rac[i];
+                }
+                rac.swap(tmp);
+            }
+            // equal symbols are adjacent in the last order
+            m_sigma = 1;
+            for (size_type i=1; i < m_size; ++i) {
+                m_sigma += (rac[i] != rac[i-1]);
+            }
+        }
+
+        //! Copy constructor
+        wm_kary(const wm_kary& wt)
+        {
+            copy(wt);
+        }
+
+        //! Move constructor
+        wm_kary(wm_kary&& wt)
+        {
+            *this = std::move(wt);
+        }
+
+        //! Assignment operator
+        wm_kary& operator=(const wm_kary& wt)
+        {
+            if (this != &wt) {
+                copy(wt);
+            }
+            return *this;
+        }
+
+        //! Assignment move operator
+        wm_kary& operator=(wm_kary&& wt)
+        {
+            if (this != &wt) {
+                m_size       = wt.m_size;
+                m_sigma      = wt.m_sigma;
+                m_levels     = wt.m_levels;
+                m_lvl_blocks = wt.m_lvl_blocks;
+                m_offset     = wt.m_offset;
+                m_data       = std::move(wt.m_data);
+                m_super_cnt  = std::move(wt.m_super_cnt);
+                m_C          = std::move(wt.m_C);
+            }
+            return *this;
+        }
+
+        //! Swap operator
+        void swap(wm_kary& wt)
+        {
+            if (this != &wt) {
+                std::swap(m_size, wt.m_size);
+                std::swap(m_sigma, wt.m_sigma);
+                std::swap(m_levels, wt.m_levels);
+                std::swap(m_lvl_blocks, wt.m_lvl_blocks);
+                std::swap(m_offset, wt.m_offset);
+                m_data.swap(wt.m_data);
+                m_super_cnt.swap(wt.m_super_cnt);
+                m_C.swap(wt.m_C);
+            }
+        }
+
+        //! Returns the size of the original vector.
+        size_type size()const
+        {
+            return m_size;
+        }
+
+        //! Returns whether the wavelet tree contains no data.
+        bool empty()const
+        {
+            return m_size == 0;
+        }
+
+        //! Recovers the i-th symbol of the original vector.
+        /*! \param i The index of the symbol in the original vector.
+         *  \returns The i-th symbol of the original vector.
+         *  \par Precondition
+         *       \f$ i < size() \f$
+         */
+        value_type operator[](size_type i)const
+        {
+            assert(i < size());
+            value_type res = 0;
+            for (uint32_t k=0; k < m_levels; ++k) {
+                uint64_t d = digit(k, i);
+                res = (res << t_b) | d;
+                i = m_C[k*arity + d] + rank_digit(k, i, d);
+            }
+            return res;
+        }
+
+        //! Prefetches the data which is accessed first by rank(i, c).
+        void prefetch(size_type i)const
+        {
+            if (m_levels > 0) {
+                SDSL_PREFETCH(block(0, i/block_digits));
+            }
+        }
+
+        //! Calculates how many symbols c are in the prefix [0..i-1] of the supported vector.
+        /*!
+         *  \param i The exclusive index of the prefix range [0..i-1], so \f$i\in[0..size()]\f$.
+         *  \param c The symbol to count the occurrences in the prefix.
+         *    \returns The number of occurrences of symbol c in the prefix [0..i-1] of the supported vector.
+         *  \par Time complexity
+         *       \f$ \Order{\log |\Sigma|/t_b} \f$
+         *  \par Precondition
+         *       \f$ i \leq size() \f$
+         */
+        size_type rank(size_type i, value_type c)const
+        {
+            assert(i <= size());
+            if (m_levels*t_b < 64 and (c >> (m_levels*t_b)) > 0) { // c is greater than any symbol in wt
+                return 0;
+            }
+            size_type b = 0; // start of the interval of the symbols with the prefix of c
+            for (uint32_t k=0; k < m_levels and i > b; ++k) {
+                uint64_t d = digit_of(c, k);
+                b = m_C[k*arity + d] + rank_digit(k, b, d);
+                i = m_C[k*arity + d] + rank_digit(k, i, d);
+            }
+            return i > b ? i - b : 0;
+        }
+
+        //! Calculates how many occurrences of symbol wt[i] are in the prefix [0..i-1] of the original sequence.
+        /*!
+         *  \param i The index of the symbol.
+         *  \return  Pair (rank(wt[i],i),wt[i])
+         *  \par Precondition
+         *       \f$ i < size() \f$
+         */
+        std::pair<size_type, value_type>
+        inverse_select(size_type i)const
+        {
+            assert(i < size());
+            value_type c = 0;
+            size_type b = 0;
+            for (uint32_t k=0; k < m_levels; ++k) {
+                uint64_t d = digit(k, i);
+                c = (c << t_b) | d;
+                b = m_C[k*arity + d] + rank_digit(k, b, d);
+                i = m_C[k*arity + d] + rank_digit(k, i, d);
+            }
+            return std::make_pair(i-b, c);
+        }
+
+        //! Calculates the i-th occurrence of the symbol c in the supported vector.
+        /*!
+         *  \param i The i-th occurrence.
+         *  \param c The symbol c.
+         *  \par Time complexity
+         *       \f$ \Order{\log |\Sigma|/t_b \cdot \log n} \f$
+         *  \par Precondition
+         *       \f$ 1 \leq i \leq rank(size(), c) \f$
+         */
+        size_type select(size_type i, value_type c)const
+        {
+            assert(1 <= i and i <= rank(size(), c));
+            size_type b = 0; // start of the interval of c in the last level
+            for (uint32_t k=0; k < m_levels; ++k) {
+                uint64_t d = digit_of(c, k);
+                b = m_C[k*arity + d] + rank_digit(k, b, d);
+            }
+            size_type p = b + i - 1;
+            for (uint32_t k=m_levels; k > 0; --k) {
+                uint64_t d = digit_of(c, k-1);
+                p = select_digit(k-1, p - m_C[(k-1)*arity + d] + 1, d);
+            }
+            return p;
+        }
+
+        //! Returns a const_iterator to the first element.
+        const_iterator begin()const
+        {
+            return const_iterator(this, 0);
+        }
+
+        //! Returns a const_iterator to the element after the last element.
+        const_iterator end()const
+        {
+            return const_iterator(this, size());
+        }
+
+        //! Serializes the data structure into the given ostream
+        size_type serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string name="")const
+        {
+            structure_tree_node* child = structure_tree::add_child(v, name, util::class_name(*this));
+            size_type written_bytes = 0;
+            written_bytes += write_member(m_size, out, child, "size");
+            written_bytes += write_member(m_sigma, out, child, "sigma");
+            written_bytes += write_member(m_levels, out, child, "levels");
+            written_bytes += write_member(m_lvl_blocks, out, child, "level_blocks");
+            // only the blocks are written, so the output does not depend on the alignment of m_data;
+            // they start at a multiple of 64 bytes, so a mapped load uses them in place
+            structure_tree_node* data_child = structure_tree::add_child(child, "data", util::class_name(m_data));
+            size_type data_bytes = int_vector<64>::write_header(data_size()*64, 64, out, 64);
+            out.write((const char*)(m_data.data() + m_offset), data_size()*sizeof(uint64_t));
+            data_bytes += data_size()*sizeof(uint64_t);
+            structure_tree::add_size(data_child, data_bytes);
+            written_bytes += data_bytes;
+            written_bytes += m_super_cnt.serialize(out, child, "super_cnt");
+            written_bytes += m_C.serialize(out, child, "C");
+            structure_tree::add_size(child, written_bytes);
+            return written_bytes;
+        }
+
+        //! Loads the data structure from the given istream.
+        void load(std::istream& in)
+        {
+            read_member(m_size, in);
+            read_member(m_sigma, in);
+            read_member(m_levels, in);
+            read_member(m_lvl_blocks, in);
+            m_data.load(in);
+            m_offset = 0;
+            align();
+            m_super_cnt.load(in);
+            m_C.load(in);
+        }
+};
+
+}// end namespace sdsl
+#endif
@@ -3,6 +3,9 @@
 
 #include <algorithm>
 #include <utility>
+#include <queue>
+#include <stack>
+#include <vector>
 
 namespace sdsl
 {
@@ -16,6 +19,21 @@ struct _interval_symbols_wt;
 template<typename, typename T>
 struct has_expand;
 
+template<class, class, class, class>
+class wm_int;
+
+//! Are the leaves of a wavelet tree ordered by symbol from left to right?
+template<typename t_wt>
+struct has_ordered_leaves {
+    enum { value = t_wt::lex_ordered };
+};
+
+// wm_int does not provide lex_count, but the leaves are ordered by value
+template<class t_bitvector, class t_rank, class t_select, class t_select_zero>
+struct has_ordered_leaves<wm_int<t_bitvector, t_rank, t_select, t_select_zero>> {
+    enum { value = true };
+};
+
 //! Intersection of elements in WT[s_0,e_0], WT[s_1,e_1],...,WT[s_k,e_k]
 /*! \param wt     The wavelet tree object.
  *  \param ranges The ranges.
@@ -123,6 +141,121 @@ quantile_freq(const t_wt& wt, typename t_wt::size_type lb,
     return {wt.sym(v), size(r)};
 };
 
+//! Returns the qs[i]-th smallest element and its frequency in wt[lb..rb] for each i.
+/*! \param wt The wavelet tree.
+ *  \param lb Left array bound in T
+ *  \param rb Right array bound in T
+ *  \param qs Quantiles, 0-based indexed.
+ *  \return res[i] equals quantile_freq(wt, lb, rb, qs[i]).
+ *
+ *  Each node is expanded at most once for all quantiles that pass it.
+ */
+template<class t_wt>
+std::vector<std::pair<typename t_wt::value_type, typename t_wt::size_type>>
+quantile_freq_batch(const t_wt& wt, typename t_wt::size_type lb,
+                    typename t_wt::size_type rb,
+                    const std::vector<typename t_wt::size_type>& qs)
+{
+    static_assert(has_ordered_leaves<t_wt>::value,
+                  "quantile_freq_batch requires a WT with ordered leaves");
+    using std::get;
+    using size_type      = typename t_wt::size_type;
+    using value_type     = typename t_wt::value_type;
+    using node_type      = typename t_wt::node_type;
+    static_assert(has_expand<t_wt, std::pair<node_type,node_type>(const node_type&)>::value,
+                  "quantile_freq_batch requires t_wt to have expand(const node_type&)");
+
+    std::vector<std::pair<value_type, size_type>> res(qs.size());
+    if (qs.empty())
+        return res;
+    // process the quantiles in increasing order, so that the ones
+    // passing a node form an interval [b..e) of idx
+    std::vector<size_type> idx(qs.size());
+    for (size_type i=0; i < idx.size(); ++i)
+        idx[i] = i;
+    std::sort(idx.begin(), idx.end(), [&qs](size_type a, size_type b) {
+        return qs[a] < qs[b];
+    });
+    std::vector<size_type> q(qs.size()); // quantile relative to the node
+    for (size_type i=0; i < idx.size(); ++i)
+        q[i] = qs[idx[i]];
+
+    std::stack<std::tuple<node_type, range_type, size_type, size_type>> stack;
+    stack.emplace(wt.root(), range_type(lb, rb), 0, q.size());
+    while (!stack.empty()) {
+        auto x = stack.top(); stack.pop();
+        const node_type& v = get<0>(x);
+        size_type b = get<2>(x), e = get<3>(x);
+        if (wt.is_leaf(v)) {
+            for (size_type i=b; i < e; ++i)
+                res[idx[i]] = {wt.sym(v), size(get<1>(x))};
+        } else {
+            auto child        = wt.expand(v);
+            auto child_ranges = wt.expand(v, get<1>(x));
+            auto num_zeros    = size(get<0>(child_ranges));
+            size_type m = std::lower_bound(q.begin()+b, q.begin()+e, num_zeros) - q.begin();
+            if (m < e) {
+                for (size_type i=m; i < e; ++i)
+                    q[i] -= num_zeros;
+                stack.emplace(get<1>(child), get<1>(child_ranges), m, e);
+            }
+            if (b < m) {
+                stack.emplace(get<0>(child), get<0>(child_ranges), b, m);
+            }
+        }
+    }
+    return res;
+}
+
+//! Returns the k most frequent elements of wt[lb..rb] and their frequencies.
+/*! \param wt The wavelet tree.
+ *  \param lb Left array bound in T
+ *  \param rb Right array bound in T
+ *  \param k  Number of elements to report.
+ *  \return A vector of min(k, #distinct elements) (value, frequency) pairs
+ *          ordered by decreasing frequency.
+ *
+ *  Nodes are expanded in order of the size of their range, which is an
+ *  upper bound for the frequency of all leaves below them. So the first
+ *  k leaves which are reached are the answer.
+ */
+template<class t_wt>
+std::vector<std::pair<typename t_wt::value_type, typename t_wt::size_type>>
+topk_freq(const t_wt& wt, typename t_wt::size_type lb,
+          typename t_wt::size_type rb, typename t_wt::size_type k)
+{
+    using std::get;
+    using size_type      = typename t_wt::size_type;
+    using value_type     = typename t_wt::value_type;
+    using node_type      = typename t_wt::node_type;
+    using pnr_type       = std::pair<node_type, range_type>;
+    static_assert(has_expand<t_wt, std::pair<node_type,node_type>(const node_type&)>::value,
+                  "topk_freq requires t_wt to have expand(const node_type&)");
+
+    std::vector<std::pair<value_type, size_type>> res;
+    if (lb > rb or k == 0)
+        return res;
+    auto cmp = [](const pnr_type& a, const pnr_type& b) {
+        return size(a.second) < size(b.second);
+    };
+    std::priority_queue<pnr_type, std::vector<pnr_type>, decltype(cmp)> pq(cmp);
+    pq.emplace(wt.root(), range_type(lb, rb));
+    while (!pq.empty() and res.size() < k) {
+        pnr_type x = pq.top(); pq.pop();
+        if (wt.is_leaf(x.first)) {
+            res.emplace_back(wt.sym(x.first), size(x.second));
+        } else {
+            auto child        = wt.expand(x.first);
+            auto child_ranges = wt.expand(x.first, x.second);
+            if (!empty(get<0>(child_ranges)))
+                pq.emplace(get<0>(child), get<0>(child_ranges));
+            if (!empty(get<1>(child_ranges)))
+                pq.emplace(get<1>(child), get<1>(child_ranges));
+        }
+    }
+    return res;
+}
+
 
 template<class t_wt>
 void
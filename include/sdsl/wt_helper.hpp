@@ -2,6 +2,7 @@
 #define INCLUDED_SDSL_WT_HELPER
 
 #include "int_vector.hpp"
+#include "parallel_helper.hpp"
 #include <algorithm>
 #include <limits>
 #include <deque>
@@ -15,6 +16,13 @@ namespace sdsl
 typedef std::pair<int_vector<>::size_type, int_vector<>::size_type> range_type;
 typedef std::vector<range_type>         range_vec_type;
 
+//! Query rectangle of the batched range_search_2d / range_count_2d methods.
+struct range_2d_rect {
+    int_vector<>::size_type  lb, rb;   // index interval [lb..rb]
+    int_vector<>::value_type vlb, vrb; // value interval [vlb..vrb]
+};
+typedef std::vector<range_2d_rect>      range_2d_rect_vec_type;
+
 //! Empty range check
 /*! \param r Range to check
  *  \returns True if the range is empty, false otherwise.
@@ -628,5 +636,147 @@ struct int_tree {
     using type = _int_tree<t_dfs_shape, t_wt>;
 };
 
+//! Calls x.prefetch(i) if the structure x supports prefetching, e.g. rank_support_v.
+template<class t_x>
+auto _prefetch(const t_x& x, uint64_t i, int) -> decltype(x.prefetch(i), void())
+{
+    x.prefetch(i);
+}
+
+template<class t_x>
+void _prefetch(const t_x&, uint64_t, long) {}
+
+//! Stable partitions the nodes of one level of a wavelet tree with multiple threads.
+/*!
+ * \param rac       Sequence of the current level. The elements of a node are
+ *                  stored consecutively, i.e. node(rac[i]) <= node(rac[i+1])
+ *                  or all elements belong to one node.
+ * \param tmp       Buffer of size rac.size(). After the call rac contains the
+ *                  sequence of the next level, in which each node of the
+ *                  current level is split into the elements whose `mask` bit
+ *                  is 0 followed by the elements whose `mask` bit is 1.
+ * \param bv        Bit vector of the wavelet tree. Bit bv_offset+i is set if
+ *                  the `mask` bit of rac[i] is set.
+ * \param bv_offset Start of the level in bv.
+ * \param mask      Mask of the bit which is represented on this level.
+ * \param node      Functor which maps a value to its node on the current level.
+ * \param threads   Number of threads.
+ * \return The number of elements whose `mask` bit is 0.
+ *
+ * The sequence is split into one chunk per thread, whose bits start at a word
+ * border of bv. In a first pass each thread sets the bits of its chunk and
+ * counts the zeros and ones of the nodes at the borders of its chunk. The
+ * destination of the border nodes is then calculated sequentially, and in a
+ * second pass each thread moves the elements of its chunk to tmp. rac and tmp
+ * have to store elements in separate bytes (e.g. std::vector<uint8_t>), since
+ * they are written concurrently.
+ */
+template<class t_rac, class t_node>
+uint64_t _par_partition_level(t_rac& rac, t_rac& tmp, bit_vector& bv,
+                              uint64_t bv_offset, uint64_t mask, t_node node,
+                              uint64_t threads)
+{
+    struct segment {
+        uint64_t node = 0, begin = 0, zeros = 0, ones = 0, dest0 = 0, dest1 = 0;
+    };
+    const uint64_t n = rac.size();
+    threads = std::max((uint64_t)1, threads);
+    std::vector<uint64_t> border(threads+1, n);
+    border[0] = 0;
+    for (uint64_t c=1; c < threads; ++c) {
+        uint64_t b = ((bv_offset + (n*c)/threads + 63)/64)*64 - bv_offset;
+        border[c] = std::max(border[c-1], std::min(n, b));
+    }
+    std::vector<segment> first(threads), last(threads);
+    std::vector<uint64_t> zeros(threads, 0);
+
+    // (1) Set bits and count the elements of the border nodes of each chunk
+    parallel_for(threads, threads, [&](uint64_t c, uint64_t) {
+        uint64_t* data = bv.data();
+        segment seg;
+        bool is_first = true;
+        for (uint64_t i=border[c]; i < border[c+1]; ++i) {
+            uint64_t x = rac[i], v = node(x);
+            if (i == border[c] or v != seg.node) {
+                if (i > border[c] and is_first) {
+                    first[c] = seg;
+                    is_first = false;
+                }
+                seg = segment();
+                seg.node = v;
+                seg.begin = i;
+            }
+            if (x & mask) {
+                data[(bv_offset+i)>>6] |= 1ULL << ((bv_offset+i)&0x3F);
+                ++seg.ones;
+            } else {
+                ++seg.zeros;
+                ++zeros[c];
+            }
+        }
+        if (is_first) {
+            first[c] = seg;
+        }
+        last[c] = seg;
+    });
+
+    // (2) Calculate the destinations of the border nodes. A node which
+    //     spans several chunks occurs consecutively in the list below.
+    std::vector<segment*> segs;
+    for (uint64_t c=0; c < threads; ++c) {
+        if (border[c] < border[c+1]) {
+            segs.push_back(&first[c]);
+            if (first[c].begin != last[c].begin) {
+                segs.push_back(&last[c]);
+            }
+        }
+    }
+    for (size_t i=0, j=0; i < segs.size(); i=j) {
+        uint64_t node_zeros = 0;
+        for (j=i; j < segs.size() and segs[j]->node == segs[i]->node
+             and (j==i or segs[j-1]->begin+segs[j-1]->zeros+segs[j-1]->ones == segs[j]->begin); ++j) {
+            node_zeros += segs[j]->zeros;
+        }
+        uint64_t dest0 = segs[i]->begin, dest1 = segs[i]->begin + node_zeros;
+        for (size_t k=i; k < j; ++k) {
+            segs[k]->dest0 = dest0;
+            segs[k]->dest1 = dest1;
+            dest0 += segs[k]->zeros;
+            dest1 += segs[k]->ones;
+        }
+    }
+
+    // (3) Move the elements of each chunk to their destination
+    parallel_for(threads, threads, [&](uint64_t c, uint64_t) {
+        uint64_t i = border[c];
+        while (i < border[c+1]) {
+            uint64_t v = node(rac[i]), e = i, z = 0;
+            while (e < border[c+1] and node(rac[e]) == v) {
+                z += !(rac[e] & mask);
+                ++e;
+            }
+            uint64_t dest0 = i, dest1 = i + z;
+            if (i == first[c].begin) {
+                dest0 = first[c].dest0; dest1 = first[c].dest1;
+            } else if (i == last[c].begin) {
+                dest0 = last[c].dest0; dest1 = last[c].dest1;
+            }
+            for (; i < e; ++i) {
+                if (rac[i] & mask) {
+                    tmp[dest1++] = rac[i];
+                } else {
+                    tmp[dest0++] = rac[i];
+                }
+            }
+        }
+    });
+    rac.swap(tmp);
+    uint64_t total_zeros = 0;
+    for (auto z : zeros) {
+        total_zeros += z;
+    }
+    return total_zeros;
+}
+
 } // end namespace sdsl
 #endif
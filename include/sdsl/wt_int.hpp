@@ -88,8 +88,6 @@ class wt_int
         select_1_type          m_tree_select1; // select support for the wavelet tree bit vector
         select_0_type          m_tree_select0;
         uint32_t               m_max_level = 0;
-        mutable int_vector<64> m_path_off;     // array keeps track of path offset in select-like methods
-        mutable int_vector<64> m_path_rank_off;// array keeps track of rank values for the offsets
 
         void copy(const wt_int& wt)
         {
@@ -103,18 +101,10 @@ class wt_int
             m_tree_select0  = wt.m_tree_select0;
             m_tree_select0.set_vector(&m_tree);
             m_max_level     = wt.m_max_level;
-            m_path_off      = wt.m_path_off;
-            m_path_rank_off = wt.m_path_rank_off;
         }
 
     private:
 
-        void init_buffers(uint32_t max_level)
-        {
-            m_path_off = int_vector<64>(max_level+1);
-            m_path_rank_off = int_vector<64>(max_level+1);
-        }
-
         // recursive internal version of the method interval_symbols
         void _interval_symbols(size_type i, size_type j, size_type& k,
                                std::vector<value_type>& cs,
@@ -158,6 +148,40 @@ class wt_int
             }
         }
 
+        //! Builds the tree level by level with multiple threads.
+        /*! The elements of buf are stored in arrays of type t_int, so that
+         *  the threads can move them concurrently. See _par_partition_level.
+         */
+        template<class t_int, uint8_t int_width>
+        void construct_par(int_vector_buffer<int_width>& buf, uint64_t threads)
+        {
+            std::vector<t_int> rac(m_size), tmp(m_size);
+            for (size_type i=0; i < m_size; ++i) {
+                rac[i] = buf[i];
+            }
+            bit_vector tree(m_size*m_max_level, 0);
+            uint64_t mask_old = 1ULL<<(m_max_level);
+            for (uint32_t k=0; k<m_max_level; ++k) {
+                const uint64_t mask_new = 1ULL<<(m_max_level-k-1);
+                _par_partition_level(rac, tmp, tree, k*m_size, mask_new,
+                [mask_old](uint64_t x) { return x & mask_old; }, threads);
+                mask_old += mask_new;
+            }
+            // each run of equal values in the last level is a leaf
+            m_sigma = 0;
+            for (size_type i=0; i < m_size; ++i) {
+                if (i == 0 or (rac[i]&mask_old) != (rac[i-1]&mask_old)) {
+                    ++m_sigma;
+                }
+            }
+            std::vector<t_int>().swap(rac);
+            std::vector<t_int>().swap(tmp);
+            m_tree = bit_vector_type(std::move(tree));
+            util::init_support(m_tree_rank, &m_tree);
+            util::init_support(m_tree_select0, &m_tree);
+            util::init_support(m_tree_select1, &m_tree);
+        }
+
     public:
 
         const size_type&       sigma = m_sigma;         //!< Effective alphabet size of the wavelet tree.
@@ -167,24 +191,25 @@ class wt_int
         //! Default constructor
         wt_int()
         {
-            init_buffers(m_max_level);
         };
 
         //! Semi-external constructor
         /*! \param buf         File buffer of the int_vector for which the wt_int should be build.
          *  \param size        Size of the prefix of v, which should be indexed.
          *  \param max_level   Maximal level of the wavelet tree. If set to 0, determined automatically.
+         *  \param threads     Number of threads used to build the levels of the tree.
          *    \par Time complexity
          *        \f$ \Order{n\log|\Sigma|}\f$, where \f$n=size\f$
          *        I.e. we need \Order{n\log n} if rac is a permutation of 0..n-1.
          *    \par Space complexity
          *        \f$ n\log|\Sigma| + O(1)\f$ bits, where \f$n=size\f$.
+         *        For threads > 1 the sequence and a buffer are held in memory
+         *        as arrays of 8, 16, 32 or 64-bit integers.
          */
         template<uint8_t int_width>
         wt_int(int_vector_buffer<int_width>& buf, size_type size,
-               uint32_t max_level=0) : m_size(size)
+               uint32_t max_level=0, uint64_t threads=1) : m_size(size)
         {
-            init_buffers(m_max_level);
             if (0 == m_size)
                 return;
             size_type n = buf.size();  // set n
@@ -207,7 +232,20 @@ class wt_int
             } else {
                 m_max_level = max_level;
             }
-            init_buffers(m_max_level);
+
+            if (threads > 1) {
+                rac.resize(0);
+                if (buf.width() <= 8) {
+                    construct_par<uint8_t>(buf, threads);
+                } else if (buf.width() <= 16) {
+                    construct_par<uint16_t>(buf, threads);
+                } else if (buf.width() <= 32) {
+                    construct_par<uint32_t>(buf, threads);
+                } else {
+                    construct_par<uint64_t>(buf, threads);
+                }
+                return;
+            }
 
             // buffer for elements in the right node
             int_vector_buffer<> buf1(tmp_file(buf.filename(), "_wt_constr_buf"),
@@ -307,8 +345,6 @@ class wt_int
                 m_tree_select0  = std::move(wt.m_tree_select0);
                 m_tree_select0.set_vector(&m_tree);
                 m_max_level     = std::move(wt.m_max_level);
-                m_path_off      = std::move(wt.m_path_off);
-                m_path_rank_off = std::move(wt.m_path_rank_off);
             }
             return *this;
         }
@@ -324,8 +360,6 @@ class wt_int
                 util::swap_support(m_tree_select1, wt.m_tree_select1, &m_tree, &(wt.m_tree));
                 util::swap_support(m_tree_select0, wt.m_tree_select0, &m_tree, &(wt.m_tree));
                 std::swap(m_max_level,  wt.m_max_level);
-                m_path_off.swap(wt.m_path_off);
-                m_path_rank_off.swap(wt.m_path_rank_off);
             }
         }
 
@@ -372,6 +406,16 @@ class wt_int
             return res;
         };
 
+        //! Prefetches the data which is accessed first by rank(i, c).
+        /*! The lower levels depend on the result of the first level,
+         *  so only the first level is prefetched. This hides the first
+         *  cache miss when many independent queries are interleaved.
+         */
+        void prefetch(size_type i)const
+        {
+            _prefetch(m_tree_rank, i, 0);
+        }
+
         //! Calculates how many symbols c are in the prefix [0..i-1] of the supported vector.
         /*!
          *  \param i The exclusive index of the prefix range [0..i-1], so \f$i\in[0..size()]\f$.
@@ -460,11 +504,12 @@ class wt_int
             size_type offset = 0;
             uint64_t mask    = (1ULL) << (m_max_level-1);
             size_type node_size = m_size;
-            m_path_off[0] = m_path_rank_off[0] = 0;
+            size_type path_off[65], path_rank_off[65]; // path offsets and their ranks; local to keep select thread-safe
+            path_off[0] = path_rank_off[0] = 0;
 
             for (uint32_t k=0; k < m_max_level and node_size; ++k) {
                 size_type ones_before_o   = m_tree_rank(offset);
-                m_path_rank_off[k] = ones_before_o;
+                path_rank_off[k] = ones_before_o;
                 size_type ones_before_end = m_tree_rank(offset + node_size) - ones_before_o;
                 if (c & mask) { // search for a one at this level
                     offset += (node_size - ones_before_end);
@@ -473,7 +518,7 @@ class wt_int
                     node_size = (node_size - ones_before_end);
                 }
                 offset += m_size;
-                m_path_off[k+1] = offset;
+                path_off[k+1] = offset;
                 mask >>= 1;
             }
             if (0ULL == node_size or node_size < i) {
@@ -482,8 +527,8 @@ class wt_int
             }
             mask = 1ULL;
             for (uint32_t k=m_max_level; k>0; --k) {
-                offset = m_path_off[k-1];
-                size_type ones_before_o = m_path_rank_off[k-1];
+                offset = path_off[k-1];
+                size_type ones_before_o = path_rank_off[k-1];
                 if (c & mask) { // right child => search i'th
                     i = m_tree_select1(ones_before_o + i) - offset + 1;
                 } else { // left child => search i'th zero
@@ -668,13 +713,7 @@ class wt_int
                         size_type i = j;
                         size_type c = path;
                         for (uint32_t k=m_max_level; k>0; --k) {
-                            size_type offset = offsets[k-1];
-                            size_type ones_before_o = ones_before_os[k-1];
-                            if (c&1) {
-                                i = m_tree_select1(ones_before_o + i) - offset + 1;
-                            } else {
-                                i = m_tree_select0(offset - ones_before_o + i) - offset + 1;
-                            }
+                            i = _r2d_to_parent(i, c&1, offsets[k-1], ones_before_os[k-1]);
                             c >>= 1;
                         }
                         point_vec.emplace_back(i-1, path);
@@ -683,36 +722,140 @@ class wt_int
                 cnt_answers += rb-lb+1;
                 return;
             }
-            size_type irb = ilb + (1ULL << (m_max_level-level));
-            size_type mid = (irb + ilb)>>1;
+            _r2d_expand(node_type(offsets[level], node_size, level, path), lb, rb, ilb, vlb, vrb,
+                        ones_before_os[level],
+            [&](const node_type& c, size_type c_lb, size_type c_rb,
+                value_type c_ilb, value_type c_vlb, value_type c_vrb) {
+                offsets[level+1] = c.offset;
+                _range_search_2d(c_lb, c_rb, c_vlb, c_vrb, level+1, c_ilb, c.size, offsets,
+                                 ones_before_os, c.sym, point_vec, report, cnt_answers);
+            });
+        }
+
+        //! Counts the points in each of the rectangles.
+        /*! \param rects Rectangles [lb..rb]x[vlb..vrb].
+         *  \return res[q] equals range_search_2d(lb, rb, vlb, vrb, false).first for rects[q].
+         *
+         *  The rectangles are processed together, level by level, and the
+         *  rank data of upcoming nodes is prefetched. Nodes whose values lie
+         *  completely inside the value interval are counted without visiting
+         *  their subtrees, so no point is materialized.
+         */
+        std::vector<size_type>
+        range_count_2d_batch(const range_2d_rect_vec_type& rects) const
+        {
+            std::vector<size_type> cnt;
+            _range_2d_batch<false>(rects, cnt, nullptr);
+            return cnt;
+        }
+
+        //! Reports the points in each of the rectangles.
+        /*! \param rects Rectangles [lb..rb]x[vlb..vrb].
+         *  \return res[q] equals range_search_2d(lb, rb, vlb, vrb) for rects[q].
+         *  \sa range_count_2d_batch
+         */
+        std::vector<r2d_res_type>
+        range_search_2d_batch(const range_2d_rect_vec_type& rects) const
+        {
+            std::vector<size_type> cnt;
+            std::vector<point_vec_type> points;
+            _range_2d_batch<true>(rects, cnt, &points);
+            std::vector<r2d_res_type> res(rects.size());
+            for (size_type q=0; q < rects.size(); ++q) {
+                res[q] = r2d_res_type(cnt[q], std::move(points[q]));
+            }
+            return res;
+        }
+
+    private:
+
+        // A rectangle restricted to a node in the batched range search
+        struct r2d_task {
+            size_type  q;          // index of the rectangle
+            size_type  lb, rb;     // index interval inside the node
+            size_type  offset;     // start of the node in m_tree
+            size_type  node_size;
+            value_type ilb;        // smallest value of the node
+            value_type vlb, vrb;   // value interval inside the node
+            size_type  path;       // symbol prefix of the node
+            size_type  parent;     // parent in the path records
+        };
 
-            size_type offset = offsets[level];
+        // A visited inner node, needed to map leaf positions back to the sequence
+        struct r2d_path {
+            size_type offset, ones_before_o, parent;
+        };
 
-            size_type ones_before_o    = m_tree_rank(offset);
-            ones_before_os[level]      = ones_before_o;
-            size_type ones_before_lb   = m_tree_rank(offset + lb);
-            size_type ones_before_rb   = m_tree_rank(offset + rb + 1);
-            size_type ones_before_end  = m_tree_rank(offset + node_size);
-            size_type zeros_before_o   = offset - ones_before_o;
-            size_type zeros_before_lb  = offset + lb - ones_before_lb;
-            size_type zeros_before_rb  = offset + rb + 1 - ones_before_rb;
-            size_type zeros_before_end = offset + node_size - ones_before_end;
-            if (vlb < mid and mid) {
-                size_type nlb    = zeros_before_lb - zeros_before_o;
-                size_type nrb    = zeros_before_rb - zeros_before_o;
-                offsets[level+1] = offset + m_size;
-                if (nrb)
-                    _range_search_2d(nlb, nrb-1, vlb, std::min(vrb,mid-1), level+1, ilb, zeros_before_end - zeros_before_o, offsets, ones_before_os, path<<1, point_vec, report, cnt_answers);
+        template<bool t_report>
+        void _range_2d_batch(const range_2d_rect_vec_type& rects, std::vector<size_type>& cnt,
+                             std::vector<point_vec_type>* points) const
+        {
+            const size_type prefetch_dist = 8;
+            cnt.assign(rects.size(), 0);
+            if (t_report) {
+                points->assign(rects.size(), point_vec_type());
+            }
+            std::vector<r2d_task> cur, next;
+            std::vector<r2d_path> path_rec;
+            // adds task x of a node on level `level` to tasks
+            auto push = [&](std::vector<r2d_task>& tasks, r2d_task&& x, uint32_t level) {
+                value_type width = bits::lo_set[m_max_level-level]; // values of the node are [ilb..ilb+width]
+                if (!t_report and x.vlb <= x.ilb and x.ilb + width <= x.vrb) {
+                    cnt[x.q] += x.rb - x.lb + 1;
+                } else {
+                    tasks.push_back(std::move(x));
+                }
+            };
+            for (size_type q=0; q < rects.size(); ++q) {
+                const auto& r = rects[q];
+                value_type vrb = std::min(r.vrb, (value_type)bits::lo_set[m_max_level]);
+                if (r.lb <= r.rb and r.vlb <= vrb) {
+                    push(cur, r2d_task {q, r.lb, r.rb, 0, m_size, 0, r.vlb, vrb, 0, 0}, 0);
+                }
+            }
+            for (uint32_t level=0; level < m_max_level and !cur.empty(); ++level) {
+                next.clear();
+                for (size_type t=0; t < cur.size(); ++t) {
+                    if (t + prefetch_dist < cur.size()) {
+                        const r2d_task& y = cur[t + prefetch_dist];
+                        _prefetch(m_tree_rank, y.offset + y.lb, 0);
+                        _prefetch(m_tree_rank, y.offset + y.rb + 1, 0);
+                    }
+                    const r2d_task& x = cur[t];
+                    size_type parent = path_rec.size();
+                    size_type ones_before_o = 0;
+                    _r2d_expand(node_type(x.offset, x.node_size, level, x.path), x.lb, x.rb,
+                                x.ilb, x.vlb, x.vrb, ones_before_o,
+                    [&](const node_type& c, size_type c_lb, size_type c_rb,
+                        value_type c_ilb, value_type c_vlb, value_type c_vrb) {
+                        push(next, r2d_task {x.q, c_lb, c_rb, c.offset, c.size, c_ilb,
+                                             c_vlb, c_vrb, c.sym, parent}, level+1);
+                    });
+                    if (t_report) {
+                        path_rec.push_back(r2d_path {x.offset, ones_before_o, x.parent});
+                    }
+                }
+                cur.swap(next);
             }
-            if (vrb >= mid) {
-                size_type nlb     = ones_before_lb - ones_before_o;
-                size_type nrb     = ones_before_rb - ones_before_o;
-                offsets[level+1]  = offset + m_size + (zeros_before_end - zeros_before_o);
-                if (nrb)
-                    _range_search_2d(nlb, nrb-1, std::max(mid, vlb), vrb, level+1, mid, ones_before_end - ones_before_o, offsets, ones_before_os, (path<<1)+1 , point_vec, report, cnt_answers);
+            // the remaining tasks are leaves
+            for (const auto& x : cur) {
+                cnt[x.q] += x.rb - x.lb + 1;
+                for (size_type j=x.lb+1; t_report and j <= x.rb+1; ++j) {
+                    size_type i = j;
+                    size_type c = x.path;
+                    for (size_type p = x.parent, k=0; k < m_max_level; ++k) {
+                        const r2d_path& y = path_rec[p];
+                        i = _r2d_to_parent(i, c&1, y.offset, y.ones_before_o);
+                        c >>= 1;
+                        p = y.parent;
+                    }
+                    (*points)[x.q].emplace_back(i-1, x.path);
+                }
             }
         }
 
+    public:
+
         //! Returns a const_iterator to the first element.
         const_iterator begin()const
         {
@@ -752,7 +895,6 @@ class wt_int
             m_tree_select1.load(in, &m_tree);
             m_tree_select0.load(in, &m_tree);
             read_member(m_max_level, in);
-            init_buffers(m_max_level);
         }
 
         //! Represents a node in the wavelet tree
@@ -938,7 +1080,54 @@ class wt_int
         {
             return {m_max_level,c};
         }
+
+    private:
+
+        // One step of the range search: maps the interval [lb..rb] of the
+        // inner node v, whose smallest value is ilb, to the children of v and
+        // calls f(child, lb, rb, ilb, vlb, vrb) for each child which contains
+        // a part of the interval and of the value interval [vlb..vrb].
+        // ones_before_o is set to the number of ones in m_tree before v.offset.
+        template<class t_f>
+        void _r2d_expand(const node_type& v, size_type lb, size_type rb, value_type ilb,
+                         value_type vlb, value_type vrb, size_type& ones_before_o, t_f f) const
+        {
+            ones_before_o             = m_tree_rank(v.offset);
+            size_type ones_before_lb  = m_tree_rank(v.offset + lb);
+            size_type ones_before_rb  = m_tree_rank(v.offset + rb + 1);
+            size_type ones            = m_tree_rank(v.offset + v.size) - ones_before_o;
+            size_type ones_lb         = ones_before_lb - ones_before_o; // ones in [0..lb)
+            size_type ones_rb         = ones_before_rb - ones_before_o; // ones in [0..rb]
+            value_type mid = ilb + (1ULL << (m_max_level-v.level-1));
+            if (vlb < mid and lb - ones_lb < rb + 1 - ones_rb) {
+                f(node_type(v.offset + m_size, v.size - ones, v.level+1, v.sym<<1),
+                  lb - ones_lb, rb - ones_rb, ilb, vlb, std::min(vrb, mid-1));
+            }
+            if (vrb >= mid and ones_lb < ones_rb) {
+                f(node_type(v.offset + m_size + (v.size - ones), ones, v.level+1, (v.sym<<1)|1),
+                  ones_lb, ones_rb-1, mid, std::max(mid, vlb), vrb);
+            }
+        }
+
+        // Maps the i-th position of a child interval to the interval of the
+        // parent, which starts at offset with ones_before_o ones before it
+        size_type _r2d_to_parent(size_type i, bool right, size_type offset, size_type ones_before_o) const
+        {
+            if (right) {
+                return m_tree_select1(ones_before_o + i) - offset + 1;
+            }
+            return m_tree_select0(offset - ones_before_o + i) - offset + 1;
+        }
 };
 
+//! Constructs a wt_int with multiple threads, see construct_wt.
+template<class t_bitvector, class t_rank, class t_select, class t_select_zero, class t_buf>
+void construct_wt(wt_int<t_bitvector, t_rank, t_select, t_select_zero>& wt,
+                  t_buf& buf, int_vector_size_type size, uint64_t threads)
+{
+    wt_int<t_bitvector, t_rank, t_select, t_select_zero> tmp(buf, size, 0, threads);
+    wt.swap(tmp);
+}
+
 }// end namespace sdsl
 #endif
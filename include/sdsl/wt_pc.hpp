@@ -78,12 +78,6 @@ class wt_pc
 
     private:
 
-#ifdef WT_PC_CACHE
-        mutable value_type m_last_access_answer;
-        mutable size_type  m_last_access_i;
-        mutable size_type  m_last_access_rl;
-#endif
-
         size_type        m_size  = 0;    // original text size
         size_type        m_sigma = 0;    // alphabet size
         bit_vector_type  m_bv;           // bit vector to store the wavelet tree
@@ -121,6 +115,114 @@ class wt_pc
         }
 
 
+        // fills bv with multiple threads, see constructor
+        void construct_par(int_vector_buffer<tree_strat_type::int_width>& input_buf,
+                           const std::vector<size_type>& C, bit_vector& bv,
+                           uint64_t threads) {
+            int_vector<tree_strat_type::int_width> text(m_size, 0, input_buf.width());
+            for (size_type i=0; i < m_size; ++i) {
+                text[i] = input_buf[i];
+            }
+            const size_type nodes = m_tree.size();
+            const size_type chunk = (m_size+threads-1)/threads;
+            // (1) Count the bits of each chunk in each node
+            std::vector<std::vector<uint64_t>> node_pos(threads);
+            parallel_for(threads, threads, [&](uint64_t t, uint64_t) {
+                std::vector<size_type> cc(C.size(), 0);
+                for (size_type i=t*chunk; i < std::min(m_size, (t+1)*chunk); ++i) {
+                    ++cc[text[i]];
+                }
+                node_pos[t].assign(nodes, 0);
+                for (size_type c=0; c < cc.size(); ++c) {
+                    if (cc[c] > 0) {
+                        uint64_t p = m_tree.bit_path(c);
+                        uint32_t path_len = p>>56;
+                        node_type v = m_tree.root();
+                        for (uint32_t l=0; l<path_len; ++l, p >>= 1) {
+                            node_pos[t][v] += cc[c];
+                            v = m_tree.child(v, p&1);
+                        }
+                    }
+                }
+            });
+            // (2) Calculate the range of each chunk in each node. The first
+            //     and last word of a range may be shared with other chunks or
+            //     nodes.
+            std::vector<std::vector<uint64_t>> first_word(threads), last_word(threads);
+            for (uint64_t t=0; t < threads; ++t) {
+                first_word[t].assign(nodes, 0);
+                last_word[t].assign(nodes, 0);
+            }
+            for (size_type v=0; v < nodes; ++v) {
+                uint64_t pos = m_tree.bv_pos(v);
+                for (uint64_t t=0; t < threads; ++t) {
+                    uint64_t cnt = node_pos[t][v];
+                    node_pos[t][v] = pos;
+                    first_word[t][v] = pos>>6;
+                    last_word[t][v] = cnt ? (pos+cnt-1)>>6 : pos>>6;
+                    pos += cnt;
+                }
+            }
+            // (3) Set the bits. Bits in shared words are collected in masks
+            //     and combined afterwards.
+            std::vector<std::vector<uint64_t>> border_mask(threads);
+            parallel_for(threads, threads, [&](uint64_t t, uint64_t) {
+                std::vector<uint64_t>& pos = node_pos[t];
+                std::vector<uint64_t>& mask = border_mask[t];
+                mask.assign(2*nodes, 0);
+                uint64_t* data = bv.data();
+                auto insert = [&](value_type chr, uint64_t times) {
+                    uint64_t p = m_tree.bit_path(chr);
+                    uint32_t path_len = p>>56;
+                    node_type v = m_tree.root();
+                    for (uint32_t l=0; l<path_len; ++l, p >>= 1) {
+                        for (uint64_t b=pos[v], e=pos[v]+times; (p&1) and b < e;) {
+                            uint64_t w = b>>6, off = b&0x3F;
+                            uint64_t len = std::min(e-b, 64-off);
+                            uint64_t m = bits::lo_set[len] << off;
+                            if (w == first_word[t][v]) {
+                                mask[2*v] |= m;
+                            } else if (w == last_word[t][v]) {
+                                mask[2*v+1] |= m;
+                            } else {
+                                data[w] |= m;
+                            }
+                            b += len;
+                        }
+                        pos[v] += times;
+                        v = m_tree.child(v, p&1);
+                    }
+                };
+                size_type begin = std::min(m_size, t*chunk), end = std::min(m_size, (t+1)*chunk);
+                if (begin == end) {
+                    return;
+                }
+                value_type old_chr = text[begin];
+                uint32_t times = 0;
+                for (size_type i=begin; i < end; ++i) {
+                    value_type chr = text[i];
+                    if (chr != old_chr or times == 64) {
+                        insert(old_chr, times);
+                        times = 0;
+                        old_chr = chr;
+                    }
+                    ++times;
+                }
+                insert(old_chr, times);
+            });
+            util::clear(text);
+            uint64_t* data = bv.data();
+            for (uint64_t t=0; t < threads; ++t) {
+                for (size_type v=0; v < nodes; ++v) {
+                    if (border_mask[t][2*v]) {
+                        data[first_word[t][v]] |= border_mask[t][2*v];
+                    }
+                    if (border_mask[t][2*v+1]) {
+                        data[last_word[t][v]] |= border_mask[t][2*v+1];
+                    }
+                }
+            }
+        }
 
         // calculates the tree shape returns the size of the WT bit vector
         size_type construct_tree_shape(const std::vector<size_type>& C) {
@@ -190,11 +292,13 @@ class wt_pc
         /*!
          * \param input_buf    File buffer of the input.
          * \param size         The length of the prefix.
+         * \param threads      Number of threads used to fill the bit vector.
+         *                     For threads > 1 the prefix is loaded into memory.
          * \par Time complexity
          *      \f$ \Order{n\log|\Sigma|}\f$, where \f$n=size\f$
          */
         wt_pc(int_vector_buffer<tree_strat_type::int_width>& input_buf,
-              size_type size):m_size(size) {
+              size_type size, uint64_t threads=1):m_size(size) {
             if (0 == m_size)
                 return;
             // O(n + |\Sigma|\log|\Sigma|) algorithm for calculating node sizes
@@ -220,6 +324,13 @@ class wt_pc
                 throw std::logic_error("Stream size is smaller than size!");
                 return;
             }
+            if (threads > 1) {
+                construct_par(input_buf, C, temp_bv, threads);
+                m_bv = bit_vector_type(std::move(temp_bv));
+                construct_init_rank_select();
+                m_tree.init_node_ranks(m_bv_rank);
+                return;
+            }
             value_type old_chr = input_buf[0];
             uint32_t times = 0;
             for (size_type i=0; i < m_size; ++i) {
@@ -334,6 +445,15 @@ class wt_pc
             return m_tree.bv_pos_rank(v);
         };
 
+        //! Prefetches the data which is accessed first by rank(i, c).
+        /*! The lower levels depend on the result of the root node,
+         *  so only the root node is prefetched. This hides the first
+         *  cache miss when many independent queries are interleaved.
+         */
+        void prefetch(size_type i)const {
+            _prefetch(m_bv_rank, m_tree.bv_pos(m_tree.root()) + i, 0);
+        }
+
         //! Calculates how many symbols c are in the prefix [0..i-1].
         /*!
          * \param i Exclusive right bound of the range.
@@ -794,6 +914,16 @@ class wt_pc
         }
 };
 
+//! Constructs a wt_pc with multiple threads, see construct_wt.
+template<class t_shape, class t_bitvector, class t_rank, class t_select,
+         class t_select_zero, class t_tree_strat, class t_buf>
+void construct_wt(wt_pc<t_shape, t_bitvector, t_rank, t_select, t_select_zero, t_tree_strat>& wt,
+                  t_buf& buf, int_vector_size_type size, uint64_t threads)
+{
+    wt_pc<t_shape, t_bitvector, t_rank, t_select, t_select_zero, t_tree_strat> tmp(buf, size, threads);
+    wt.swap(tmp);
+}
+
 }
 
 #endif
@@ -16,9 +16,121 @@
 */
 #include "sdsl/bits.hpp"
 
+#ifdef SDSL_X86_DISPATCH
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 namespace sdsl
 {
 
+namespace
+{
+
+uint64_t cnt_words(const uint64_t* p, uint64_t n)
+{
+    uint64_t res = 0;
+    for (uint64_t i=0; i < n; ++i) {
+        res += bits::cnt(p[i]);
+    }
+    return res;
+}
+
+#ifdef SDSL_X86_DISPATCH
+// Counts 4 words per step: nibble popcounts by table lookup (VPSHUFB),
+// summed to 64-bit lanes with VPSADBW.
+__attribute__((target("avx2,popcnt")))
+uint64_t cnt_words_avx2(const uint64_t* p, uint64_t n)
+{
+    const __m256i lookup = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                            0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    __m256i acc = _mm256_setzero_si256();
+    uint64_t i = 0;
+    for (; i+4 <= n; i += 4) {
+        __m256i v  = _mm256_loadu_si256((const __m256i*)(p+i));
+        __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low_mask));
+        __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask));
+        acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+    }
+    uint64_t res = _mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1)
+                   + _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3);
+    for (; i < n; ++i) {
+        res += __builtin_popcountll(p[i]);
+    }
+    return res;
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+uint64_t cnt_words_avx512(const uint64_t* p, uint64_t n)
+{
+    __m512i acc = _mm512_setzero_si512();
+    uint64_t i = 0;
+    for (; i+8 <= n; i += 8) {
+        acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512((const void*)(p+i))));
+    }
+    uint64_t lanes[8];
+    _mm512_storeu_si512((void*)lanes, acc);
+    uint64_t res = lanes[0] + lanes[1] + lanes[2] + lanes[3]
+                   + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+    for (; i < n; ++i) {
+        res += __builtin_popcountll(p[i]);
+    }
+    return res;
+}
+
+bool cpu_fast_pdep()
+{
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("bmi2")) {
+        return false;
+    }
+    if (__builtin_cpu_is("amd")) {
+        // PDEP is microcoded and slow on AMD CPUs before Zen 3 (family 19h)
+        unsigned int a, b, c, d;
+        if (!__get_cpuid(1, &a, &b, &c, &d)) {
+            return false;
+        }
+        unsigned int family = (a >> 8) & 0xF;
+        if (family == 0xF) {
+            family += (a >> 20) & 0xFF;
+        }
+        return family >= 0x19;
+    }
+    return true;
+}
+#endif
+
+typedef uint64_t (*cnt_words_type)(const uint64_t*, uint64_t);
+
+cnt_words_type choose_cnt_words()
+{
+#ifdef SDSL_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512vpopcntdq")) {
+        return cnt_words_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return cnt_words_avx2;
+    }
+#endif
+    return cnt_words;
+}
+
+} // end anonymous namespace
+
+uint64_t bits::cnt(const uint64_t* p, uint64_t n)
+{
+    static const cnt_words_type f = choose_cnt_words();
+    return f(p, n);
+}
+
+#ifdef SDSL_X86_DISPATCH
+const bool bits::fast_pdep = cpu_fast_pdep();
+#else
+const bool bits::fast_pdep = false;
+#endif
+
 const uint8_t bits::lt_cnt[] = {
     0, 1, 1, 2, 1, 2, 2, 3,
     1, 2, 2, 3, 2, 3, 3, 4,
@@ -1,9 +1,297 @@
 #include "sdsl/bp_support_algorithm.hpp"
 
+#ifdef SDSL_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
 namespace sdsl
 {
 excess::impl excess::data;
 
+namespace
+{
+
+typedef bit_vector::difference_type difference_type;
+
+// Kernels on a word x of parentheses; e[p] denotes excess(x[0..p]).
+// The byte kernels use the lookup tables of sdsl::excess.
+struct excess_word {
+    // Minimal position p with e[p]==d, or 64.
+    static uint32_t first(uint64_t x, difference_type d)
+    {
+        difference_type e = 0;
+        for (uint32_t k=0; k < 64; k+=8, x>>=8) {
+            uint8_t y = x&0xFF;
+            difference_type t = d-e;
+            if (-8 <= t and t < 8) {
+                uint32_t p = excess::data.near_fwd_pos[((t+8)<<8)|y];
+                if (p < 8)
+                    return k+p;
+            } else if (t == 8 and y == 0xFF) {
+                return k+7;
+            }
+            e += excess::data.word_sum[y];
+        }
+        return 64;
+    }
+
+    // Maximal position p<k with e[p]==d, or 64.
+    static uint32_t last(uint64_t x, uint32_t k, difference_type d)
+    {
+        difference_type e[8]; // excess before each byte
+        e[0] = 0;
+        for (uint32_t b=1; b < 8; ++b)
+            e[b] = e[b-1] + excess::data.word_sum[(x>>(8*(b-1)))&0xFF];
+        for (uint32_t b=(k+7)/8; b > 0; --b) {
+            uint8_t y = (x>>(8*(b-1)))&0xFF;
+            difference_type t = d-e[b-1];
+            if (excess::data.min[y] <= t and t <= -excess::data.min[(uint8_t)~y]) {
+                uint32_t res = 64;
+                difference_type f = 0;
+                for (uint32_t p=0; p < 8 and 8*(b-1)+p < k; ++p) {
+                    f += ((y>>p)&1) ? 1 : -1;
+                    if (f == t)
+                        res = 8*(b-1)+p;
+                }
+                if (res < 64)
+                    return res;
+            }
+        }
+        return 64;
+    }
+
+    // Rightmost position p<k with minimal e[p]; the minimum is stored in m.
+    static uint32_t min_pos(uint64_t x, uint32_t k, difference_type& m)
+    {
+        difference_type e = 0;
+        uint32_t res = 0, p = 0;
+        m = 65;
+        for (; p+8 <= k; p+=8) {
+            uint8_t y = (x>>p)&0xFF;
+            if (e+excess::data.min[y] <= m) {
+                m   = e+excess::data.min[y];
+                res = p+excess::data.min_pos_max[y];
+            }
+            e += excess::data.word_sum[y];
+        }
+        for (; p < k; ++p) {
+            e += ((x>>p)&1) ? 1 : -1;
+            if (e <= m) {
+                m   = e;
+                res = p;
+            }
+        }
+        return res;
+    }
+};
+
+#ifdef SDSL_X86_DISPATCH
+// The AVX2 kernels calculate e[0..63] as two vectors of 32 signed bytes:
+// the bits are expanded to +1/-1 bytes and summed up by a parallel prefix sum.
+struct excess_word_avx2 {
+    __attribute__((target("avx2")))
+    static __m256i half_prefix_sum(uint32_t y)
+    {
+        const __m256i spread = _mm256_setr_epi8(0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1,
+                                                2,2,2,2,2,2,2,2,3,3,3,3,3,3,3,3);
+        const __m256i bit    = _mm256_set1_epi64x(0x8040201008040201ULL);
+        __m256i v = _mm256_shuffle_epi8(_mm256_set1_epi32(y), spread);
+        v = _mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit);
+        __m256i s = _mm256_add_epi8(_mm256_set1_epi8(-1), _mm256_and_si256(v, _mm256_set1_epi8(2)));
+        s = _mm256_add_epi8(s, _mm256_slli_si256(s, 1));
+        s = _mm256_add_epi8(s, _mm256_slli_si256(s, 2));
+        s = _mm256_add_epi8(s, _mm256_slli_si256(s, 4));
+        s = _mm256_add_epi8(s, _mm256_slli_si256(s, 8));
+        // add the sum of the lower lane to the upper lane
+        __m256i c = _mm256_shuffle_epi8(s, _mm256_set1_epi8(15));
+        return _mm256_add_epi8(s, _mm256_permute2x128_si256(c, c, 0x08));
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    static void prefix_sum(uint64_t x, __m256i& lo, __m256i& hi)
+    {
+        lo = half_prefix_sum((uint32_t)x);
+        hi = _mm256_add_epi8(half_prefix_sum((uint32_t)(x>>32)),
+                             _mm256_set1_epi8(2*__builtin_popcount((uint32_t)x)-32));
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    static uint64_t eq_mask(uint64_t x, difference_type d)
+    {
+        __m256i lo, hi;
+        prefix_sum(x, lo, hi);
+        const __m256i t = _mm256_set1_epi8((int8_t)d);
+        return (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, t))
+               | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, t)) << 32);
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    static uint32_t first(uint64_t x, difference_type d)
+    {
+        uint64_t m = eq_mask(x, d);
+        return m ? __builtin_ctzll(m) : 64;
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    static uint32_t last(uint64_t x, uint32_t k, difference_type d)
+    {
+        uint64_t m = eq_mask(x, d) & bits::lo_set[k];
+        return m ? 63-__builtin_clzll(m) : 64;
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    static uint32_t min_pos(uint64_t x, uint32_t k, difference_type& m)
+    {
+        __m256i lo, hi;
+        prefix_sum(x, lo, hi);
+        // positions >= k do not take part
+        const __m256i kk  = _mm256_set1_epi8((int8_t)k);
+        const __m256i max = _mm256_set1_epi8(127);
+        const __m256i idx = _mm256_setr_epi8(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,
+                                             16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31);
+        lo = _mm256_blendv_epi8(max, lo, _mm256_cmpgt_epi8(kk, idx));
+        hi = _mm256_blendv_epi8(max, hi, _mm256_cmpgt_epi8(kk, _mm256_add_epi8(idx, _mm256_set1_epi8(32))));
+        __m256i mn = _mm256_min_epi8(lo, hi);
+        __m128i t  = _mm_min_epi8(_mm256_castsi256_si128(mn), _mm256_extracti128_si256(mn, 1));
+        t = _mm_min_epi8(t, _mm_srli_si128(t, 8));
+        t = _mm_min_epi8(t, _mm_srli_si128(t, 4));
+        t = _mm_min_epi8(t, _mm_srli_si128(t, 2));
+        t = _mm_min_epi8(t, _mm_srli_si128(t, 1));
+        m = (int8_t)_mm_cvtsi128_si32(t);
+        const __m256i mm = _mm256_set1_epi8((int8_t)m);
+        uint64_t mask = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, mm))
+                        | ((uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, mm)) << 32);
+        return 63-__builtin_clzll(mask);
+    }
+};
+#endif
+
+// The range kernels process the words overlapping [l, r) from left to
+// right (or right to left) and skip words which can not contain the answer.
+template<class t_word>
+inline uint64_t fwd_excess_words(const uint64_t* b, uint64_t l, const uint64_t r, difference_type rel)
+{
+    while (l < r) {
+        const uint32_t k = std::min((uint64_t)64-(l&0x3F), r-l);
+        const uint64_t x = (b[l>>6] >> (l&0x3F)) & bits::lo_set[k];
+        if (-(difference_type)k <= rel and rel <= (difference_type)k) {
+            uint32_t p = t_word::first(x, rel);
+            if (p < k)
+                return l + p;
+        }
+        rel -= 2*(difference_type)bits::cnt(x) - k;
+        l += k;
+    }
+    return r;
+}
+
+template<class t_word>
+inline uint64_t bwd_excess_words(const uint64_t* b, const uint64_t l, uint64_t r, difference_type rel)
+{
+    const uint64_t end = r;
+    difference_type after = 0; // excess(bp[r..end-1])
+    while (l < r) {
+        const uint64_t s = std::max(l, (r-1) & ~(uint64_t)0x3F);
+        const uint32_t k = r-s;
+        const uint64_t x = (b[s>>6] >> (s&0x3F)) & bits::lo_set[k];
+        const difference_type sum = 2*(difference_type)bits::cnt(x) - k;
+        // excess(bp[s+p+1..end-1]) = after+sum-e[p]
+        const difference_type t = after + sum - rel;
+        if (-(difference_type)k <= t and t <= (difference_type)k) {
+            uint32_t p = t_word::last(x, k, t);
+            if (p < k)
+                return s + p;
+        }
+        after += sum;
+        r = s;
+    }
+    return end;
+}
+
+template<class t_word>
+inline uint64_t min_excess_words(const uint64_t* b, uint64_t l, const uint64_t r, difference_type& min_rel)
+{
+    uint64_t res = l;
+    difference_type e = 0;
+    min_rel = r-l+1;
+    while (l < r) {
+        const uint32_t k = std::min((uint64_t)64-(l&0x3F), r-l);
+        const uint64_t x = (b[l>>6] >> (l&0x3F)) & bits::lo_set[k];
+        difference_type m;
+        uint32_t p = t_word::min_pos(x, k, m);
+        if (e+m <= min_rel) {
+            min_rel = e+m;
+            res     = l+p;
+        }
+        e += 2*(difference_type)bits::cnt(x) - k;
+        l += k;
+    }
+    return res;
+}
+
+struct excess_range_kernels {
+    uint64_t (*fwd)(const uint64_t*, uint64_t, uint64_t, difference_type);
+    uint64_t (*bwd)(const uint64_t*, uint64_t, uint64_t, difference_type);
+    uint64_t (*min)(const uint64_t*, uint64_t, uint64_t, difference_type&);
+};
+
+#ifdef SDSL_X86_DISPATCH
+__attribute__((target("avx2,popcnt")))
+uint64_t fwd_excess_avx2(const uint64_t* b, uint64_t l, uint64_t r, difference_type rel)
+{
+    return fwd_excess_words<excess_word_avx2>(b, l, r, rel);
+}
+
+__attribute__((target("avx2,popcnt")))
+uint64_t bwd_excess_avx2(const uint64_t* b, uint64_t l, uint64_t r, difference_type rel)
+{
+    return bwd_excess_words<excess_word_avx2>(b, l, r, rel);
+}
+
+__attribute__((target("avx2,popcnt")))
+uint64_t min_excess_avx2(const uint64_t* b, uint64_t l, uint64_t r, difference_type& min_rel)
+{
+    return min_excess_words<excess_word_avx2>(b, l, r, min_rel);
+}
+#endif
+
+excess_range_kernels choose_excess_range_kernels()
+{
+#ifdef SDSL_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("popcnt")) {
+        return {fwd_excess_avx2, bwd_excess_avx2, min_excess_avx2};
+    }
+#endif
+    return {fwd_excess_words<excess_word>, bwd_excess_words<excess_word>, min_excess_words<excess_word>};
+}
+
+const excess_range_kernels& excess_kernels()
+{
+    static const excess_range_kernels k = choose_excess_range_kernels();
+    return k;
+}
+
+} // end anonymous namespace
+
+uint64_t
+fwd_excess_in_range(const bit_vector& bp, uint64_t l, uint64_t r, bit_vector::difference_type rel)
+{
+    return excess_kernels().fwd(bp.data(), l, r, rel);
+}
+
+uint64_t
+bwd_excess_in_range(const bit_vector& bp, uint64_t l, uint64_t r, bit_vector::difference_type rel)
+{
+    return excess_kernels().bwd(bp.data(), l, r, rel);
+}
+
+uint64_t
+min_excess_in_range(const bit_vector& bp, uint64_t l, uint64_t r, bit_vector::difference_type& min_rel)
+{
+    return excess_kernels().min(bp.data(), l, r, min_rel);
+}
+
 bit_vector
 calculate_pioneers_bitmap(const bit_vector& bp, uint64_t block_size)
 {
@@ -3,7 +3,7 @@
 
 namespace sdsl
 {
-cache_config::cache_config(bool f_delete_files, std::string f_dir, std::string f_id, tMSS f_file_map) : delete_files(f_delete_files), dir(f_dir), id(f_id), file_map(f_file_map)
+cache_config::cache_config(bool f_delete_files, std::string f_dir, std::string f_id, tMSS f_file_map, uint64_t f_threads) : delete_files(f_delete_files), dir(f_dir), id(f_id), file_map(f_file_map), threads(f_threads)
 {
     if ("" == id) {
         id = util::to_string(util::pid())+"_"+util::to_string(util::id());
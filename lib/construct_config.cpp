@@ -4,5 +4,10 @@ namespace sdsl
 {
 
 byte_sa_algo_type construct_config::byte_algo_sa = LIBDIVSUFSORT;
+int_sa_algo_type  construct_config::int_algo_sa  = QSUFSORT;
+bwt_algo_type     construct_config::bwt_algo     = BWT_FROM_SA;
+uint64_t          construct_config::bwt_block_size = 0; // derived from memory_budget
+bool              construct_config::async_io     = false;
+uint64_t          construct_config::memory_budget = 1ULL<<32;
 
 }
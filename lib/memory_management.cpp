@@ -1,7 +1,13 @@
 #include <chrono>
 #include <algorithm>
+#include <fstream>
 #include "sdsl/memory_management.hpp"
 
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
 using namespace std::chrono;
 
 namespace sdsl
@@ -645,4 +651,172 @@ hugepage_allocator::determine_available_hugepage_memory()
 }
 #endif
 
+#ifndef MSVC_COMPILER
+// number of NUMA nodes the kernel may use, 1 if unknown
+static uint32_t
+numa_possible_nodes()
+{
+    std::ifstream in("/sys/devices/system/node/possible");
+    std::string line;
+    if (!std::getline(in, line) or line.empty()) {
+        return 1;
+    }
+    // format: "0" or "0-3" or "0,2-5"; the last number is the largest node id
+    size_t pos = line.find_last_of(",-");
+    return std::stoul(pos == std::string::npos ? line : line.substr(pos+1)) + 1;
+}
+
+void
+policy_allocator::apply_numa(SDSL_UNUSED void* addr, SDSL_UNUSED size_t len, const alloc_policy& policy)
+{
+    if (policy.numa == alloc_policy::first_touch) {
+        return;
+    }
+#if defined(__linux__) && defined(SYS_mbind)
+    const int mpol_preferred  = 1;
+    const int mpol_interleave = 3;
+    static const uint32_t nodes = numa_possible_nodes();
+    std::vector<unsigned long> mask((nodes+63)/64, 0);
+    int mode = mpol_interleave;
+    if (policy.numa == alloc_policy::interleave) {
+        if (nodes < 2) {
+            return;
+        }
+        for (uint32_t i=0; i < nodes; ++i) {
+            mask[i/64] |= 1UL << (i%64);
+        }
+    } else {
+        if (policy.node >= nodes) {
+            return;
+        }
+        mask[policy.node/64] |= 1UL << (policy.node%64);
+        mode = mpol_preferred;
+    }
+    // best effort: e.g. containers may forbid mbind
+    syscall(SYS_mbind, addr, len, mode, mask.data(), mask.size()*64+1, 0);
+#endif
+}
+
+uint8_t*
+policy_allocator::map_block(size_t size, block& b)
+{
+    alloc_policy p = policy();
+    uint8_t* addr = nullptr;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    if (p.pages == alloc_policy::hugepages_1g) {
+        b.align = 1ULL << 30;
+        b.len   = (size + b.align-1) & ~(b.align-1);
+        void* a = mmap(nullptr, b.len, (PROT_READ | PROT_WRITE),
+                       (MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT)), -1, 0);
+        if (a != MAP_FAILED) {
+            addr = (uint8_t*)a;
+        }
+    }
+#endif
+    if (addr == nullptr) { // no 1GB pages available -> transparent hugepages
+        bool huge = p.pages != alloc_policy::default_pages;
+        b.align = huge ? (2ULL << 20) : 4096;
+        b.len   = (size + b.align-1) & ~(b.align-1);
+        size_t map_len = b.len + (huge ? b.align : 0);
+        void* a = mmap(nullptr, map_len, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+        if (a == MAP_FAILED) {
+            return nullptr;
+        }
+        addr = (uint8_t*)a;
+        if (huge) {
+            // cut the mapping down to a 2MB aligned range, which the kernel can back with huge pages
+            uint8_t* aligned = (uint8_t*)(((uintptr_t)addr + b.align-1) & ~(uintptr_t)(b.align-1));
+            if (aligned > addr) {
+                munmap(addr, aligned-addr);
+            }
+            if (aligned+b.len < addr+map_len) {
+                munmap(aligned+b.len, (addr+map_len)-(aligned+b.len));
+            }
+            addr = aligned;
+#ifdef MADV_HUGEPAGE
+            madvise(addr, b.len, MADV_HUGEPAGE);
+#endif
+        }
+    }
+    // the pages are not touched yet, so the placement applies to all of them
+    apply_numa(addr, b.len, p);
+    return addr;
+}
+
+size_t
+policy_allocator::block_length(void* ptr)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_blocks.upper_bound((uint8_t*)ptr);
+    if (it == m_blocks.begin()) {
+        return 0;
+    }
+    --it;
+    return ((uint8_t*)ptr < it->first + it->second.len) ? it->second.len : 0;
+}
+
+void*
+policy_allocator::mm_alloc(size_t size_in_bytes)
+{
+    block b;
+    uint8_t* addr = map_block(std::max(size_in_bytes, (size_t)1), b);
+    if (addr != nullptr) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocks[addr] = b;
+        ++m_cnt;
+    }
+    return addr;
+}
+
+void
+policy_allocator::mm_free(void* ptr)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_blocks.find((uint8_t*)ptr);
+    if (it != m_blocks.end()) {
+        munmap(it->first, it->second.len);
+        m_blocks.erase(it);
+        --m_cnt;
+    }
+}
+
+void*
+policy_allocator::mm_realloc(void* ptr, size_t size)
+{
+    if (nullptr == ptr) return mm_alloc(size);
+    if (size == 0) {
+        mm_free(ptr);
+        return nullptr;
+    }
+    block b;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        b = m_blocks.at((uint8_t*)ptr);
+    }
+    size_t len = (size + b.align-1) & ~(b.align-1);
+    if (len == b.len) {
+        return ptr;
+    }
+#ifdef MREMAP_MAYMOVE
+    // The moved and the new pages keep the page size advice and NUMA policy
+    // of the mapping. A moved mapping is only page aligned, so mappings of
+    // huge pages are resized in place or copied to a new aligned mapping.
+    int flags = b.align > 4096 ? 0 : MREMAP_MAYMOVE;
+    void* a = mremap(ptr, b.len, len, flags);
+    if (a != MAP_FAILED) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_blocks.erase((uint8_t*)ptr);
+        m_blocks[(uint8_t*)a] = block{len, b.align};
+        return a;
+    }
+#endif
+    void* p = mm_alloc(size);
+    if (p != nullptr) {
+        memcpy(p, ptr, std::min(size, b.len));
+        mm_free(ptr);
+    }
+    return p;
+}
+#endif
+
 }
@@ -0,0 +1,87 @@
+#include "sdsl/mmap_filebuf.hpp"
+#include "sdsl/memory_management.hpp"
+
+namespace sdsl
+{
+
+mmap_filebuf::~mmap_filebuf()
+{
+    close();
+}
+
+mmap_filebuf*
+mmap_filebuf::open(const std::string& file)
+{
+    close();
+    std::string name = file;
+    int fd = memory_manager::open_file_for_mmap(name, std::ios_base::in);
+    if (fd == -1) {
+        return nullptr;
+    }
+    uint64_t size = util::file_size(name);
+    if (0 == size) {
+        memory_manager::close_file_for_mmap(fd);
+        return nullptr;
+    }
+    // int_vector expects a readable padding word after its data, so the
+    // last member of the file needs eight zero bytes after the file
+    void* map = memory_manager::mmap_file_private(fd, size, 8);
+    memory_manager::close_file_for_mmap(fd); // the mapping keeps the file open
+    if (map == nullptr) {
+        return nullptr;
+    }
+    memory_manager::register_mapped(map, size+8);
+    m_base = (char*)map;
+    m_size = size;
+    setg(m_base, m_base, m_base+m_size);
+    return this;
+}
+
+mmap_filebuf*
+mmap_filebuf::close()
+{
+    if (!is_open()) {
+        return nullptr;
+    }
+    memory_manager::release_mapped(m_base);
+    m_base = nullptr;
+    m_size = 0;
+    setg(nullptr, nullptr, nullptr);
+    return this;
+}
+
+uint64_t*
+mmap_filebuf::map(uint64_t bytes, uint64_t align)
+{
+    // the mapping starts at a page boundary, so the address tells the file offset
+    if (!is_open() or (uint64_t)(egptr()-gptr()) < bytes or ((uintptr_t)gptr() % align) != 0) {
+        return nullptr;
+    }
+    char* p = gptr();
+    memory_manager::acquire_mapped(p);
+    setg(eback(), p+bytes, egptr());
+    return (uint64_t*)p;
+}
+
+mmap_filebuf::pos_type
+mmap_filebuf::seekoff(off_type off, std::ios_base::seekdir way, std::ios_base::openmode which)
+{
+    if (std::ios_base::cur == way) {
+        off += gptr()-eback();
+    } else if (std::ios_base::end == way) {
+        off += m_size;
+    }
+    return seekpos(off, which);
+}
+
+mmap_filebuf::pos_type
+mmap_filebuf::seekpos(pos_type sp, std::ios_base::openmode which)
+{
+    if (!is_open() or !(which & std::ios_base::in) or sp < (pos_type)0 or sp > (pos_type)m_size) {
+        return pos_type(off_type(-1));
+    }
+    setg(m_base, m_base+(off_type)sp, m_base+m_size);
+    return sp;
+}
+
+}
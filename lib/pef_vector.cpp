@@ -0,0 +1,125 @@
+#include "sdsl/pef_vector.hpp"
+
+#include <limits>
+#include <vector>
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+pef_vector_builder::pef_vector_builder() :
+    m_size(0), m_capacity(0),
+    m_tail(0), m_items(0)
+{
+}
+
+pef_vector_builder::pef_vector_builder(size_type n, size_type m) :
+    m_size(n), m_capacity(m),
+    m_tail(0), m_items(0)
+{
+    if (m_capacity > m_size) {
+        throw std::runtime_error("pef_vector_builder: requested capacity is larger than vector size.");
+    }
+    m_pos = int_vector<>(m_capacity, 0, m_size ? bits::hi(m_size)+1 : 1);
+}
+
+void
+pef_vector_builder::swap(pef_vector_builder& pb)
+{
+    std::swap(m_size, pb.m_size);
+    std::swap(m_capacity, pb.m_capacity);
+    std::swap(m_tail, pb.m_tail);
+    std::swap(m_items, pb.m_items);
+    m_pos.swap(pb.m_pos);
+}
+
+void
+pef_vector::build(const int_vector<>& pos)
+{
+    auto width = [](size_type x) -> uint8_t { return x ? bits::hi(x)+1 : 1; };
+    const size_type m = pos.size();
+    m_ones = m;
+
+    // (1) Optimal partition: cost[e] is the minimal size of the first e*g ones,
+    // where the top level entries of a chunk are charged with `overhead` bits.
+    const size_type g = chunk_granularity, max_steps = max_chunk_size/chunk_granularity;
+    const size_type nb = (m+g-1)/g;
+    const uint64_t overhead = 2*width(m_size) + 2*width(m);
+    std::vector<uint64_t> cost(nb+1, std::numeric_limits<uint64_t>::max());
+    std::vector<size_type> from(nb+1, 0);
+    cost[0] = 0;
+    for (size_type b=0; b < nb; ++b) {
+        const size_type i = b*g, base = i ? pos[i-1]+1 : 0, first = pos[i];
+        for (size_type e=b+1; e <= std::min(nb, b+max_steps); ++e) {
+            const size_type j = std::min(m, e*g), last = pos[j-1];
+            uint64_t c = cost[b] + overhead + payload_bits(j-i, last-base+1, last-first+1);
+            if (c < cost[e]) {
+                cost[e] = c;
+                from[e] = b;
+            }
+        }
+    }
+    std::vector<size_type> bounds(1, m);
+    for (size_type e=nb; e > 0; e = from[e]) {
+        bounds.push_back(from[e]*g);
+    }
+    std::reverse(bounds.begin(), bounds.end());
+    const size_type chunks = bounds.size()-1;
+
+    // (2) Top level and payloads
+    m_end = int_vector<>(chunks, 0, width(m_size));
+    m_cnt = int_vector<>(chunks, 0, width(m));
+    std::vector<size_type> off(chunks+1, 0);
+    for (size_type c=0; c < chunks; ++c) {
+        const size_type i = bounds[c], j = bounds[c+1];
+        const size_type base = i ? pos[i-1]+1 : 0;
+        m_end[c] = pos[j-1];
+        m_cnt[c] = i;
+        off[c+1] = off[c] + payload_bits(j-i, pos[j-1]-base+1, pos[j-1]-pos[i]+1);
+    }
+    m_off  = int_vector<>(chunks+1, 0, width(off[chunks]));
+    m_data = bit_vector(off[chunks], 0);
+    for (size_type c=0; c < chunks; ++c) {
+        m_off[c] = off[c];
+        const size_type i = bounds[c], k = bounds[c+1]-i;
+        const size_type base = i ? pos[i-1]+1 : 0, u = m_end[c]-base+1;
+        if (off[c+1] == off[c]) {  // run
+            continue;
+        }
+        if (u <= ef_bits(k, u)) {  // bitmap
+            for (size_type t=0; t < k; ++t) {
+                m_data[off[c] + pos[i+t]-base] = 1;
+            }
+        } else {  // Elias-Fano
+            const uint8_t wl = ef_width(k, u);
+            for (size_type t=0; t < k; ++t) {
+                size_type x = pos[i+t]-base;
+                if (wl) {
+                    m_data.set_int(off[c] + t*wl, x & bits::lo_set[wl], wl);
+                }
+                m_data[off[c] + k*wl + (x>>wl) + t] = 1;
+            }
+        }
+    }
+    m_off[chunks] = off[chunks];
+
+    // (3) Samples: about one rank and one select sample per chunk
+    m_rank_shift = bits::hi(std::max((size_type)1, m_size/std::max((size_type)1, chunks)));
+    m_rank_samples = int_vector<>((m_size >> m_rank_shift)+2, 0, width(chunks));
+    for (size_type b=0, c=0; b < m_rank_samples.size(); ++b) {
+        while (c < chunks and m_end[c] < (b << m_rank_shift)) {
+            ++c;
+        }
+        m_rank_samples[b] = c;
+    }
+    m_select_shift = bits::hi(std::max((size_type)1, m/std::max((size_type)1, chunks)));
+    m_select_samples = int_vector<>((m >> m_select_shift)+2, 0, width(chunks));
+    for (size_type b=0, c=0; b < m_select_samples.size(); ++b) {
+        while (c+1 < chunks and m_cnt[c+1] <= (b << m_select_shift)) {
+            ++c;
+        }
+        m_select_samples[b] = c;
+    }
+}
+
+} // end namespace
@@ -0,0 +1,66 @@
+#include "sdsl/posting_list_algorithm.hpp"
+
+#ifdef SDSL_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+//! Namespace for the succinct data structure library
+namespace sdsl
+{
+
+namespace
+{
+
+uint64_t first_geq_scalar(const uint64_t* a, uint64_t n, uint64_t x)
+{
+    uint64_t i = 0;
+    while (i < n and a[i] < x) {
+        ++i;
+    }
+    return i;
+}
+
+#ifdef SDSL_X86_DISPATCH
+// Compares 8 elements per step. The elements are smaller than 2^63, so
+// the signed comparison is correct; the mask has a one for each a[i] < x.
+__attribute__((target("avx2")))
+uint64_t first_geq_avx2(const uint64_t* a, uint64_t n, uint64_t x)
+{
+    const __m256i vx = _mm256_set1_epi64x((int64_t)x);
+    uint64_t i = 0;
+    for (; i+8 <= n; i += 8) {
+        __m256i lt0 = _mm256_cmpgt_epi64(vx, _mm256_loadu_si256((const __m256i*)(a+i)));
+        __m256i lt1 = _mm256_cmpgt_epi64(vx, _mm256_loadu_si256((const __m256i*)(a+i+4)));
+        uint32_t m = _mm256_movemask_pd(_mm256_castsi256_pd(lt0))
+                     | (_mm256_movemask_pd(_mm256_castsi256_pd(lt1)) << 4);
+        if (m != 0xFF) {
+            return i + bits::lo(~m);
+        }
+    }
+    return i + first_geq_scalar(a+i, n-i, x);
+}
+#endif
+
+typedef uint64_t (*first_geq_type)(const uint64_t*, uint64_t, uint64_t);
+
+first_geq_type choose_first_geq()
+{
+#ifdef SDSL_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return first_geq_avx2;
+    }
+#endif
+    return first_geq_scalar;
+}
+
+} // end anonymous namespace
+
+uint64_t
+first_geq_in_block(const uint64_t* a, uint64_t n, uint64_t x)
+{
+    static const first_geq_type f = choose_first_geq();
+    return f(a, n, x);
+}
+
+} // end namespace
@@ -22,6 +22,7 @@ bit_vector_il<128>,
 bit_vector_il<256>,
 bit_vector_il<512>,
 bit_vector_il<1024>,
+bit_vector_cl,
 rrr_vector<64>,
 rrr_vector<256>,
 rrr_vector<129>,
@@ -35,7 +36,8 @@ rrr_vector<127>,
 rrr_vector<128>,
 sd_vector<>,
 sd_vector<rrr_vector<63> >,
-hyb_vector<>
+hyb_vector<>,
+pef_vector
 > Implementations;
 
 
@@ -109,6 +111,48 @@ TYPED_TEST(bit_vector_test, swap)
     }
 }
 
+// A byte in front of the bit vector moves its data to an odd file offset
+template<class t_bv>
+struct odd_offset_bv {
+    typedef typename t_bv::size_type size_type;
+    uint8_t c = 0;
+    t_bv bv;
+
+    uint64_t serialize(std::ostream& out, structure_tree_node* v=nullptr, std::string="")const
+    {
+        uint64_t written_bytes = write_member(c, out, v, "c");
+        written_bytes += bv.serialize(out, v, "bv");
+        return written_bytes;
+    }
+
+    void load(std::istream& in)
+    {
+        read_member(c, in);
+        bv.load(in);
+    }
+};
+
+//! Test loading from a memory mapped file with unaligned data
+TYPED_TEST(bit_vector_test, load_mapped_unaligned)
+{
+    bit_vector bv;
+    ASSERT_TRUE(load_from_file(bv, test_file));
+    odd_offset_bv<TypeParam> x;
+    x.c = 1;
+    x.bv = TypeParam(bv);
+    string file_name = test_file + ".odd_offset";
+    ASSERT_TRUE(store_to_file(x, file_name));
+    {
+        odd_offset_bv<TypeParam> y;
+        ASSERT_TRUE(load_from_file_mapped(y, file_name));
+        ASSERT_EQ(bv.size(), y.bv.size());
+        for (uint64_t j=0; j < bv.size(); ++j) {
+            ASSERT_EQ((bool)(bv[j]), (bool)(y.bv[j]));
+        }
+    }
+    sdsl::remove(file_name);
+}
+
 /*
 TEST(SD_VECTOR, IteratorConstructor)
 {
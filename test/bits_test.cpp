@@ -154,6 +154,38 @@ TEST_F(bits_test, sel)
     }
 }
 
+TEST_F(bits_test, cnt_words)
+{
+    const uint64_t* p = this->m_data.data();
+    for (uint64_t n=0; n < 100; ++n) {
+        for (uint64_t b=0; b < 8; ++b) {
+            uint64_t res = 0;
+            for (uint64_t i=b; i < b+n; ++i) {
+                res += cnt_naive(p[i]);
+            }
+            ASSERT_EQ(res, sdsl::bits::cnt(p+b, n)) << "b=" << b << " n=" << n;
+        }
+    }
+    uint64_t res = 0;
+    for (uint64_t i=0; i < this->m_data.size(); ++i) {
+        res += cnt_naive(p[i]);
+    }
+    ASSERT_EQ(res, sdsl::bits::cnt(p, this->m_data.size()));
+}
+
+TEST_F(bits_test, sel_pdep)
+{
+    if (!sdsl::bits::fast_pdep) {
+        return;
+    }
+    for (uint64_t i=0; i < this->m_data.size(); ++i) {
+        uint64_t x = this->m_data[i];
+        for (uint32_t j=1; j <= sdsl::bits::cnt(x); ++j) {
+            ASSERT_EQ(sdsl::bits::_sel(x, j), sdsl::bits::_sel_pdep(x, j));
+        }
+    }
+}
+
 TEST_F(bits_test, hi)
 {
     for (uint64_t i=0; i<64; ++i) {
@@ -3,6 +3,7 @@
 #include "gtest/gtest.h"
 #include <vector>
 #include <string>
+#include <random>
 
 namespace
 {
@@ -38,6 +39,7 @@ csa_wt<>,
        csa_sada<enc_vector<>, 32,32,text_order_sa_sampling<>,isa_sampling<>>,
        csa_sada<enc_vector<>, 32,32,text_order_sa_sampling<>,text_order_isa_sampling_support<>>,
        csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>>,
+       csa_wt<wm_kary<3>, 32, 32, sa_order_sa_sampling<>, isa_sampling<>, byte_alphabet>,
        csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>, isa_sampling<>, succinct_byte_alphabet<bit_vector, rank_support_v<>, select_support_mcl<>>>,
        csa_wt<wt_huff<>, 8, 16, sa_order_sa_sampling<>, isa_sampling<>, succinct_byte_alphabet<>>,
        csa_bitcompressed<>
@@ -83,6 +85,75 @@ TYPED_TEST(csa_byte_test, backward_search)
     ASSERT_EQ(r_res, (size_type)(csa.size() - 1));
 }
 
+//! Test count_batch
+TYPED_TEST(csa_byte_test, count_batch)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    std::mt19937_64 rng(13);
+    std::vector<std::string> pats(1); // starts with the empty pattern
+    for (size_type i=0; i < 1000 and text.size() > 0; ++i) {
+        size_type pos = rng() % text.size();
+        size_type len = 1 + rng() % 20;
+        std::string pat(text.begin()+pos, text.begin()+std::min(text.size(), pos+len));
+        if (i % 4 == 0) {
+            pat[rng() % pat.size()] = (char)(1 + rng() % 255); // likely no occurrence
+        }
+        pats.push_back(pat);
+    }
+    auto cnts = count_batch(csa, pats);
+    ASSERT_EQ(pats.size(), cnts.size());
+    for (size_type i=0; i < pats.size(); ++i) {
+        ASSERT_EQ(count(csa, pats[i].begin(), pats[i].end()), cnts[i]) << "i=" << i;
+    }
+}
+
+//! Test locate_par
+TYPED_TEST(csa_byte_test, locate_par)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    std::mt19937_64 rng(17);
+    for (size_type i=0; i < 20 and text.size() > 0; ++i) {
+        size_type pos = rng() % text.size();
+        size_type len = i % 4; // short patterns have many occurrences
+        std::string pat(text.begin()+pos, text.begin()+std::min(text.size(), pos+len));
+        auto occ = locate(csa, pat.begin(), pat.end());
+        for (uint64_t threads : {1, 3}) {
+            auto occ_par = locate_par(csa, pat.begin(), pat.end(), threads);
+            ASSERT_EQ(occ, occ_par) << "i=" << i << " threads=" << threads;
+        }
+    }
+}
+
+//! Test concurrent counting on one CSA
+TYPED_TEST(csa_byte_test, concurrent_count)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    std::mt19937_64 rng(19);
+    std::vector<std::string> pats;
+    for (size_type i=0; i < 1000 and text.size() > 0; ++i) {
+        size_type pos = rng() % text.size();
+        size_type len = 1 + rng() % 20;
+        pats.emplace_back(text.begin()+pos, text.begin()+std::min(text.size(), pos+len));
+    }
+    std::vector<size_type> cnts(pats.size()), cnts_par(pats.size());
+    for (size_type i=0; i < pats.size(); ++i) {
+        cnts[i] = count(csa, pats[i].begin(), pats[i].end());
+    }
+    parallel_for(pats.size(), 4, [&](uint64_t i, uint64_t) {
+        cnts_par[i] = count(csa, pats[i].begin(), pats[i].end());
+    });
+    ASSERT_EQ(cnts, cnts_par);
+}
+
 //! Test forward_search
 TYPED_TEST(csa_byte_test, forward_search)
 {
@@ -268,6 +339,38 @@ TYPED_TEST(csa_byte_test, swap)
     }
 }
 
+//! Test merge_csa of three parts of the text
+TYPED_TEST(csa_byte_test, merge)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    int_vector<8> text;
+    ASSERT_TRUE(load_vector_from_file(text, test_file, 1));
+    size_type n = text.size();
+    std::vector<size_type> cut = {0, n/2, n/2+n/8, n};
+    std::vector<TypeParam> part(3);
+    for (size_type j=0; j < 3; ++j) {
+        construct_im(part[j], std::string(text.begin()+cut[j], text.begin()+cut[j+1]), 1);
+    }
+    cache_config config(true, temp_dir, util::basename(test_file)+"_merge");
+    TypeParam res = part[2];
+    for (size_type j=2; j > 0; --j) {
+        config.threads = j;
+        TypeParam tmp;
+        merge_csa(tmp, part[j-1], res, config);
+        res.swap(tmp);
+        ASSERT_EQ(cut[3]-cut[j-1]+1, res.size());
+    }
+    ASSERT_EQ(csa.size(), res.size());
+    for (size_type j=0; j < csa.size(); ++j) {
+        ASSERT_EQ(csa[j], res[j]) << "j=" << j;
+    }
+    std::stringstream ss1, ss2;
+    csa.serialize(ss1);
+    res.serialize(ss2);
+    ASSERT_EQ(ss1.str(), ss2.str());
+}
+
 
 TYPED_TEST(csa_byte_test, delete_)
 {
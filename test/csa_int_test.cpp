@@ -209,6 +209,59 @@ TYPED_TEST(csa_int_test, swap_test)
     }
 }
 
+//! Test the construction with the semi-external BWT construction
+TYPED_TEST(csa_int_test, construct_bwt_se)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    auto bwt_algo   = construct_config::bwt_algo;
+    auto block_size = construct_config::bwt_block_size;
+    construct_config::bwt_algo       = BWT_SE_BLOCKWISE;
+    construct_config::bwt_block_size = csa.size()/3+1; // several blocks
+    TypeParam csa_se;
+    cache_config config(false, temp_dir, util::basename(test_file)+"_bwt_se");
+    construct(csa_se, test_file, config, num_bytes);
+    construct_config::bwt_algo       = bwt_algo;
+    construct_config::bwt_block_size = block_size;
+    util::delete_all_files(config.file_map);
+    ASSERT_EQ(csa.size(), csa_se.size());
+    for (size_type j=0; j<csa.size(); ++j) {
+        ASSERT_EQ(csa[j], csa_se[j])<<" j="<<j;
+        ASSERT_EQ(csa.bwt[j], csa_se.bwt[j])<<" j="<<j;
+    }
+}
+
+//! Test merge_csa of three parts of the text
+TYPED_TEST(csa_int_test, merge)
+{
+    TypeParam csa;
+    ASSERT_TRUE(load_from_file(csa, temp_file));
+    int_vector<> text;
+    load_vector_from_file(text, test_file, num_bytes);
+    size_type n = text.size();
+    std::vector<size_type> cut = {0, n/2, n/2+n/8, n};
+    std::vector<TypeParam> part(3);
+    for (size_type j=0; j < 3; ++j) {
+        int_vector<> p(cut[j+1]-cut[j], 0, text.width());
+        std::copy(text.begin()+cut[j], text.begin()+cut[j+1], p.begin());
+        construct_im(part[j], p, 0);
+    }
+    cache_config config(true, temp_dir, util::basename(test_file)+"_merge");
+    TypeParam res = part[2];
+    for (size_type j=2; j > 0; --j) {
+        config.threads = j;
+        TypeParam tmp;
+        merge_csa(tmp, part[j-1], res, config);
+        res.swap(tmp);
+        ASSERT_EQ(cut[3]-cut[j-1]+1, res.size());
+    }
+    ASSERT_EQ(csa.size(), res.size());
+    for (size_type j=0; j < csa.size(); ++j) {
+        ASSERT_EQ(csa[j], res[j]) << "j=" << j;
+        ASSERT_EQ(csa.bwt[j], res.bwt[j]) << "j=" << j;
+    }
+}
+
 TYPED_TEST(csa_int_test, DeleteTest)
 {
     sdsl::remove(temp_file);
@@ -1,6 +1,7 @@
 #include "cst_helper.hpp"
 #include "sdsl/suffix_trees.hpp"
 #include "gtest/gtest.h"
+#include <numeric>
 #include <vector>
 #include <string>
 #include <set>
@@ -42,6 +43,8 @@ cst_sct3<>,
          cst_sct3<cst_sct3<>::csa_type, lcp_support_sada<> >,
          cst_sct3<cst_sct3<>::csa_type, lcp_wt<> >,
          cst_sct3<cst_sct3<>::csa_type, lcp_support_tree<>, bp_support_g<> >,
+         cst_sada<cst_sada<>::csa_type, lcp_dac<>, bp_support_rmm<>>,
+         cst_sct3<cst_sct3<>::csa_type, lcp_dac<>, bp_support_rmm<>>,
          cst_sct3<csa_bitcompressed<>, lcp_bitcompressed<> >
          > Implementations;
 
@@ -188,6 +191,53 @@ TYPED_TEST(cst_byte_test, move_lcp_access)
     }
 }
 
+//! Test concurrent queries on one CST with a query_context per thread
+TYPED_TEST(cst_byte_test, concurrent_queries)
+{
+    TypeParam cst;
+    ASSERT_TRUE(load_from_file(cst, temp_file));
+    sdsl::int_vector<> sa, lcp;
+    sdsl::load_from_file(sa, test_case_file_map[sdsl::conf::KEY_SA]);
+    sdsl::load_from_file(lcp, test_case_file_map[sdsl::conf::KEY_LCP]);
+    const uint64_t threads = 4;
+    std::vector<query_context<TypeParam>> ctx(threads, query_context<TypeParam>(cst));
+    std::vector<size_type> errors(threads, 0);
+    // every position is queried twice, so the cached answers are used too
+    parallel_for(2*sa.size(), threads, [&](uint64_t k, uint64_t t) {
+        size_type j = k % sa.size();
+        auto v = cst.select_leaf(j+1);
+        errors[t] += ctx[t].sa(j) != sa[j];
+        errors[t] += ctx[t].isa(sa[j]) != j;
+        errors[t] += ctx[t].lcp(j) != lcp[j];
+        if (v != cst.root()) { // for a single suffix the root of cst_sada is a leaf of depth 0
+            errors[t] += cst.depth(v) != cst.size()-sa[j];
+            errors[t] += cst.sn(v) != sa[j];
+        }
+    }, 64);
+    for (uint64_t t=0; t < threads; ++t) {
+        ASSERT_EQ((size_type)0, errors[t]) << "t=" << t;
+    }
+}
+
+//! Test loading from a memory mapped file
+TYPED_TEST(cst_byte_test, load_mapped)
+{
+    TypeParam cst;
+    ASSERT_TRUE(load_from_file_mapped(cst, temp_file));
+    sdsl::int_vector<> sa;
+    sdsl::load_from_file(sa, test_case_file_map[sdsl::conf::KEY_SA]);
+    sdsl::int_vector<> lcp;
+    sdsl::load_from_file(lcp, test_case_file_map[sdsl::conf::KEY_LCP]);
+    size_type n = sa.size();
+    ASSERT_EQ(n, cst.csa.size());
+    ASSERT_EQ(n, cst.lcp.size());
+    for (size_type j=0; j<n; ++j) {
+        ASSERT_EQ(sa[j], cst.csa[j])<<" j="<<j;
+        ASSERT_EQ(lcp[j], cst.lcp[j])<<" j="<<j;
+    }
+    check_node_method(cst);
+}
+
 template<typename t_cst>
 void test_id(typename std::enable_if<!(has_id<t_cst>::value), t_cst>::type&)
 {
@@ -436,6 +486,134 @@ TYPED_TEST(cst_byte_test, lca_method)
     }
 }
 
+//! Test matching_statistics, longest_common_substring and ms_stream
+TYPED_TEST(cst_byte_test, matching_statistics)
+{
+    TypeParam cst;
+    ASSERT_TRUE(load_from_file(cst, temp_file));
+    int_vector<8> data;
+    ASSERT_TRUE(load_vector_from_file(data, test_file, 1));
+    // pattern: substrings of the text and random characters
+    std::mt19937_64 rng(13);
+    std::vector<uint8_t> pat;
+    while (pat.size() < 2000) {
+        if (data.size() > 0 and rng() % 4) {
+            size_type len = 1 + rng() % 100;
+            size_type pos = rng() % data.size();
+            for (size_type i=pos; i < pos+len and i < data.size(); ++i)
+                pat.push_back(data[i]);
+        } else {
+            pat.push_back(1 + rng() % 255);
+        }
+    }
+    auto ms = matching_statistics(cst, pat.begin(), pat.end());
+    ASSERT_EQ(pat.size(), ms.size());
+    size_type max_i = 0;
+    for (size_type i=0; i < pat.size(); ++i) {
+        // binary search for the longest prefix of pat[i..] which occurs
+        size_type lo = 0, hi = pat.size()-i;
+        while (lo < hi) {
+            size_type mid = (lo+hi+1)/2;
+            if (sdsl::count(cst.csa, pat.begin()+i, pat.begin()+i+mid) > 0)
+                lo = mid;
+            else
+                hi = mid-1;
+        }
+        ASSERT_EQ(lo, ms[i]) << "i=" << i;
+        if (ms[i] > ms[max_i])
+            max_i = i;
+    }
+    auto lcs = longest_common_substring(cst, pat.begin(), pat.end());
+    ASSERT_EQ(max_i, lcs.first);
+    ASSERT_EQ((size_type)ms[max_i], lcs.second);
+
+    // stream the pattern in two sequences
+    ms_stream<TypeParam> engine(cst, 16);
+    std::vector<size_type> res;
+    auto out = [&](size_type l) { res.push_back(l); };
+    size_type half = pat.size()/2;
+    engine.push(pat.begin(), pat.begin()+half, out);
+    engine.finish(out);
+    ASSERT_EQ(half, engine.position());
+    ASSERT_EQ((size_type)0, engine.pending());
+    engine.push(pat.begin()+half, pat.end(), out);
+    engine.finish(out);
+    ASSERT_EQ(pat.size(), res.size());
+    auto ms1 = matching_statistics(cst, pat.begin(), pat.begin()+half);
+    auto ms2 = matching_statistics(cst, pat.begin()+half, pat.end());
+    for (size_type i=0; i < pat.size(); ++i) {
+        ASSERT_EQ(i < half ? ms1[i] : ms2[i-half], res[i]) << "i=" << i;
+    }
+}
+
+//! Test dfs_par and bottom_up_par
+TYPED_TEST(cst_byte_test, parallel_traversal)
+{
+    TypeParam cst;
+    ASSERT_TRUE(load_from_file(cst, temp_file));
+    // a node is identified by its SA interval
+    typedef std::pair<size_type, size_type> interval_type;
+    std::vector<interval_type> ids;
+    for (auto it = cst.begin(); it != cst.end(); ++it) {
+        if (it.visit() == 1) {
+            ids.emplace_back(cst.lb(*it), cst.rb(*it));
+        }
+    }
+    sort(ids.begin(), ids.end());
+    for (uint64_t threads : {1, 4}) {
+        std::vector<std::vector<interval_type>> par_ids(threads);
+        dfs_par(cst, [&](const typename TypeParam::node_type& v, uint64_t t) {
+            par_ids[t].emplace_back(cst.lb(v), cst.rb(v));
+        }, threads);
+        std::vector<interval_type> all;
+        for (auto& x : par_ids) {
+            all.insert(all.end(), x.begin(), x.end());
+        }
+        sort(all.begin(), all.end());
+        ASSERT_EQ(ids, all) << "threads=" << threads;
+
+        // count the leaves and the inner nodes with an aggregate (leaves, nodes)
+        typedef std::pair<size_type, size_type> agg_type;
+        std::vector<size_type> errors(threads, 0);
+        auto res = bottom_up_par<agg_type>(cst,
+        [](const typename TypeParam::node_type&, uint64_t) {
+            return agg_type(1, 1);
+        },
+        [](agg_type& acc, const agg_type& x) {
+            acc.first  += x.first;
+            acc.second += x.second;
+        },
+        [&](const typename TypeParam::node_type& v, agg_type& acc, uint64_t t) {
+            errors[t] += acc.first != cst.size(v);
+            acc.second += 1;
+        }, threads);
+        ASSERT_EQ(cst.size(), res.first) << "threads=" << threads;
+        ASSERT_EQ(ids.size(), res.second) << "threads=" << threads;
+        for (auto e : errors) {
+            ASSERT_EQ((size_type)0, e);
+        }
+
+        // a bool aggregate: does the subtree contain the longest suffix?
+        std::vector<size_type> found(threads, 0);
+        bool res_bool = bottom_up_par<bool>(cst,
+        [&](const typename TypeParam::node_type& v, uint64_t) {
+            return cst.sn(v) == 0;
+        },
+        [](bool& acc, const bool& x) {
+            acc = acc or x;
+        },
+        [&](const typename TypeParam::node_type&, bool& acc, uint64_t t) {
+            found[t] += acc;
+        }, threads);
+        ASSERT_TRUE(res_bool) << "threads=" << threads;
+        size_type ancestors = 0;
+        for (auto v = cst.select_leaf(cst.csa.isa[0]+1); v != cst.root(); v = cst.parent(v)) {
+            ++ancestors;
+        }
+        ASSERT_EQ(ancestors, std::accumulate(found.begin(), found.end(), (size_type)0)) << "threads=" << threads;
+    }
+}
+
 //! Test the bottom-up iterator
 TYPED_TEST(cst_byte_test, bottom_up_iterator)
 {
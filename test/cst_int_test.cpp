@@ -48,6 +48,7 @@ cst_sct3<tCSA1, lcp_bitcompressed<> >,
          cst_sada<tCSA1, lcp_support_tree<> >,
          cst_sct3<tCSA1, lcp_support_tree<>, bp_support_gg<> >,
          cst_sct3<tCSA1, lcp_support_tree<>, bp_support_g<> >,
+         cst_sada<tCSA1, lcp_dac<>, bp_support_rmm<> >,
          cst_sada<tCSA3, lcp_dac<> >,
          cst_sct3<tCSA1, lcp_support_sada<> >,
          cst_sct3<tCSA1, lcp_wt<> >
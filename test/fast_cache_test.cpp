@@ -0,0 +1,109 @@
+#include "sdsl/fast_cache.hpp"
+#include "gtest/gtest.h"
+#include <string>
+#include <random>
+
+namespace
+{
+
+using namespace sdsl;
+
+typedef int_vector<>::size_type size_type;
+
+std::string temp_dir;
+
+template<class T>
+class fast_cache_test : public ::testing::Test { };
+
+using testing::Types;
+
+typedef Types<assoc_cache<1>,
+        assoc_cache<2>,
+        assoc_cache<4>,
+        assoc_cache<16>,
+        sharded_cache<>,
+        sharded_cache<assoc_cache<1>>
+        > Implementations;
+
+TYPED_TEST_CASE(fast_cache_test, Implementations);
+
+//! Test that cached answers are correct and the counters
+TYPED_TEST(fast_cache_test, exists_and_write)
+{
+    TypeParam cache(1000);
+    ASSERT_LE((size_type)1000, cache.capacity());
+    std::mt19937_64 rng(7);
+    size_type hits = 0, misses = 0;
+    for (size_type k=0; k < 100000; ++k) {
+        size_type i = rng() % 5000, x = 0;
+        if (cache.exists(i, x)) {
+            ASSERT_EQ(3*i+1, x) << "i=" << i;
+            ++hits;
+        } else {
+            cache.write(i, 3*i+1);
+            ++misses;
+        }
+    }
+    ASSERT_EQ(hits, cache.hits());
+    ASSERT_EQ(misses, cache.misses());
+    ASSERT_LT((size_type)0, hits);
+    // overwrite an entry
+    cache.write(42, 7);
+    size_type x = 0;
+    ASSERT_TRUE(cache.exists(42, x));
+    ASSERT_EQ((size_type)7, x);
+    cache.clear();
+    ASSERT_FALSE(cache.exists(42, x));
+    ASSERT_EQ((size_type)0, cache.hits());
+    ASSERT_EQ((size_type)1, cache.misses());
+}
+
+//! Test that a hot entry survives a scan over its set
+TEST(assoc_cache_test, clock_replacement)
+{
+    assoc_cache<4> cache(4*16);
+    size_type x = 0;
+    cache.write(0, 100);
+    ASSERT_TRUE(cache.exists(0, x)); // sets the reference bit
+    for (size_type k=1; k <= 3; ++k) {
+        cache.write(k*16, k); // fill the set of request 0
+    }
+    for (size_type k=4; k < 100; ++k) {
+        cache.write(k*16, k);  // one-time requests of the same set
+        ASSERT_TRUE(cache.exists(0, x)) << "k=" << k;
+        ASSERT_EQ((size_type)100, x);
+    }
+}
+
+//! Test concurrent use of a sharded_cache
+TEST(sharded_cache_test, concurrent_fetch)
+{
+    sharded_cache<> cache(1 << 12, 16);
+    ASSERT_EQ((size_type)16, cache.shards());
+    const size_type n = 1 << 16;
+    std::vector<size_type> errors(4, 0);
+    parallel_for(4*n, 4, [&](uint64_t k, uint64_t t) {
+        size_type i = (k*2654435761ULL) % 10000;
+        errors[t] += cache.fetch(i, [](size_type j) { return j*j; }) != i*i;
+    }, 256);
+    for (auto e : errors) {
+        ASSERT_EQ((size_type)0, e);
+    }
+    ASSERT_EQ(4*n, cache.hits() + cache.misses());
+    ASSERT_LT((size_type)0, cache.hits());
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    if (argc < 2) {
+        // LCOV_EXCL_START
+        std::cout << "Usage: " << argv[0] << " tmp_dir" << std::endl;
+        return 1;
+        // LCOV_EXCL_STOP
+    }
+    temp_dir = argv[1];
+    return RUN_ALL_TESTS();
+}
@@ -688,6 +688,82 @@ TEST_F(int_vector_buffer_test, Reset)
     test_reset< sdsl::int_vector_buffer<64> >(vec_sizes);
 }
 
+template<class t_T>
+void test_async(size_type width=1)
+{
+    std::mt19937_64 rng;
+    std::string file_name = temp_dir+"/int_vector_buffer";
+    size_type buffersize = 1024;
+    for (size_type size : {(size_type)0, (size_type)1, (size_type)8192, (size_type)100000}) {
+        // write the same values synchronously and asynchronously
+        for (bool async : {false, true}) {
+            rng.seed(13);
+            t_T ivb(file_name+sdsl::util::to_string(async), std::ios::out, buffersize, width, false, async);
+            ASSERT_EQ(async, ivb.async());
+            for (size_type i=0; i < size; ++i) {
+                ivb.push_back(rng() & sdsl::bits::lo_set[ivb.width()]);
+            }
+        }
+        // read and modify asynchronously, both files have to be equal
+        {
+            t_T ivb0(file_name+"0", std::ios::in, buffersize, width, false, true);
+            t_T ivb1(file_name+"1", std::ios::in, buffersize, width, false, true);
+            ASSERT_EQ(size, ivb1.size());
+            rng.seed(13);
+            for (size_type i=0; i < size; ++i) {
+                value_type x = rng() & sdsl::bits::lo_set[ivb1.width()];
+                ASSERT_EQ(x, (size_type)ivb0[i]);
+                ASSERT_EQ(x, (size_type)ivb1[i]);
+                ivb1[i] = (x+1) & sdsl::bits::lo_set[ivb1.width()];
+            }
+            ivb1.push_back(1);
+        }
+        {
+            t_T ivb(file_name+"1", std::ios::in, buffersize, width, false, true);
+            ASSERT_EQ(size+1, ivb.size());
+            rng.seed(13);
+            std::vector<value_type> x(size);
+            for (size_type i=0; i < size; ++i) {
+                x[i] = (rng()+1) & sdsl::bits::lo_set[ivb.width()];
+                ASSERT_EQ(x[i], (size_type)ivb[i]);
+            }
+            ASSERT_EQ((size_type)1, (size_type)ivb[size]);
+            // read from right to left, i.e. the preceding blocks are read ahead
+            for (size_type i=size; i > 0; --i) {
+                ASSERT_EQ(x[i-1], (size_type)ivb[i-1]);
+            }
+            // move and swap while a block is read ahead
+            t_T moved(std::move(ivb));
+            t_T other(file_name+"0", std::ios::in, buffersize, width);
+            moved.swap(other);
+            ASSERT_EQ(size, moved.size());
+            ASSERT_EQ(size+1, other.size());
+            ASSERT_FALSE(moved.async());
+            ASSERT_TRUE(other.async());
+            moved.close(true);
+            other.close(true);
+        }
+    }
+}
+
+//! Test read ahead and write behind
+TEST_F(int_vector_buffer_test, async)
+{
+    for (size_type width=1; width <= 64; width += 7) {
+        test_async< sdsl::int_vector_buffer<> >(width);
+    }
+    test_async< sdsl::int_vector_buffer<1> >();
+    test_async< sdsl::int_vector_buffer<8> >();
+    test_async< sdsl::int_vector_buffer<64> >();
+    // the other tests with asynchronous buffers
+    sdsl::construct_config::async_io = true;
+    test_sequential_access< sdsl::int_vector_buffer<> >(13);
+    test_random_access< sdsl::int_vector_buffer<> >(13);
+    test_move< sdsl::int_vector_buffer<> >(64);
+    test_reset< sdsl::int_vector_buffer<> >(vec_sizes, 13);
+    sdsl::construct_config::async_io = false;
+}
+
 }  // namespace
 
 int main(int argc, char** argv)
@@ -309,6 +309,136 @@ TEST_F(IntVectorTest, SerializeFixedToVariable)
     sdsl::remove(file_name);
 }
 
+TEST_F(IntVectorTest, LoadMapped)
+{
+    sdsl::int_vector<> iv(100000, 0, 17);
+    sdsl::util::set_random_bits(iv, 17);
+    std::string file_name = temp_dir+"/int_vector_mapped";
+    ASSERT_TRUE(sdsl::store_to_file(iv, file_name));
+    {
+        sdsl::int_vector<> iv2;
+        ASSERT_TRUE(sdsl::load_from_file_mapped(iv2, file_name));
+        // the data of the last member of the file is used in place
+        ASSERT_LT(0U, sdsl::memory_manager::mapped_bytes(iv2.data()));
+        ASSERT_EQ(iv, iv2);
+        // modifications are private to the process
+        iv2[0] = iv[0]+1;
+        sdsl::int_vector<> iv3;
+        ASSERT_TRUE(sdsl::load_from_file_mapped(iv3, file_name));
+        ASSERT_LT(0U, sdsl::memory_manager::mapped_bytes(iv3.data()));
+        ASSERT_EQ(iv, iv3);
+        // growing copies the data out of the mapping
+        iv3.resize(2*iv.size());
+        ASSERT_EQ(0U, sdsl::memory_manager::mapped_bytes(iv3.data()));
+        iv3[iv.size()] = 1;
+        for (size_type i=0; i<iv.size(); ++i) {
+            ASSERT_EQ(iv[i], iv3[i]);
+        }
+    }
+    sdsl::int_vector<> iv4;
+    ASSERT_TRUE(sdsl::load_from_file(iv4, file_name));
+    ASSERT_EQ(iv, iv4);
+    sdsl::remove(file_name);
+}
+
+// A byte in front of an int_vector moves its data to an odd file offset
+struct odd_offset_vector {
+    typedef sdsl::int_vector<>::size_type size_type;
+    uint8_t c = 0;
+    sdsl::int_vector<> iv;
+
+    uint64_t serialize(std::ostream& out, sdsl::structure_tree_node* v=nullptr, std::string="")const
+    {
+        uint64_t written_bytes = sdsl::write_member(c, out, v, "c");
+        written_bytes += iv.serialize(out, v, "iv");
+        return written_bytes;
+    }
+
+    void load(std::istream& in)
+    {
+        sdsl::read_member(c, in);
+        iv.load(in);
+    }
+};
+
+TEST_F(IntVectorTest, LoadMappedUnaligned)
+{
+    odd_offset_vector x;
+    x.c = 7;
+    x.iv = sdsl::int_vector<>(100000, 0, 17);
+    sdsl::util::set_random_bits(x.iv, 17);
+    std::string file_name = temp_dir+"/int_vector_mapped_unaligned";
+    ASSERT_TRUE(sdsl::store_to_file(x, file_name));
+    {
+        odd_offset_vector y;
+        ASSERT_TRUE(sdsl::load_from_file_mapped(y, file_name));
+        ASSERT_EQ(x.c, y.c);
+        ASSERT_EQ(x.iv, y.iv);
+        // the header is padded, so the data is used in place
+        ASSERT_EQ(0U, (uintptr_t)y.iv.data() % alignof(uint64_t));
+        ASSERT_LT(0U, sdsl::memory_manager::mapped_bytes(y.iv.data()));
+    }
+    sdsl::remove(file_name);
+}
+
+TEST_F(IntVectorTest, LoadMappedUnpadded)
+{
+    sdsl::int_vector<> iv(100000, 0, 17);
+    sdsl::util::set_random_bits(iv, 17);
+    std::string file_name = temp_dir+"/int_vector_mapped_unpadded";
+    {
+        // a file without padding puts the data at an odd offset
+        std::ofstream out(file_name, std::ios::binary);
+        sdsl::write_member((uint64_t)iv.bit_size(), out);
+        sdsl::write_member(iv.width(), out);
+        out.write((const char*)iv.data(), ((iv.bit_size()+63)>>6)<<3);
+    }
+    {
+        sdsl::int_vector<> iv2;
+        ASSERT_TRUE(sdsl::load_from_file_mapped(iv2, file_name));
+        // the data is read instead of used in place
+        ASSERT_EQ(0U, sdsl::memory_manager::mapped_bytes(iv2.data()));
+        ASSERT_EQ(iv, iv2);
+    }
+    sdsl::remove(file_name);
+}
+
+TEST_F(IntVectorTest, AllocPolicy)
+{
+    typedef sdsl::alloc_policy ap;
+    for (auto pages : {ap::default_pages, ap::transparent_hugepages, ap::hugepages_1g}) {
+        for (auto numa : {ap::first_touch, ap::interleave, ap::preferred}) {
+            ap policy;
+            policy.pages     = pages;
+            policy.numa      = numa;
+            policy.min_bytes = 1024;
+            sdsl::memory_manager::use_policy(policy);
+            // starts on the heap and is moved into a mapping while growing
+            sdsl::int_vector<> iv(100, 0, 17);
+            sdsl::util::set_random_bits(iv, 17);
+            sdsl::int_vector<> iv_copy = iv;
+            for (size_type size : {1000, 300000, 1000000, 200}) {
+                iv.resize(size);
+                for (size_type i=0; i<std::min(size, iv_copy.size()); ++i) {
+                    ASSERT_EQ(iv_copy[i], iv[i]);
+                }
+                if (pages != ap::default_pages and iv.capacity() >= 8*policy.min_bytes) {
+                    // mappings of huge pages stay 2MB aligned when resized
+                    ASSERT_EQ(0U, (uintptr_t)iv.data() % (2ULL << 20)) << "size=" << size;
+                }
+                sdsl::util::set_random_bits(iv, 17);
+                iv_copy = iv;
+            }
+            sdsl::memory_manager::reset_policy();
+            // vectors allocated under the policy stay valid
+            iv.resize(2000000);
+            for (size_type i=0; i<iv_copy.size(); ++i) {
+                ASSERT_EQ(iv_copy[i], iv[i]);
+            }
+        }
+    }
+}
+
 TEST_F(IntVectorTest, IteratorTest)
 {
     for (auto i : vec_sizes) {
@@ -66,6 +66,27 @@ class lcp_construct_test : public ::testing::Test
             sdsl::remove(cache_file_name(CHECK_KEY, test_config));
         }
 
+        // Compares the constructed LCP array with the reference and removes it
+        void check_lcp(const string& info)
+        {
+            int_vector<> lcp_check, lcp;
+            string lcp_check_file = cache_file_name(CHECK_KEY, this->test_config);
+            string lcp_file = cache_file_name(conf::KEY_LCP, this->test_config);
+            ASSERT_TRUE(load_from_file(lcp_check, lcp_check_file))
+                    << info << " could not load reference lcp array";
+            ASSERT_TRUE(load_from_file(lcp, lcp_file))
+                    << info << " could not load created lcp array";
+            ASSERT_EQ(lcp_check.size(), lcp.size())
+                    << info << " lcp array size differ";
+            for (uint64_t j=0; j<lcp.size(); ++j) {
+                ASSERT_EQ(lcp_check[j], lcp[j])
+                        << info << " value differ:" << " lcp_check[" << j << "]="
+                        << lcp_check[j] << "!=" << lcp[j] << "=lcp["<< j << "]";
+            }
+            // Clean up LCP array
+            sdsl::remove(lcp_file);
+        }
+
         cache_config test_config;
         tMSFP lcp_function;
         string CHECK_KEY;
@@ -78,22 +99,18 @@ TEST_F(lcp_construct_test, construct_lcp)
         // Construct LCP array
         (it->second)(this->test_config);
         // Check LCP array
-        int_vector<> lcp_check, lcp;
-        string lcp_check_file = cache_file_name(CHECK_KEY, this->test_config);
-        string lcp_file = cache_file_name(conf::KEY_LCP, this->test_config);
-        ASSERT_TRUE(load_from_file(lcp_check, lcp_check_file))
-                << info << " could not load reference lcp array";
-        ASSERT_TRUE(load_from_file(lcp, lcp_file))
-                << info << " could not load created lcp array";
-        ASSERT_EQ(lcp_check.size(), lcp.size())
-                << info << " lcp array size differ";
-        for (uint64_t j=0; j<lcp.size(); ++j) {
-            ASSERT_EQ(lcp_check[j], lcp[j])
-                    << info << " value differ:" << " lcp_check[" << j << "]="
-                    << lcp_check[j] << "!=" << lcp[j] << "=lcp["<< j << "]";
-        }
-        // Clean up LCP array
-        sdsl::remove(cache_file_name(conf::KEY_LCP, this->test_config));
+        check_lcp(info);
+    }
+}
+
+TEST_F(lcp_construct_test, construct_lcp_par_PHI)
+{
+    for (uint64_t threads : {(uint64_t)2, (uint64_t)4}) {
+        string info = "construct_lcp_par_PHI with " + to_string(threads) + " threads on test file " + test_file;
+        this->test_config.threads = threads;
+        construct_lcp_par_PHI<8>(this->test_config);
+        this->test_config.threads = 1;
+        check_lcp(info);
     }
 }
 
@@ -0,0 +1,173 @@
+#include "sdsl/pef_vector.hpp"
+#include "sdsl/sd_vector.hpp"
+#include "sdsl/rank_support.hpp"
+#include "sdsl/select_support.hpp"
+#include "gtest/gtest.h"
+#include <random>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+const size_t BV_SIZE = 1000000;
+
+// Alternating regions of ones, dense, sparse and no ones
+bit_vector clustered_bit_vector(size_t n, uint64_t seed)
+{
+    bit_vector bv(n);
+    std::mt19937_64 rng(seed);
+    for (size_t i=0; i < n;) {
+        size_t len = rng() % 20000 + 1;
+        uint64_t type = rng() % 4;
+        for (size_t k=0; k < len and i < n; ++k, ++i) {
+            if (type == 0) {
+                bv[i] = 1;
+            } else if (type == 1) {
+                bv[i] = (0 == rng() % 3);
+            } else if (type == 2) {
+                bv[i] = (0 == rng() % 1000);
+            }
+        }
+    }
+    return bv;
+}
+
+TEST(pef_vector_test, iterator_constructor)
+{
+    std::vector<uint64_t> pos;
+    bit_vector bv = clustered_bit_vector(BV_SIZE, 1);
+    for (size_t i=0; i < bv.size(); ++i) {
+        if (bv[i]) {
+            pos.emplace_back(i);
+        }
+    }
+    pef_vector pv(pos.begin(),pos.end());
+    ASSERT_EQ(pos.back()+1, pv.size());
+    for (size_t i=0; i < pv.size(); ++i) {
+        ASSERT_EQ((bool)pv[i],(bool)bv[i]);
+    }
+}
+
+TEST(pef_vector_test, pointer_constructor)
+{
+    uint64_t pos[] = {1, 5, 9};
+    pef_vector pv(pos, pos+3);
+    ASSERT_EQ(10U, pv.size());
+    for (size_t i=0; i < pv.size(); ++i) {
+        ASSERT_EQ(i == 1 or i == 5 or i == 9, (bool)pv[i]);
+    }
+}
+
+TEST(pef_vector_test, builder_constructor)
+{
+    std::vector<uint64_t> pos;
+    bit_vector bv = clustered_bit_vector(BV_SIZE, 2);
+    for (size_t i=0; i < bv.size(); ++i) {
+        if (bv[i]) {
+            pos.emplace_back(i);
+        }
+    }
+    pef_vector_builder builder(BV_SIZE, pos.size());
+    for (auto i : pos) {
+        builder.set(i);
+    }
+    pef_vector pv(builder);
+    ASSERT_EQ(0U, builder.size());
+    for (size_t i=0; i < bv.size(); ++i) {
+        ASSERT_EQ((bool)pv[i],(bool)bv[i]);
+    }
+}
+
+TEST(pef_vector_test, builder_empty_constructor)
+{
+    pef_vector_builder builder(BV_SIZE, 0UL);
+    pef_vector pv(builder);
+    for (size_t i=0; i < BV_SIZE; ++i) {
+        ASSERT_EQ(0U, pv[i]);
+    }
+}
+
+TEST(pef_vector_test, builder_not_full)
+{
+    pef_vector_builder builder(BV_SIZE, 2);
+    builder.set(5);
+    ASSERT_THROW(pef_vector pv(builder), std::runtime_error);
+}
+
+TEST(pef_vector_test, successor_and_predecessor)
+{
+    for (uint64_t seed : {3, 4}) {
+        bit_vector bv = clustered_bit_vector(BV_SIZE, seed);
+        pef_vector pv(bv);
+        size_t succ = bv.size();
+        for (size_t i=bv.size()+1; i > 0; --i) {
+            if (i-1 < bv.size() and bv[i-1]) {
+                succ = i-1;
+            }
+            ASSERT_EQ(succ, pv.successor(i-1)) << "i=" << i-1;
+        }
+        size_t pred = bv.size();
+        for (size_t i=0; i <= bv.size(); ++i) {
+            if (i < bv.size() and bv[i]) {
+                pred = i;
+            }
+            ASSERT_EQ(pred, pv.predecessor(i)) << "i=" << i;
+        }
+    }
+    pef_vector_builder builder(BV_SIZE, 0UL);
+    pef_vector pv(builder);
+    ASSERT_EQ(BV_SIZE, pv.successor(0));
+    ASSERT_EQ(BV_SIZE, pv.predecessor(BV_SIZE-1));
+}
+
+// Clustered data is encoded in all chunk types, e.g. sparse regions as Elias-Fano
+TEST(pef_vector_test, rank_and_select)
+{
+    for (uint64_t seed : {6, 7}) {
+        bit_vector bv = clustered_bit_vector(BV_SIZE, seed);
+        rank_support_v<> rank(&bv);
+        select_support_mcl<1> select1(&bv);
+        select_support_mcl<0> select0(&bv);
+        pef_vector pv(bv);
+        pef_vector::rank_1_type pv_rank;
+        pef_vector::select_1_type pv_select1;
+        pef_vector::select_0_type pv_select0;
+        util::init_support(pv_rank, &pv);
+        util::init_support(pv_select1, &pv);
+        util::init_support(pv_select0, &pv);
+        for (size_t i=0; i <= bv.size(); ++i) {
+            ASSERT_EQ(rank(i), pv_rank(i)) << "i=" << i;
+        }
+        size_t ones = rank(bv.size());
+        for (size_t j=1; j <= ones; ++j) {
+            ASSERT_EQ(select1(j), pv_select1(j)) << "j=" << j;
+        }
+        for (size_t j=1; j <= bv.size()-ones; ++j) {
+            ASSERT_EQ(select0(j), pv_select0(j)) << "j=" << j;
+        }
+        std::mt19937_64 rng(seed);
+        for (size_t k=0; k < 100000; ++k) {
+            uint8_t len = rng() % 64 + 1;
+            size_t i = rng() % (bv.size()-len+1);
+            ASSERT_EQ(bv.get_int(i, len), pv.get_int(i, len)) << "i=" << i << " len=" << (size_t)len;
+        }
+    }
+}
+
+TEST(pef_vector_test, smaller_than_sd_vector_on_clustered_data)
+{
+    bit_vector bv = clustered_bit_vector(BV_SIZE, 5);
+    pef_vector pv(bv);
+    sd_vector<> sdv(bv);
+    ASSERT_LT(size_in_bytes(pv), size_in_bytes(sdv));
+}
+
+} // end namespace
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+#include "sdsl/posting_list_algorithm.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <vector>
+
+using namespace sdsl;
+using namespace std;
+
+namespace
+{
+
+typedef vector<uint64_t> list_type;
+
+// Random strictly increasing list; every den-th element of [0..n) on average
+list_type random_list(uint64_t n, uint64_t den, std::mt19937_64& rng)
+{
+    list_type l;
+    for (uint64_t i=0; i < n; ++i) {
+        if (0 == rng() % den) {
+            l.push_back(i);
+        }
+    }
+    return l;
+}
+
+template<class t_list>
+t_list make_list(const list_type& l);
+
+template<>
+sd_vector<> make_list<sd_vector<>>(const list_type& l)
+{
+    return sd_vector<>(l.begin(), l.end());
+}
+
+template<>
+enc_vector<> make_list<enc_vector<>>(const list_type& l)
+{
+    return enc_vector<>(l);
+}
+
+template<>
+enc_vector<coder::elias_gamma, 8> make_list<enc_vector<coder::elias_gamma, 8>>(const list_type& l)
+{
+    return enc_vector<coder::elias_gamma, 8>(l);
+}
+
+template<class T>
+class posting_list_algorithm_test : public ::testing::Test { };
+
+using testing::Types;
+
+typedef Types<sd_vector<>,
+        enc_vector<>,
+        enc_vector<coder::elias_gamma, 8>
+        > Implementations;
+
+TYPED_TEST_CASE(posting_list_algorithm_test, Implementations);
+
+TYPED_TEST(posting_list_algorithm_test, intersect_and_unite)
+{
+    std::mt19937_64 rng(13);
+    for (size_t k : {1, 2, 3, 5, 20}) {
+        for (size_t r=0; r < 4; ++r) {
+            vector<list_type> l;
+            for (size_t j=0; j < k; ++j) {
+                uint64_t den = (j+r)%4 == 0 ? 1000 : ((j+r)%4 == 1 ? 2 : 1+rng()%20);
+                l.push_back(random_list(200000, den, rng));
+            }
+            list_type inter = l[0], uni = l[0];
+            for (size_t j=1; j < k; ++j) {
+                list_type tmp;
+                set_intersection(inter.begin(), inter.end(), l[j].begin(), l[j].end(), back_inserter(tmp));
+                inter.swap(tmp);
+                tmp.clear();
+                set_union(uni.begin(), uni.end(), l[j].begin(), l[j].end(), back_inserter(tmp));
+                uni.swap(tmp);
+            }
+            vector<TypeParam> v;
+            for (auto& x : l) {
+                v.push_back(make_list<TypeParam>(x));
+            }
+            vector<const TypeParam*> p;
+            for (auto& x : v) {
+                p.push_back(&x);
+            }
+            int_vector<> res = intersect_lists(p);
+            ASSERT_EQ(inter.size(), res.size()) << "k=" << k << " r=" << r;
+            ASSERT_TRUE(equal(inter.begin(), inter.end(), res.begin()));
+            res = unite_lists(p);
+            ASSERT_EQ(uni.size(), res.size()) << "k=" << k << " r=" << r;
+            ASSERT_TRUE(equal(uni.begin(), uni.end(), res.begin()));
+        }
+    }
+}
+
+TYPED_TEST(posting_list_algorithm_test, empty_lists)
+{
+    TypeParam a = make_list<TypeParam>(list_type());
+    TypeParam b = make_list<TypeParam>(list_type {1, 5, 7});
+    vector<const TypeParam*> p {&a, &b};
+    ASSERT_EQ(0U, intersect_lists(p).size());
+    int_vector<> res = unite_lists(p);
+    ASSERT_EQ(3U, res.size());
+    ASSERT_EQ(7U, res[2]);
+    p.clear();
+    ASSERT_EQ(0U, intersect_lists(p).size());
+    ASSERT_EQ(0U, unite_lists(p).size());
+}
+
+TEST(list_cursor_test, next_geq)
+{
+    std::mt19937_64 rng(17);
+    list_type l = random_list(1000000, 50, rng);
+    enc_vector<> ev(l);
+    sd_vector<> sdv(l.begin(), l.end());
+    list_cursor<enc_vector<>> ce(ev);
+    list_cursor<sd_vector<>> cs(sdv);
+    uint64_t x = 0;
+    while (true) {
+        x += rng() % 5000;
+        auto it = lower_bound(l.begin(), l.end(), x);
+        ce.next_geq(x);
+        cs.next_geq(x);
+        if (it == l.end()) {
+            ASSERT_TRUE(ce.end());
+            ASSERT_TRUE(cs.end());
+            break;
+        }
+        ASSERT_EQ(*it, ce.value()) << "x=" << x;
+        ASSERT_EQ(*it, cs.value()) << "x=" << x;
+    }
+}
+
+} // end namespace
+
+int main(int argc, char* argv[])
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -2,6 +2,8 @@
 #include "sdsl/rank_support.hpp"
 #include "gtest/gtest.h"
 #include <string>
+#include <random>
+#include <vector>
 
 using namespace sdsl;
 using namespace std;
@@ -19,6 +21,7 @@ using testing::Types;
 typedef Types<rank_support_il<1, 256>,
         rank_support_il<1, 512>,
         rank_support_il<1, 1024>,
+        rank_support_cl<1>,
         rank_support_rrr<>,
         rank_support_v<>,
         rank_support_v5<>,
@@ -34,9 +37,11 @@ typedef Types<rank_support_il<1, 256>,
         rank_support_rrr<1, 128>,
         rank_support_rrr<1, 129>,
         rank_support_sd<1>,
+        rank_support_pef<1>,
         rank_support_il<0, 256>,
         rank_support_il<0, 512>,
         rank_support_il<0, 1024>,
+        rank_support_cl<0>,
         rank_support_rrr<0>,
         rank_support_v<0>,
         rank_support_v5<0>,
@@ -52,6 +57,7 @@ typedef Types<rank_support_il<1, 256>,
         rank_support_rrr<0, 128>,
         rank_support_rrr<0, 129>,
         rank_support_sd<0>,
+        rank_support_pef<0>,
         rank_support_hyb<1>,
         rank_support_hyb<0>,
         rank_support_v<10,2>,
@@ -61,7 +67,9 @@ typedef Types<rank_support_il<1, 256>,
         rank_support_v5<10,2>,
         rank_support_v5<01,2>,
         rank_support_v5<00,2>,
-        rank_support_v5<11,2>
+        rank_support_v5<11,2>,
+        rank_support_scan<>,
+        rank_support_scan<0>
         > Implementations;
 
 TYPED_TEST_CASE(rank_support_test, Implementations);
@@ -86,6 +94,38 @@ TYPED_TEST(rank_support_test, rank_method)
     EXPECT_EQ(rank, rs.rank(bvec.size()));
 }
 
+template<class T>
+class rank_support_batch_test : public ::testing::Test { };
+
+typedef Types<rank_support_v<>,
+        rank_support_v5<>,
+        rank_support_v<0>,
+        rank_support_v5<0>,
+        rank_support_v<10,2>,
+        rank_support_v5<01,2>
+        > BatchImplementations;
+
+TYPED_TEST_CASE(rank_support_batch_test, BatchImplementations);
+
+//! Test the rank_batch method
+TYPED_TEST(rank_support_batch_test, rank_batch_method)
+{
+    bit_vector bvec;
+    ASSERT_TRUE(load_from_file(bvec, test_file));
+    TypeParam rs(&bvec);
+    std::mt19937_64 rng(17);
+    for (uint64_t n : {0, 1, 15, 16, 17, 1000}) {
+        std::vector<uint64_t> idx(n), out(n);
+        for (uint64_t i=0; i < n; ++i) {
+            idx[i] = rng() % (bvec.size()+1);
+        }
+        rs.rank_batch(idx.data(), n, out.data());
+        for (uint64_t i=0; i < n; ++i) {
+            ASSERT_EQ(rs.rank(idx[i]), out[i]) << "idx=" << idx[i];
+        }
+    }
+}
+
 }// end namespace
 
 int main(int argc, char** argv)
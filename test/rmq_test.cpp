@@ -1,8 +1,11 @@
 #include "sdsl/rmq_support.hpp"
+#include "sdsl/bp_support_rmm.hpp"
 #include "gtest/gtest.h"
 #include <vector>
 #include <string>
 #include <stack>
+#include <random>
+#include <fstream>
 
 using namespace std;
 using namespace sdsl;
@@ -22,7 +25,8 @@ class rmq_test : public ::testing::Test { };
 using testing::Types;
 
 typedef Types<sdsl::rmq_succinct_sct<>,
-        sdsl::rmq_succinct_sada<>
+        sdsl::rmq_succinct_sada<>,
+        sdsl::rmq_succinct_sct<true, sdsl::bp_support_rmm<>>
         > Implementations;
 
 TYPED_TEST_CASE(rmq_test, Implementations);
@@ -128,6 +132,63 @@ TYPED_TEST(rmq_test, rmq_load_and_move_and_query)
 }
 
 
+//! Test batched range minimum queries
+TYPED_TEST(rmq_test, rmq_batch)
+{
+    int_vector<> v;
+    ASSERT_TRUE(load_from_file(v, test_file));
+    TypeParam rmq;
+    ASSERT_TRUE(load_from_file(rmq, temp_file));
+    if (rmq.size() > 0) {
+        std::mt19937_64 rng(13);
+        vector<pair<uint64_t, uint64_t>> q(10000);
+        for (size_t i=0; i < q.size(); ++i) {
+            uint64_t l = rng() % rmq.size();
+            uint64_t len = (i%2) ? rng() % 128 : rng();
+            q[i] = {l, l + len % (rmq.size()-l)};
+        }
+        auto res = rmq.rmq_batch(q);
+        ASSERT_EQ(q.size(), res.size());
+        for (size_t i=0; i < q.size(); ++i) {
+            ASSERT_EQ(rmq(q[i].first, q[i].second), res[i]) << "[" << q[i].first << "," << q[i].second << "]";
+        }
+    }
+}
+
+//! Test the sparse tables against rmq_succinct_sct
+template<class t_rmq, class t_ref>
+void test_sparse_table(const int_vector<>& v)
+{
+    string file = temp_file + ".sparse";
+    t_rmq rmq(&v);
+    ASSERT_EQ(v.size(), rmq.size());
+    ASSERT_TRUE(sdsl::store_to_file(rmq, file));
+    t_rmq rmq_load;
+    {
+        std::ifstream in(file);
+        rmq_load.load(in, &v);
+    }
+    t_ref ref(&v);
+    std::mt19937_64 rng(13);
+    for (size_t i=0; i < 10000 and v.size() > 0; ++i) {
+        uint64_t l = rng() % v.size();
+        uint64_t len = (i%2) ? rng() % 200 : rng();
+        uint64_t r = l + len % (v.size()-l);
+        ASSERT_EQ(ref(l, r), rmq_load(l, r)) << "[" << l << "," << r << "]";
+    }
+    sdsl::remove(file);
+}
+
+TEST(rmq_sparse_table_test, compare_with_sct)
+{
+    int_vector<> v;
+    ASSERT_TRUE(load_from_file(v, test_file));
+    test_sparse_table<rmq_support_sparse_table<>, rmq_succinct_sct<>>(v);
+    test_sparse_table<rmq_support_sparse_table_blocked<>, rmq_succinct_sct<>>(v);
+    test_sparse_table<range_maximum_support_sparse_table<>, range_maximum_sct<>::type>(v);
+    test_sparse_table<range_maximum_support_sparse_table_blocked<>, range_maximum_sct<>::type>(v);
+}
+
 
 TYPED_TEST(rmq_test, delete_)
 {
@@ -1,6 +1,7 @@
 #include <sdsl/suffix_arrays.hpp>
 #include <sdsl/construct_sa.hpp>
 #include <sdsl/construct_sa_se.hpp>
+#include <sdsl/construct_bwt_se.hpp>
 #include "gtest/gtest.h"
 #include <vector>
 #include <string>
@@ -42,6 +43,86 @@ TEST_F(sa_construct_test, divsufsort)
     cout << "# constructs_space = " << (1.0*memory_monitor::peak())/n << " byte per byte, =>" << memory_monitor::peak() << " bytes in total" << endl;
 }
 
+TEST_F(sa_construct_test, parallel)
+{
+    // Construct SA with the parallel prefix doubling algorithm
+    memory_monitor::start();
+    construct_config::byte_algo_sa = PAR_DOUBLING;
+    config.threads = 4;
+    construct_sa<8>(config);
+    config.threads = 1;
+    memory_monitor::stop();
+    cout << "# constructs_space = " << (1.0*memory_monitor::peak())/n << " byte per byte, =>" << memory_monitor::peak() << " bytes in total" << endl;
+    {
+        int_vector_buffer<> sa_check(cache_file_name("check_sa", config));
+        int_vector_buffer<> sa(cache_file_name(conf::KEY_SA, config));
+        ASSERT_EQ(sa_check.size(), sa.size()) << " suffix array size differ";
+        ASSERT_EQ(sa_check.width(), sa.width()) << " suffix array width differ";
+        for (uint64_t i=0; i<sa_check.size(); ++i) {
+            ASSERT_EQ(sa_check[i], sa[i]) << " sa differs at position " << i;
+        }
+    }
+    sdsl::remove(cache_file_name(conf::KEY_SA, config));
+    config.file_map.erase(conf::KEY_SA);
+}
+
+TEST_F(sa_construct_test, parallel_in_place)
+{
+    // Sort all groups in place, as if their keys exceeded the memory budget
+    construct_config::byte_algo_sa = PAR_DOUBLING;
+    auto memory_budget = construct_config::memory_budget;
+    construct_config::memory_budget = 0;
+    config.threads = 4;
+    construct_sa<8>(config);
+    config.threads = 1;
+    construct_config::memory_budget = memory_budget;
+    {
+        int_vector_buffer<> sa_check(cache_file_name("check_sa", config));
+        int_vector_buffer<> sa(cache_file_name(conf::KEY_SA, config));
+        ASSERT_EQ(sa_check.size(), sa.size()) << " suffix array size differ";
+        for (uint64_t i=0; i<sa_check.size(); ++i) {
+            ASSERT_EQ(sa_check[i], sa[i]) << " sa differs at position " << i;
+        }
+    }
+    sdsl::remove(cache_file_name(conf::KEY_SA, config));
+    config.file_map.erase(conf::KEY_SA);
+}
+
+TEST_F(sa_construct_test, parallel_int)
+{
+    // Integer texts with the order of the byte text: symbol c is mapped to
+    // c*2^s+c. For s=8 several symbols are packed into the initial sort key,
+    // for s=40 only one.
+    int_vector<8> text;
+    load_from_cache(text, conf::KEY_TEXT, config);
+    construct_config::int_algo_sa = PAR_DOUBLING_INT;
+    for (uint64_t s : {8, 40}) {
+        {
+            int_vector<> int_text(text.size(), 0, s+8);
+            for (uint64_t i=0; i<text.size(); ++i) {
+                int_text[i] = ((uint64_t)text[i] << s) | text[i];
+            }
+            store_to_cache(int_text, conf::KEY_TEXT_INT, config);
+        }
+        config.threads = 4;
+        construct_sa<0>(config);
+        config.threads = 1;
+        {
+            int_vector_buffer<> sa_check(cache_file_name("check_sa", config));
+            int_vector_buffer<> sa(cache_file_name(conf::KEY_SA, config));
+            ASSERT_EQ(sa_check.size(), sa.size()) << " suffix array size differ; s=" << s;
+            for (uint64_t i=0; i<sa_check.size(); ++i) {
+                ASSERT_EQ(sa_check[i], sa[i]) << " sa differs at position " << i << "; s=" << s;
+            }
+        }
+        sdsl::remove(cache_file_name(conf::KEY_SA, config));
+        sdsl::remove(cache_file_name(conf::KEY_TEXT_INT, config));
+    }
+    construct_config::int_algo_sa = QSUFSORT;
+    config.file_map.erase(conf::KEY_SA);
+    config.file_map.erase(conf::KEY_TEXT_INT);
+}
+
 TEST_F(sa_construct_test, sesais)
 {
     // Construct SA with seSAIS
@@ -52,6 +133,55 @@ TEST_F(sa_construct_test, sesais)
     cout << "# constructs_space = " << (1.0*memory_monitor::peak())/n << " byte per byte, =>" << memory_monitor::peak() << " bytes in total" << endl;
 }
 
+TEST_F(sa_construct_test, bwt_se)
+{
+    // Reference BWT from the SA of seSAIS, which is put aside
+    construct_bwt<8>(config);
+    sdsl::rename(cache_file_name(conf::KEY_BWT, config), cache_file_name("check_bwt", config));
+    sdsl::rename(cache_file_name(conf::KEY_SA, config), cache_file_name("sesais_sa", config));
+    config.file_map.erase(conf::KEY_BWT);
+    config.file_map.erase(conf::KEY_SA);
+    register_cache_file("check_bwt", config);
+    register_cache_file("sesais_sa", config);
+    // Construct BWT and SA blockwise
+    // block size 0 derives blocks of about n/3 symbols from the memory budget
+    std::vector<uint64_t> block_sizes = {n/64+1, n/5+1, n, 0};
+    if (n < 1000) { // tiny blocks result in many passes
+        block_sizes.push_back(1);
+        block_sizes.push_back(3);
+    }
+    auto memory_budget = construct_config::memory_budget;
+    construct_config::memory_budget = (n/3+1)*_bwt_se_bytes_per_symbol(8, 0);
+    for (uint64_t block_size : block_sizes) {
+        for (uint64_t threads : {(uint64_t)1, (uint64_t)4}) {
+            config.threads = threads;
+            memory_monitor::start();
+            construct_bwt_se<8>(config, block_size);
+            memory_monitor::stop();
+            config.threads = 1;
+            int_vector_buffer<8> bwt_check(cache_file_name("check_bwt", config));
+            int_vector_buffer<8> bwt(cache_file_name(conf::KEY_BWT, config));
+            int_vector_buffer<> sa_check(cache_file_name("check_sa", config));
+            int_vector_buffer<> sa(cache_file_name(conf::KEY_SA, config));
+            ASSERT_EQ(bwt_check.size(), bwt.size()) << " bwt size differ; block_size=" << block_size;
+            ASSERT_EQ(sa_check.size(), sa.size()) << " suffix array size differ; block_size=" << block_size;
+            if (n > 1) { // divsufsort uses 64-bit for texts of length <= 1
+                ASSERT_EQ(sa_check.width(), sa.width()) << " suffix array width differ";
+            }
+            for (uint64_t i=0; i<bwt_check.size(); ++i) {
+                ASSERT_EQ(bwt_check[i], bwt[i]) << " bwt differs at position " << i << "; block_size=" << block_size << " threads=" << threads;
+                ASSERT_EQ(sa_check[i], sa[i]) << " sa differs at position " << i << "; block_size=" << block_size << " threads=" << threads;
+            }
+        }
+    }
+    construct_config::memory_budget = memory_budget;
+    sdsl::remove(cache_file_name(conf::KEY_BWT, config));
+    config.file_map.erase(conf::KEY_BWT);
+    sdsl::rename(cache_file_name("sesais_sa", config), cache_file_name(conf::KEY_SA, config));
+    config.file_map.erase("sesais_sa");
+    register_cache_file(conf::KEY_SA, config);
+}
+
 TEST_F(sa_construct_test, compare)
 {
     // Load both SAs
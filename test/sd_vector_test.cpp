@@ -62,6 +62,62 @@ TEST(sd_vector_test, builder_empty_constructor)
     }
 }
 
+TEST(sd_vector_test, successor_and_predecessor)
+{
+    std::mt19937_64 rng;
+    for (uint64_t den : {2, 10, 1000}) {
+        bit_vector bv(BV_SIZE);
+        for (size_t i=0; i < bv.size(); ++i) {
+            bv[i] = (0 == rng() % den);
+        }
+        for (size_t i=BV_SIZE/3; i < BV_SIZE/3+5000; ++i) { // a dense run
+            bv[i] = 1;
+        }
+        sd_vector<> sdv(bv);
+        size_t succ = bv.size();
+        for (size_t i=bv.size()+1; i > 0; --i) {
+            if (i-1 < bv.size() and bv[i-1]) {
+                succ = i-1;
+            }
+            ASSERT_EQ(succ, sdv.successor(i-1)) << "i=" << i-1;
+        }
+        size_t pred = bv.size();
+        for (size_t i=0; i <= bv.size(); ++i) {
+            if (i < bv.size() and bv[i]) {
+                pred = i;
+            }
+            ASSERT_EQ(pred, sdv.predecessor(i)) << "i=" << i;
+        }
+    }
+    sd_vector_builder builder(BV_SIZE, 0UL);
+    sd_vector<> sdv(builder);
+    ASSERT_EQ(BV_SIZE, sdv.successor(0));
+    ASSERT_EQ(BV_SIZE, sdv.predecessor(BV_SIZE-1));
+}
+
+TEST(sd_vector_test, decode)
+{
+    std::vector<uint64_t> pos;
+    std::mt19937_64 rng;
+    for (size_t i=0; i < BV_SIZE; ++i) {
+        if (0 == rng() % 10) {
+            pos.emplace_back(i);
+        }
+    }
+    sd_vector<> sdv(pos.begin(), pos.end());
+    std::vector<uint64_t> out(pos.size());
+    sdv.decode(0, pos.size(), out.data());
+    ASSERT_EQ(pos, out);
+    for (size_t k=0; k < 1000; ++k) {
+        size_t i = rng() % pos.size();
+        size_t n = rng() % std::min((size_t)1000, pos.size()-i+1);
+        sdv.decode(i, n, out.data());
+        for (size_t j=0; j < n; ++j) {
+            ASSERT_EQ(pos[i+j], out[j]);
+        }
+    }
+}
+
 } // end namespace
 
 int main(int argc, char* argv[])
@@ -2,6 +2,8 @@
 #include "sdsl/select_support.hpp"
 #include "gtest/gtest.h"
 #include <string>
+#include <random>
+#include <vector>
 
 using namespace sdsl;
 using namespace std;
@@ -29,9 +31,12 @@ typedef Types<select_support_mcl<>,
         select_support_sd<1>,
         select_support_sd<0>,
         select_0_support_sd<>,
+        select_support_pef<1>,
+        select_support_pef<0>,
         select_support_il<1, 256>,
         select_support_il<1, 512>,
         select_support_il<1, 1024>,
+        select_support_cl<1>,
         select_support_mcl<0>,
         select_support_rrr<0, 256>,
         select_support_rrr<0>,
@@ -42,10 +47,13 @@ typedef Types<select_support_mcl<>,
         select_support_il<0, 256>,
         select_support_il<0, 512>,
         select_support_il<0, 1024>,
+        select_support_cl<0>,
         select_support_mcl<01,2>,
         select_support_mcl<10,2>,
         select_support_mcl<00,2>,
-        select_support_mcl<11,2>
+        select_support_mcl<11,2>,
+        select_support_scan<>,
+        select_support_scan<0>
         > Implementations;
 
 TYPED_TEST_CASE(select_support_test, Implementations);
@@ -74,6 +82,40 @@ TYPED_TEST(select_support_test, select_method)
     }
 }
 
+template<class T>
+class select_support_batch_test : public ::testing::Test { };
+
+typedef Types<select_support_mcl<>,
+        select_support_mcl<0>,
+        select_support_mcl<10,2>
+        > BatchImplementations;
+
+TYPED_TEST_CASE(select_support_batch_test, BatchImplementations);
+
+//! Test the select_batch method
+TYPED_TEST(select_support_batch_test, select_batch_method)
+{
+    bit_vector bvec;
+    ASSERT_TRUE(load_from_file(bvec, test_file));
+    TypeParam ss(&bvec);
+    rank_support_v<TypeParam::bit_pat, TypeParam::bit_pat_len> rs(&bvec);
+    uint64_t args = rs.rank(bvec.size());
+    if (args == 0) {
+        return;
+    }
+    std::mt19937_64 rng(17);
+    for (uint64_t n : {0, 1, 7, 12, 13, 1000}) {
+        std::vector<uint64_t> idx(n), out(n);
+        for (uint64_t i=0; i < n; ++i) {
+            idx[i] = 1 + rng() % args;
+        }
+        ss.select_batch(idx.data(), n, out.data());
+        for (uint64_t i=0; i < n; ++i) {
+            ASSERT_EQ(ss.select(idx[i]), out[i]) << "i=" << idx[i];
+        }
+    }
+}
+
 }// end namespace
 
 int main(int argc, char** argv)
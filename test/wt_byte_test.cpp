@@ -4,6 +4,7 @@
 #include <string>
 #include <algorithm> // for std::min
 #include <random>
+#include <sstream>
 
 namespace
 {
@@ -29,6 +30,7 @@ wt_pc<balanced_shape>
                       ,wt_blcd<bit_vector_il<>>
                       ,wt_blcd<bit_vector>
                       ,wt_huff<bit_vector_il<>>
+                      ,wt_huff<bit_vector_cl>
                       ,wt_huff<bit_vector, rank_support_v<>>
                       ,wt_huff<bit_vector, rank_support_v5<>>
                       ,wt_huff<rrr_vector<63>>
@@ -549,6 +551,26 @@ TYPED_TEST(wt_byte_test, create_partially_test)
     compare_wt(text, wt);
 }
 
+//! Test that the multi-threaded construction yields the same wavelet tree
+TYPED_TEST(wt_byte_test, create_parallel)
+{
+    TypeParam wt;
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+    for (uint64_t threads : {2, 5}) {
+        int_vector_buffer<8> text_buf(test_file, std::ios::in, 1024*1024, 8, true);
+        TypeParam wt_par;
+        construct_wt(wt_par, text_buf, text_buf.size(), threads);
+        ASSERT_EQ(wt.size(), wt_par.size());
+        if (wt.size() == 0) {
+            continue;
+        }
+        stringstream ss, ss_par;
+        wt.serialize(ss);
+        wt_par.serialize(ss_par);
+        ASSERT_EQ(ss.str(), ss_par.str()) << "threads=" << threads;
+    }
+}
+
 TYPED_TEST(wt_byte_test, delete_)
 {
     sdsl::remove(temp_file);
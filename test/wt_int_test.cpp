@@ -5,6 +5,7 @@
 #include <map>
 #include <queue>
 #include <algorithm>
+#include <sstream>
 
 namespace
 {
@@ -33,6 +34,9 @@ wt_blcd<bit_vector, rank_support_v<>, select_support_mcl<1>, select_support_mcl<
         ,wt_gmr<>
         ,wt_ap<>
         ,wm_int<>
+        ,wm_kary<2>
+        ,wm_kary<3>
+        ,wm_kary<4>
         ,wt_int<>
         ,wt_int<rrr_vector<15>>
         ,wt_int<rrr_vector<63>>
@@ -78,6 +82,26 @@ TYPED_TEST(wt_int_test, constructor)
     }
 }
 
+//! Test that the multi-threaded construction yields the same wavelet tree
+TYPED_TEST(wt_int_test, constructor_parallel)
+{
+    TypeParam wt;
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+    for (uint64_t threads : {2, 5}) {
+        int_vector_buffer<> iv_buf(test_file);
+        TypeParam wt_par;
+        construct_wt(wt_par, iv_buf, iv_buf.size(), threads);
+        ASSERT_EQ(wt.size(), wt_par.size());
+        if (wt.size() == 0) {
+            continue;
+        }
+        stringstream ss, ss_par;
+        wt.serialize(ss);
+        wt_par.serialize(ss_par);
+        ASSERT_EQ(ss.str(), ss_par.str()) << "threads=" << threads;
+    }
+}
+
 //! Test loading and accessing the wavelet tree
 TYPED_TEST(wt_int_test, load_and_access)
 {
@@ -372,6 +396,8 @@ test_range_search_2d(typename enable_if<has_range_search_2d<t_wt>::value,
     uniform_int_distribution<uint64_t> rank_distr(0, buf.size());
     auto dice_rank = bind(rank_distr, rng);
 
+    range_2d_rect_vec_type rects;
+    vector<typename t_wt::r2d_res_type> results;
     for (size_type n=0; n<1000; ++n) {
         size_type lb = dice_range();
         size_type rb = lb+buf.size()-1;
@@ -404,6 +430,18 @@ test_range_search_2d(typename enable_if<has_range_search_2d<t_wt>::value,
             // check that in the original data
             ASSERT_EQ(iv[point.first], point.second);
         }
+        rects.push_back({lb, rb, vlb, vrb});
+        results.push_back(res);
+    }
+    // the batched versions must agree with the single queries
+    auto batch_res = wt.range_search_2d_batch(rects);
+    auto batch_cnt = wt.range_count_2d_batch(rects);
+    ASSERT_EQ(rects.size(), batch_res.size());
+    ASSERT_EQ(rects.size(), batch_cnt.size());
+    for (size_type q=0; q<rects.size(); ++q) {
+        ASSERT_EQ(results[q].first, batch_res[q].first);
+        ASSERT_EQ(results[q].second, batch_res[q].second);
+        ASSERT_EQ(results[q].first, batch_cnt[q]);
     }
 }
 
@@ -466,6 +504,123 @@ TYPED_TEST(wt_int_test, quantile_freq)
     test_quantile_freq<TypeParam>(wt);
 }
 
+template<class t_wt>
+void
+test_quantile_freq_batch(typename enable_if<!(has_node_type<t_wt>::value and has_ordered_leaves<t_wt>::value),
+                         t_wt>::type&) {}
+
+template<class t_wt>
+void
+test_quantile_freq_batch(typename enable_if<has_node_type<t_wt>::value and has_ordered_leaves<t_wt>::value,
+                         t_wt>::type& wt)
+{
+    int_vector<> iv;
+    load_from_file(iv, test_file);
+
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+
+    if (wt.size() == 0)
+        return;
+
+    vector<uint64_t> buf(100);
+
+    mt19937_64 rng;
+    uniform_int_distribution<uint64_t> range_distr(0, wt.size()-1);
+    auto dice_lb = bind(range_distr, rng);
+
+    uniform_int_distribution<uint64_t> rank_distr(1, buf.size());
+    auto dice_range = bind(rank_distr, rng);
+
+    for (size_type n=0; n<1000; ++n) {
+        size_type lb = dice_lb();
+        size_type rb = lb+dice_range()-1;
+        rb = (rb >= wt.size()) ? wt.size()-1 : rb;
+
+        auto buf_end = copy(iv.begin()+lb, iv.begin()+rb+1, buf.begin());
+        sort(buf.begin(), buf_end);
+
+        // random quantiles, with duplicates and in arbitrary order
+        vector<size_type> qs(dice_range());
+        for (auto& q : qs) {
+            q = dice_range() % (buf_end - buf.begin());
+        }
+        auto res = quantile_freq_batch(wt, lb, rb, qs);
+        ASSERT_EQ(qs.size(), res.size());
+        for (size_type i=0; i<qs.size(); ++i) {
+            auto val = buf[qs[i]];
+            size_type freq = upper_bound(buf.begin(), buf_end, val) -
+                             lower_bound(buf.begin(), buf_end, val);
+            ASSERT_EQ(val, res[i].first);
+            ASSERT_EQ(freq, res[i].second);
+        }
+    }
+}
+
+//! Test the load method and quantile_freq_batch
+TYPED_TEST(wt_int_test, quantile_freq_batch)
+{
+    TypeParam wt;
+    test_quantile_freq_batch<TypeParam>(wt);
+}
+
+template<class t_wt>
+void
+test_topk_freq(typename enable_if<!(has_node_type<t_wt>::value), t_wt>::type&) {}
+
+template<class t_wt>
+void
+test_topk_freq(typename enable_if<has_node_type<t_wt>::value, t_wt>::type& wt)
+{
+    int_vector<> iv;
+    load_from_file(iv, test_file);
+
+    ASSERT_TRUE(load_from_file(wt, temp_file));
+
+    if (wt.size() == 0)
+        return;
+
+    mt19937_64 rng;
+    uniform_int_distribution<uint64_t> range_distr(0, wt.size()-1);
+    auto dice_lb = bind(range_distr, rng);
+
+    uniform_int_distribution<uint64_t> len_distr(1, 1000);
+    auto dice_len = bind(len_distr, rng);
+
+    for (size_type n=0; n<100; ++n) {
+        size_type lb = dice_lb();
+        size_type rb = lb+dice_len()-1;
+        rb = (rb >= wt.size()) ? wt.size()-1 : rb;
+        size_type k = dice_len() % 20 + 1;
+
+        tMII freq;
+        for (size_type i=lb; i<=rb; ++i) {
+            ++freq[iv[i]];
+        }
+        auto res = topk_freq(wt, lb, rb, k);
+        ASSERT_EQ(min(k, (size_type)freq.size()), res.size());
+        for (size_type i=0; i<res.size(); ++i) {
+            ASSERT_EQ(freq[res[i].first], res[i].second);
+            if (i > 0) {
+                ASSERT_TRUE(res[i-1].second >= res[i].second);
+            }
+        }
+        // no element outside the result is more frequent than the last one
+        for (const auto& x : res) {
+            freq.erase(x.first);
+        }
+        for (const auto& x : freq) {
+            ASSERT_TRUE(x.second <= res.back().second);
+        }
+    }
+}
+
+//! Test the load method and topk_freq
+TYPED_TEST(wt_int_test, topk_freq)
+{
+    TypeParam wt;
+    test_topk_freq<TypeParam>(wt);
+}
+
 
 template<class t_wt>
 void